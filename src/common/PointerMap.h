@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_POINTER_MAP_H
+#define LOVE_POINTER_MAP_H
+
+// C++
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace love
+{
+
+/**
+ * A hash map from non-null pointers to values, stored in a single flat array
+ * with linear probing. Lookups don't chase list nodes, and inserting or
+ * removing doesn't allocate unless the table grows.
+ **/
+template <typename T>
+class PointerMap
+{
+public:
+
+	PointerMap()
+		: count(0)
+	{
+	}
+
+	/**
+	 * Adds a value, replacing any value already stored for the key.
+	 **/
+	void set(const void *key, const T &value)
+	{
+		if ((count + 1) * 4 > entries.size() * 3)
+			grow();
+
+		size_t i = findSlot(key);
+		if (entries[i].key == nullptr)
+		{
+			entries[i].key = key;
+			count++;
+		}
+
+		entries[i].value = value;
+	}
+
+	/**
+	 * Gets the value stored for a key, or defaultValue if there isn't one.
+	 **/
+	T get(const void *key, const T &defaultValue) const
+	{
+		if (count == 0)
+			return defaultValue;
+
+		const Entry &e = entries[findSlot(key)];
+		return e.key != nullptr ? e.value : defaultValue;
+	}
+
+	/**
+	 * Removes the value stored for a key.
+	 * @return Whether there was a value.
+	 **/
+	bool remove(const void *key)
+	{
+		if (count == 0)
+			return false;
+
+		size_t i = findSlot(key);
+		if (entries[i].key == nullptr)
+			return false;
+
+		// Move later entries of the same probe sequence back, so lookups
+		// never need tombstones.
+		size_t mask = entries.size() - 1;
+		size_t j = i;
+		while (true)
+		{
+			j = (j + 1) & mask;
+			if (entries[j].key == nullptr)
+				break;
+
+			size_t home = hash(entries[j].key) & mask;
+			if (((j - home) & mask) >= ((j - i) & mask))
+			{
+				entries[i] = entries[j];
+				i = j;
+			}
+		}
+
+		entries[i].key = nullptr;
+		entries[i].value = T();
+		count--;
+		return true;
+	}
+
+	size_t size() const
+	{
+		return count;
+	}
+
+	void clear()
+	{
+		entries.clear();
+		count = 0;
+	}
+
+	/**
+	 * Calls func(key, value) for every value in the map. The map must not be
+	 * modified by func.
+	 **/
+	template <typename F>
+	void forEach(const F &func) const
+	{
+		for (const Entry &e : entries)
+		{
+			if (e.key != nullptr)
+				func(e.key, e.value);
+		}
+	}
+
+private:
+
+	struct Entry
+	{
+		const void *key;
+		T value;
+	};
+
+	static size_t hash(const void *key)
+	{
+		// Fibonacci hashing. The low bits of pointers are mostly alignment.
+		uint64_t h = (uint64_t) (uintptr_t) key * 0x9E3779B97F4A7C15ULL;
+		return (size_t) (h >> 32);
+	}
+
+	size_t findSlot(const void *key) const
+	{
+		size_t mask = entries.size() - 1;
+		size_t i = hash(key) & mask;
+
+		while (entries[i].key != nullptr && entries[i].key != key)
+			i = (i + 1) & mask;
+
+		return i;
+	}
+
+	void grow()
+	{
+		std::vector<Entry> old;
+		old.swap(entries);
+
+		entries.resize(old.empty() ? 16 : old.size() * 2, Entry{nullptr, T()});
+		count = 0;
+
+		for (const Entry &e : old)
+		{
+			if (e.key != nullptr)
+				set(e.key, e.value);
+		}
+	}
+
+	std::vector<Entry> entries;
+	size_t count;
+
+}; // PointerMap
+
+} // love
+
+#endif // LOVE_POINTER_MAP_H
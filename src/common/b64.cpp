@@ -22,7 +22,13 @@
 #include "Exception.h"
 
 #include <limits>
-#include <stdio.h>
+#include <string.h>
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace love
 {
@@ -30,18 +36,238 @@ namespace love
 // Translation table as described in RFC1113
 static const char cb64[]="ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-// Translation table to decode (created by Bob Trower)
-static const char cd64[]="|$$$}rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
+// Value of each base64 character, or INVALID for characters which are skipped
+// when decoding (whitespace, padding, and anything else outside the alphabet).
+static const uint8 INVALID = 0xFF;
+
+struct DecodeTable
+{
+	uint8 values[256];
+
+	DecodeTable()
+	{
+		memset(values, INVALID, sizeof(values));
+		for (int i = 0; i < 64; i++)
+			values[(uint8) cb64[i]] = (uint8) i;
+	}
+};
+
+static const DecodeTable cd64;
 
 /**
  * encode 3 8-bit binary bytes as 4 '6-bit' characters
  **/
-static void b64_encode_block(char in[3], char out[4], int len)
+static inline void b64_encode_block(const uint8 *in, char *out, int len)
+{
+	uint8 in1 = len > 1 ? in[1] : 0;
+	uint8 in2 = len > 2 ? in[2] : 0;
+
+	out[0] = cb64[in[0] >> 2];
+	out[1] = cb64[((in[0] & 0x03) << 4) | (in1 >> 4)];
+	out[2] = len > 1 ? cb64[((in1 & 0x0f) << 2) | (in2 >> 6)] : '=';
+	out[3] = len > 2 ? cb64[in2 & 0x3f] : '=';
+}
+
+#if defined(LOVE_SIMD_SSE2)
+
+// Maps 6-bit values to base64 characters. 0-25 become 'A'-'Z', 26-51 become
+// 'a'-'z', 52-61 become '0'-'9', 62 becomes '+' and 63 becomes '/'.
+static inline __m128i b64_encode_chars(__m128i v)
+{
+	__m128i offset = _mm_set1_epi8(65);
+	offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(25)), _mm_set1_epi8(6)));
+	offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(51)), _mm_set1_epi8(-75)));
+	offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(62)), _mm_set1_epi8(-15)));
+	offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(63)), _mm_set1_epi8(-12)));
+	return _mm_add_epi8(v, offset);
+}
+
+// Encodes 12 bytes as 16 characters. Reads 16 bytes from src.
+static inline void b64_encode_simd(const uint8 *src, char *dst)
+{
+	__m128i in = _mm_loadu_si128((const __m128i *) src);
+
+	// Put each group of 3 bytes in its own 32-bit lane.
+	__m128i lo = _mm_unpacklo_epi32(in, _mm_srli_si128(in, 3));
+	__m128i hi = _mm_unpacklo_epi32(_mm_srli_si128(in, 6), _mm_srli_si128(in, 9));
+	__m128i x = _mm_unpacklo_epi64(lo, hi);
+
+	// Split each group into four 6-bit values, one per byte of the lane.
+	__m128i v = _mm_and_si128(_mm_srli_epi32(x, 2), _mm_set1_epi32(0x0000003F));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_slli_epi32(x, 12), _mm_set1_epi32(0x00003000)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_srli_epi32(x, 4), _mm_set1_epi32(0x00000F00)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_slli_epi32(x, 10), _mm_set1_epi32(0x003C0000)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_srli_epi32(x, 6), _mm_set1_epi32(0x00030000)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_slli_epi32(x, 8), _mm_set1_epi32(0x3F000000)));
+
+	_mm_storeu_si128((__m128i *) dst, b64_encode_chars(v));
+}
+
+static const size_t SIMD_ENCODE_READ = 16;
+static const size_t SIMD_ENCODE_IN = 12;
+static const size_t SIMD_ENCODE_OUT = 16;
+
+// Returns a mask of the bytes in v which are in the range [lo, hi]. Bytes of
+// 128 and above are negative as signed values, so are never in range.
+static inline __m128i b64_in_range(__m128i v, char lo, char hi)
+{
+	return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+}
+
+// Decodes 16 characters into 12 bytes. Returns false without writing anything
+// if any of the characters are outside the base64 alphabet.
+static inline bool b64_decode_simd(const uint8 *src, uint8 *dst)
 {
-	out[0] = (char) cb64[(int)((in[0] & 0xfc) >> 2)];
-	out[1] = (char) cb64[(int)(((in[0] & 0x03) << 4) | ((in[1] & 0xf0) >> 4))];
-	out[2] = (char) (len > 1 ? cb64[(int)(((in[1] & 0x0f) << 2) | ((in[2] & 0xc0) >> 6))] : '=');
-	out[3] = (char) (len > 2 ? cb64[(int)(in[2] & 0x3f)] : '=');
+	__m128i in = _mm_loadu_si128((const __m128i *) src);
+
+	__m128i upper = b64_in_range(in, 'A', 'Z');
+	__m128i lower = b64_in_range(in, 'a', 'z');
+	__m128i digit = b64_in_range(in, '0', '9');
+	__m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+	__m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+
+	__m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+	if (_mm_movemask_epi8(valid) != 0xFFFF)
+		return false;
+
+	__m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-65));
+	offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+	offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(4)));
+	offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(19)));
+	offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(16)));
+	__m128i x = _mm_add_epi8(in, offset);
+
+	// Join the four 6-bit values in each 32-bit lane into 3 bytes.
+	__m128i v = _mm_and_si128(_mm_slli_epi32(x, 2), _mm_set1_epi32(0x000000FC));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_srli_epi32(x, 12), _mm_set1_epi32(0x00000003)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_slli_epi32(x, 4), _mm_set1_epi32(0x0000F000)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_srli_epi32(x, 10), _mm_set1_epi32(0x00000F00)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_slli_epi32(x, 6), _mm_set1_epi32(0x00C00000)));
+	v = _mm_or_si128(v, _mm_and_si128(_mm_srli_epi32(x, 8), _mm_set1_epi32(0x003F0000)));
+
+	// Pack the 3-byte groups together: first within each 64-bit half, then
+	// across the halves.
+	__m128i t = _mm_or_si128(_mm_and_si128(v, _mm_set_epi32(0, -1, 0, -1)),
+	                         _mm_srli_epi64(_mm_and_si128(v, _mm_set_epi32(-1, 0, -1, 0)), 8));
+
+	__m128i lomask = _mm_set_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1);
+	__m128i himask = _mm_set_epi8(0, 0, 0, 0, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0);
+	__m128i out = _mm_or_si128(_mm_and_si128(t, lomask), _mm_and_si128(_mm_srli_si128(t, 2), himask));
+
+	_mm_storel_epi64((__m128i *) dst, out);
+	uint32 last = (uint32) _mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+	memcpy(dst + 8, &last, sizeof(uint32));
+
+	return true;
+}
+
+static const size_t SIMD_DECODE_IN = 16;
+static const size_t SIMD_DECODE_OUT = 12;
+
+#elif defined(LOVE_SIMD_NEON)
+
+static inline uint8x16_t b64_encode_chars(uint8x16_t v)
+{
+	uint8x16_t offset = vdupq_n_u8(65);
+	offset = vaddq_u8(offset, vandq_u8(vcgtq_u8(v, vdupq_n_u8(25)), vdupq_n_u8(6)));
+	offset = vaddq_u8(offset, vandq_u8(vcgtq_u8(v, vdupq_n_u8(51)), vdupq_n_u8((uint8) -75)));
+	offset = vaddq_u8(offset, vandq_u8(vceqq_u8(v, vdupq_n_u8(62)), vdupq_n_u8((uint8) -15)));
+	offset = vaddq_u8(offset, vandq_u8(vceqq_u8(v, vdupq_n_u8(63)), vdupq_n_u8((uint8) -12)));
+	return vaddq_u8(v, offset);
+}
+
+// Encodes 48 bytes as 64 characters.
+static inline void b64_encode_simd(const uint8 *src, char *dst)
+{
+	uint8x16x3_t in = vld3q_u8(src);
+	uint8x16x4_t out;
+
+	out.val[0] = vshrq_n_u8(in.val[0], 2);
+	out.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4), vshrq_n_u8(in.val[1], 4));
+	out.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0F)), 2), vshrq_n_u8(in.val[2], 6));
+	out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3F));
+
+	for (int i = 0; i < 4; i++)
+		out.val[i] = b64_encode_chars(out.val[i]);
+
+	vst4q_u8((uint8 *) dst, out);
+}
+
+static const size_t SIMD_ENCODE_READ = 48;
+static const size_t SIMD_ENCODE_IN = 48;
+static const size_t SIMD_ENCODE_OUT = 64;
+
+static inline uint8x16_t b64_in_range(uint8x16_t v, uint8 lo, uint8 hi)
+{
+	return vandq_u8(vcgeq_u8(v, vdupq_n_u8(lo)), vcleq_u8(v, vdupq_n_u8(hi)));
+}
+
+// Converts characters to their 6-bit values, and clears bytes in valid for
+// characters outside the base64 alphabet.
+static inline uint8x16_t b64_decode_chars(uint8x16_t v, uint8x16_t &valid)
+{
+	uint8x16_t upper = b64_in_range(v, 'A', 'Z');
+	uint8x16_t lower = b64_in_range(v, 'a', 'z');
+	uint8x16_t digit = b64_in_range(v, '0', '9');
+	uint8x16_t plus = vceqq_u8(v, vdupq_n_u8('+'));
+	uint8x16_t slash = vceqq_u8(v, vdupq_n_u8('/'));
+
+	valid = vandq_u8(valid, vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(plus, slash))));
+
+	uint8x16_t offset = vandq_u8(upper, vdupq_n_u8((uint8) -65));
+	offset = vorrq_u8(offset, vandq_u8(lower, vdupq_n_u8((uint8) -71)));
+	offset = vorrq_u8(offset, vandq_u8(digit, vdupq_n_u8(4)));
+	offset = vorrq_u8(offset, vandq_u8(plus, vdupq_n_u8(19)));
+	offset = vorrq_u8(offset, vandq_u8(slash, vdupq_n_u8(16)));
+	return vaddq_u8(v, offset);
+}
+
+// Decodes 64 characters into 48 bytes. Returns false without writing anything
+// if any of the characters are outside the base64 alphabet.
+static inline bool b64_decode_simd(const uint8 *src, uint8 *dst)
+{
+	uint8x16x4_t in = vld4q_u8(src);
+	uint8x16_t valid = vdupq_n_u8(0xFF);
+
+	for (int i = 0; i < 4; i++)
+		in.val[i] = b64_decode_chars(in.val[i], valid);
+
+	uint64x2_t valid64 = vreinterpretq_u64_u8(valid);
+	if ((vgetq_lane_u64(valid64, 0) & vgetq_lane_u64(valid64, 1)) != ~(uint64) 0)
+		return false;
+
+	uint8x16x3_t out;
+	out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+	out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+	out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+
+	vst3q_u8(dst, out);
+	return true;
+}
+
+static const size_t SIMD_DECODE_IN = 64;
+static const size_t SIMD_DECODE_OUT = 48;
+
+#endif
+
+/**
+ * Encodes the data without line breaks, padding the end with '='. Writes
+ * ((srclen + 2) / 3) * 4 characters.
+ **/
+static void b64_encode_unbroken(const uint8 *src, size_t srclen, char *dst)
+{
+	size_t srcpos = 0;
+
+#if defined(LOVE_SIMD_SSE2) || defined(LOVE_SIMD_NEON)
+	for (; srcpos + SIMD_ENCODE_READ <= srclen; srcpos += SIMD_ENCODE_IN, dst += SIMD_ENCODE_OUT)
+		b64_encode_simd(src + srcpos, dst);
+#endif
+
+	for (; srcpos < srclen; srcpos += 3, dst += 4)
+	{
+		size_t len = srclen - srcpos;
+		b64_encode_block(src + srcpos, dst, len > 3 ? 3 : (int) len);
+	}
 }
 
 char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
@@ -49,13 +275,10 @@ char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
 	if (linelen == 0)
 		linelen = std::numeric_limits<size_t>::max();
 
-	size_t blocksout = 0;
-	size_t srcpos = 0;
-
-	size_t adjustment = (srclen % 3) ? (3 - (srclen % 3)) : 0;
-	size_t paddedlen = ((srclen + adjustment) / 3) * 4;
+	size_t paddedlen = ((srclen + 2) / 3) * 4;
+	size_t lines = paddedlen / linelen;
 
-	dstlen = paddedlen + paddedlen / linelen;
+	dstlen = paddedlen + lines;
 
 	if (dstlen == 0)
 		return nullptr;
@@ -70,57 +293,100 @@ char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
 		throw love::Exception("Out of memory.");
 	}
 
-	size_t dstpos = 0;
+	b64_encode_unbroken((const uint8 *) src, srclen, dst);
 
-	while (srcpos < srclen)
+	// Spread the lines out from the back, ending each full line with '\n'.
+	if (lines > 0)
 	{
-		char in[3]  = {0};
-		char out[4] = {0};
+		memmove(dst + lines * (linelen + 1), dst + lines * linelen, paddedlen - lines * linelen);
 
-		int len = 0;
+		for (size_t i = lines; i > 0; i--)
+		{
+			char *line = dst + (i - 1) * (linelen + 1);
+			memmove(line, dst + (i - 1) * linelen, linelen);
+			line[linelen] = '\n';
+		}
+	}
 
-		for (int i = 0; i < 3; i++)
+	dst[dstlen] = '\0';
+	return dst;
+}
+
+size_t b64_decode_size(const char *src, size_t srclen)
+{
+	const uint8 *s = (const uint8 *) src;
+
+	size_t count = 0;
+	for (size_t i = 0; i < srclen; i++)
+	{
+		if (cd64.values[s[i]] != INVALID)
+			count++;
+	}
+
+	size_t remainder = count % 4;
+	return (count / 4) * 3 + (remainder > 1 ? remainder - 1 : 0);
+}
+
+size_t b64_decode(const char *src, size_t srclen, char *dst)
+{
+	const uint8 *s = (const uint8 *) src;
+	uint8 *d = (uint8 *) dst;
+
+	uint32 group = 0;
+	int count = 0;
+	size_t srcpos = 0;
+
+	while (srcpos < srclen)
+	{
+#if defined(LOVE_SIMD_SSE2) || defined(LOVE_SIMD_NEON)
+		// Runs of characters without whitespace or padding are decoded in
+		// whole blocks.
+		if (count == 0)
 		{
+			while (srcpos + SIMD_DECODE_IN <= srclen && b64_decode_simd(s + srcpos, d))
+			{
+				srcpos += SIMD_DECODE_IN;
+				d += SIMD_DECODE_OUT;
+			}
+
 			if (srcpos >= srclen)
 				break;
-
-			in[i] = src[srcpos++];
-			len++;
 		}
+#endif
 
-		if (len > 0)
-		{
-			b64_encode_block(in, out, len);
+		uint8 v = cd64.values[s[srcpos++]];
+		if (v == INVALID)
+			continue;
 
-			for (int i = 0; i < 4 && dstpos < dstlen; i++, dstpos++)
-				dst[dstpos] = out[i];
+		group = (group << 6) | v;
 
-			blocksout++;
-		}
-
-		if (blocksout >= linelen / 4 || srcpos >= srclen)
+		if (++count == 4)
 		{
-			if (blocksout > 0 && dstpos < dstlen)
-				dst[dstpos++] = '\n';
+			d[0] = (uint8) (group >> 16);
+			d[1] = (uint8) (group >> 8);
+			d[2] = (uint8) group;
+			d += 3;
 
-			blocksout = 0;
+			group = 0;
+			count = 0;
 		}
 	}
 
-	dst[dstpos] = '\0';
-	return dst;
-}
+	// A trailing group of 2 or 3 characters holds 1 or 2 bytes.
+	if (count == 2)
+		*(d++) = (uint8) (group >> 4);
+	else if (count == 3)
+	{
+		*(d++) = (uint8) (group >> 10);
+		*(d++) = (uint8) (group >> 2);
+	}
 
-static void b64_decode_block(char in[4], char out[3])
-{
-	out[0] = (char)(in[0] << 2 | in[1] >> 4);
-	out[1] = (char)(in[1] << 4 | in[2] >> 2);
-	out[2] = (char)(((in[2] << 6) & 0xc0) | in[3]);
+	return (size_t) (d - (uint8 *) dst);
 }
 
 char *b64_decode(const char *src, size_t srclen, size_t &size)
 {
-	size_t paddedsize = (srclen / 4) * 3;
+	size_t paddedsize = (srclen / 4) * 3 + 2;
 
 	char *dst = nullptr;
 	try
@@ -132,45 +398,7 @@ char *b64_decode(const char *src, size_t srclen, size_t &size)
 		throw love::Exception("Out of memory.");
 	}
 
-	char *d = dst;
-
-	char in[4]  = {0};
-	char out[3] = {0};
-	size_t i, len, srcpos = 0;
-
-	while (srcpos <= srclen)
-	{
-		for (len = 0, i = 0; i < 4 && srcpos <= srclen; i++)
-		{
-			char v = 0;
-
-			while (srcpos <= srclen && v == 0)
-			{
-				v = src[srcpos++];
-				v = (char)((v < 43 || v > 122) ? 0 : cd64[v - 43]);
-				if (v != 0)
-					v = (char)((v == '$') ? 0 : v - 61);
-			}
-
-			if (srcpos <= srclen)
-			{
-				len++;
-				if (v != 0)
-					in[i] = (char)(v - 1);
-			}
-			else
-				in[i] = 0;
-		}
-
-		if (len)
-		{
-			b64_decode_block(in, out);
-			for (i = 0; i < len - 1; i++)
-				 *(d++) = out[i];
-		}
-	}
-
-	size = (size_t)(ptrdiff_t) (d - dst);
+	size = b64_decode(src, srclen, dst);
 	return dst;
 }
 
@@ -19,6 +19,7 @@
  **/
 
 #include "config.h"
+#include "int.h"
 
 #include <stddef.h>
 
@@ -50,6 +51,30 @@ char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
  */
 char *b64_decode(const char *src, size_t srclen, size_t &dstlen);
 
+/**
+ * Decode base64 encoded data into an existing buffer. Characters outside the
+ * base64 alphabet, such as line breaks and padding, are skipped.
+ *
+ * The destination may overlap the source as long as it doesn't start after
+ * it, which allows decoding in-place.
+ *
+ * @param src The string containing the base64 data.
+ * @param srclen The length of the string.
+ * @param dst The buffer to write the binary data to. Must have room for at
+ *        least b64_decode_size(src, srclen) bytes.
+ * @return The size of the binary data.
+ */
+size_t b64_decode(const char *src, size_t srclen, char *dst);
+
+/**
+ * Gets the exact size of the binary data in a base64 encoded string.
+ *
+ * @param src The string containing the base64 data.
+ * @param srclen The length of the string.
+ * @return The size in bytes of the decoded data.
+ */
+size_t b64_decode_size(const char *src, size_t srclen);
+
 } // love
 
 #endif // LOVE_B64_H
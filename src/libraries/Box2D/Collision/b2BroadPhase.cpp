@@ -82,6 +82,15 @@ void b2BroadPhase::BufferMove(int32 proxyId)
 	++m_moveCount;
 }
 
+void b2BroadPhase::SetMoveBuffer(const int32* proxyIds, int32 count)
+{
+	m_moveCount = 0;
+	for (int32 i = 0; i < count; ++i)
+	{
+		BufferMove(proxyIds[i]);
+	}
+}
+
 void b2BroadPhase::UnBufferMove(int32 proxyId)
 {
 	for (int32 i = 0; i < m_moveCount; ++i)
@@ -71,6 +71,20 @@ public:
 	/// Get the number of proxies.
 	int32 GetProxyCount() const;
 
+	/// Get the number of proxies that will look for new pairs in the next UpdatePairs.
+	int32 GetMoveCount() const;
+
+	/// Get the proxies that will look for new pairs in the next UpdatePairs.
+	/// Entries may be e_nullProxy. There are GetMoveCount() entries.
+	const int32* GetMoveBuffer() const;
+
+	/// Replace the proxies that will look for new pairs in the next UpdatePairs,
+	/// e.g. with ones saved from GetMoveBuffer.
+	void SetMoveBuffer(const int32* proxyIds, int32 count);
+
+	/// Replace the fat AABB of a proxy. See b2DynamicTree::SetFatAABB.
+	void SetFatAABB(int32 proxyId, const b2AABB& fatAABB);
+
 	/// Update the pairs. This results in pair callbacks. This can only add pairs.
 	template <typename T>
 	void UpdatePairs(T* callback);
@@ -166,6 +180,21 @@ inline int32 b2BroadPhase::GetProxyCount() const
 	return m_proxyCount;
 }
 
+inline int32 b2BroadPhase::GetMoveCount() const
+{
+	return m_moveCount;
+}
+
+inline const int32* b2BroadPhase::GetMoveBuffer() const
+{
+	return m_moveBuffer;
+}
+
+inline void b2BroadPhase::SetFatAABB(int32 proxyId, const b2AABB& fatAABB)
+{
+	m_tree.SetFatAABB(proxyId, fatAABB);
+}
+
 inline int32 b2BroadPhase::GetTreeHeight() const
 {
 	return m_tree.GetHeight();
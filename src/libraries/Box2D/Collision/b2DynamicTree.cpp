@@ -41,6 +41,8 @@ b2DynamicTree::b2DynamicTree()
 	m_path = 0;
 
 	m_insertionCount = 0;
+
+	m_aabbExtension = b2_aabbExtension;
 }
 
 b2DynamicTree::~b2DynamicTree()
@@ -107,7 +109,7 @@ int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
 	int32 proxyId = AllocateNode();
 
 	// Fatten the aabb.
-	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+	b2Vec2 r(m_aabbExtension, m_aabbExtension);
 	m_nodes[proxyId].aabb.lowerBound = aabb.lowerBound - r;
 	m_nodes[proxyId].aabb.upperBound = aabb.upperBound + r;
 	m_nodes[proxyId].userData = userData;
@@ -142,7 +144,7 @@ bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& d
 
 	// Extend AABB.
 	b2AABB b = aabb;
-	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+	b2Vec2 r(m_aabbExtension, m_aabbExtension);
 	b.lowerBound = b.lowerBound - r;
 	b.upperBound = b.upperBound + r;
 
@@ -173,6 +175,23 @@ bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& d
 	return true;
 }
 
+void b2DynamicTree::SetFatAABB(int32 proxyId, const b2AABB& fatAABB)
+{
+	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
+
+	b2Assert(m_nodes[proxyId].IsLeaf());
+
+	const b2AABB& current = m_nodes[proxyId].aabb;
+	if (current.lowerBound == fatAABB.lowerBound && current.upperBound == fatAABB.upperBound)
+	{
+		return;
+	}
+
+	RemoveLeaf(proxyId);
+	m_nodes[proxyId].aabb = fatAABB;
+	InsertLeaf(proxyId);
+}
+
 void b2DynamicTree::InsertLeaf(int32 leaf)
 {
 	++m_insertionCount;
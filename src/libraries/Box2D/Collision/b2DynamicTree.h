@@ -79,6 +79,15 @@ public:
 	/// @return true if the proxy was re-inserted.
 	bool MoveProxy(int32 proxyId, const b2AABB& aabb1, const b2Vec2& displacement);
 
+	/// Set how far fat AABBs extend past the AABBs given to CreateProxy and
+	/// MoveProxy. Defaults to b2_aabbExtension. Only affects later calls.
+	void SetAABBExtension(float32 extension) { m_aabbExtension = extension; }
+	float32 GetAABBExtension() const { return m_aabbExtension; }
+
+	/// Replace the fat AABB of a proxy, e.g. one saved with GetFatAABB.
+	/// The proxy is re-inserted unless the AABB is unchanged.
+	void SetFatAABB(int32 proxyId, const b2AABB& fatAABB);
+
 	/// Get proxy user data.
 	/// @return the proxy user data or 0 if the id is invalid.
 	void* GetUserData(int32 proxyId) const;
@@ -151,6 +160,8 @@ private:
 	uint32 m_path;
 
 	int32 m_insertionCount;
+
+	float32 m_aabbExtension;
 };
 
 inline void* b2DynamicTree::GetUserData(int32 proxyId) const
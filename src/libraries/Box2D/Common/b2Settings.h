@@ -128,6 +128,18 @@ typedef double float64;
 /// A body cannot sleep if its angular velocity is above this tolerance.
 #define b2_angularSleepTolerance	(2.0f / 180.0f * b2_pi)
 
+// Threading
+
+/// The number of contacts updated by each work item of the parallel narrow-phase.
+/// See b2TaskExecutor.
+#define b2_collideItemsPerTask		64
+
+// Snapshots
+
+/// The maximum number of values a joint writes to a world snapshot.
+/// See b2World::SaveState.
+#define b2_maxJointStateValues		8
+
 // Memory Allocation
 
 /// Implement this function to use your own memory allocator.
@@ -148,8 +148,10 @@ protected:
 	friend class b2ContactManager;
 	friend class b2World;
 	friend class b2ContactSolver;
+	friend class b2Island;
 	friend class b2Body;
 	friend class b2Fixture;
+	friend struct b2CollideTask;
 
 	// Flags stored in m_flags
 	enum
@@ -189,6 +191,11 @@ protected:
 
 	void Update(b2ContactListener* listener);
 
+	// Update split in two: the manifold can be computed for many contacts
+	// at once, the rest must happen in contact list order.
+	bool ComputeManifold(b2Manifold* manifold);
+	void FinishUpdate(b2ContactListener* listener, const b2Manifold& manifold, bool touching);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
@@ -208,6 +215,10 @@ protected:
 	int32 m_indexA;
 	int32 m_indexB;
 
+	// Island indices of the two bodies, see b2Island::InitIndices.
+	int32 m_islandIndexA;
+	int32 m_islandIndexB;
+
 	b2Manifold m_manifold;
 
 	int32 m_toiCount;
@@ -59,10 +59,25 @@ b2DistanceJoint::b2DistanceJoint(const b2DistanceJointDef* def)
 	m_bias = 0.0f;
 }
 
-void b2DistanceJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2DistanceJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2DistanceJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse;
+	return 1;
+}
+
+void b2DistanceJoint::LoadState(const float32* values)
+{
+	m_impulse = values[0];
+}
+
+void b2DistanceJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -53,10 +53,29 @@ b2FrictionJoint::b2FrictionJoint(const b2FrictionJointDef* def)
 	m_maxTorque = def->maxTorque;
 }
 
-void b2FrictionJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2FrictionJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2FrictionJoint::SaveState(float32* values) const
+{
+	values[0] = m_linearImpulse.x;
+	values[1] = m_linearImpulse.y;
+	values[2] = m_angularImpulse;
+	return 3;
+}
+
+void b2FrictionJoint::LoadState(const float32* values)
+{
+	m_linearImpulse.x = values[0];
+	m_linearImpulse.y = values[1];
+	m_angularImpulse = values[2];
+}
+
+void b2FrictionJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -88,6 +88,9 @@ protected:
 
 	b2FrictionJoint(const b2FrictionJointDef* def);
 
+	void InitIslandIndices();
+	int32 SaveState(float32* values) const;
+	void LoadState(const float32* values);
 	void InitVelocityConstraints(const b2SolverData& data);
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
@@ -128,12 +128,27 @@ b2GearJoint::b2GearJoint(const b2GearJointDef* def)
 	m_impulse = 0.0f;
 }
 
-void b2GearJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2GearJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
 	m_indexC = m_bodyC->m_islandIndex;
 	m_indexD = m_bodyD->m_islandIndex;
+}
+
+int32 b2GearJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse;
+	return 1;
+}
+
+void b2GearJoint::LoadState(const float32* values)
+{
+	m_impulse = values[0];
+}
+
+void b2GearJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_lcA = m_bodyA->m_sweep.localCenter;
 	m_lcB = m_bodyB->m_sweep.localCenter;
 	m_lcC = m_bodyC->m_sweep.localCenter;
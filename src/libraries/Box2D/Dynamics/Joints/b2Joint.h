@@ -161,6 +161,16 @@ protected:
 	b2Joint(const b2JointDef* def);
 	virtual ~b2Joint() {}
 
+	// Capture the island indices of the attached bodies. Called once the
+	// island is built, before InitVelocityConstraints.
+	virtual void InitIslandIndices() = 0;
+
+	// Write the accumulated impulses and any other state carried from one
+	// time step to the next, for world snapshots. Returns the number of
+	// values written, at most b2_maxJointStateValues.
+	virtual int32 SaveState(float32* values) const = 0;
+	virtual void LoadState(const float32* values) = 0;
+
 	virtual void InitVelocityConstraints(const b2SolverData& data) = 0;
 	virtual void SolveVelocityConstraints(const b2SolverData& data) = 0;
 
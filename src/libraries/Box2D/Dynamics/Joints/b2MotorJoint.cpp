@@ -58,10 +58,29 @@ b2MotorJoint::b2MotorJoint(const b2MotorJointDef* def)
 	m_correctionFactor = def->correctionFactor;
 }
 
-void b2MotorJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2MotorJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2MotorJoint::SaveState(float32* values) const
+{
+	values[0] = m_linearImpulse.x;
+	values[1] = m_linearImpulse.y;
+	values[2] = m_angularImpulse;
+	return 3;
+}
+
+void b2MotorJoint::LoadState(const float32* values)
+{
+	m_linearImpulse.x = values[0];
+	m_linearImpulse.y = values[1];
+	m_angularImpulse = values[2];
+}
+
+void b2MotorJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -93,9 +93,30 @@ float32 b2MouseJoint::GetDampingRatio() const
 	return m_dampingRatio;
 }
 
-void b2MouseJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2MouseJoint::InitIslandIndices()
 {
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2MouseJoint::SaveState(float32* values) const
+{
+	values[0] = m_targetA.x;
+	values[1] = m_targetA.y;
+	values[2] = m_impulse.x;
+	values[3] = m_impulse.y;
+	return 4;
+}
+
+void b2MouseJoint::LoadState(const float32* values)
+{
+	m_targetA.x = values[0];
+	m_targetA.y = values[1];
+	m_impulse.x = values[2];
+	m_impulse.y = values[3];
+}
+
+void b2MouseJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassB = m_bodyB->m_invMass;
 	m_invIB = m_bodyB->m_invI;
@@ -70,10 +70,25 @@ b2PulleyJoint::b2PulleyJoint(const b2PulleyJointDef* def)
 	m_impulse = 0.0f;
 }
 
-void b2PulleyJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2PulleyJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2PulleyJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse;
+	return 1;
+}
+
+void b2PulleyJoint::LoadState(const float32* values)
+{
+	m_impulse = values[0];
+}
+
+void b2PulleyJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -61,10 +61,33 @@ b2RevoluteJoint::b2RevoluteJoint(const b2RevoluteJointDef* def)
 	m_limitState = e_inactiveLimit;
 }
 
-void b2RevoluteJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2RevoluteJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2RevoluteJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse.x;
+	values[1] = m_impulse.y;
+	values[2] = m_impulse.z;
+	values[3] = m_motorImpulse;
+	values[4] = (float32)m_limitState;
+	return 5;
+}
+
+void b2RevoluteJoint::LoadState(const float32* values)
+{
+	m_impulse.x = values[0];
+	m_impulse.y = values[1];
+	m_impulse.z = values[2];
+	m_motorImpulse = values[3];
+	m_limitState = (b2LimitState)(int32)values[4];
+}
+
+void b2RevoluteJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -43,10 +43,25 @@ b2RopeJoint::b2RopeJoint(const b2RopeJointDef* def)
 	m_length = 0.0f;
 }
 
-void b2RopeJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2RopeJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2RopeJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse;
+	return 1;
+}
+
+void b2RopeJoint::LoadState(const float32* values)
+{
+	m_impulse = values[0];
+}
+
+void b2RopeJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
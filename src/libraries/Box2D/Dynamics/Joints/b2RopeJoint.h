@@ -84,6 +84,9 @@ protected:
 	friend class b2Joint;
 	b2RopeJoint(const b2RopeJointDef* data);
 
+	void InitIslandIndices();
+	int32 SaveState(float32* values) const;
+	void LoadState(const float32* values);
 	void InitVelocityConstraints(const b2SolverData& data);
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
@@ -55,10 +55,29 @@ b2WeldJoint::b2WeldJoint(const b2WeldJointDef* def)
 	m_impulse.SetZero();
 }
 
-void b2WeldJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2WeldJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2WeldJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse.x;
+	values[1] = m_impulse.y;
+	values[2] = m_impulse.z;
+	return 3;
+}
+
+void b2WeldJoint::LoadState(const float32* values)
+{
+	m_impulse.x = values[0];
+	m_impulse.y = values[1];
+	m_impulse.z = values[2];
+}
+
+void b2WeldJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
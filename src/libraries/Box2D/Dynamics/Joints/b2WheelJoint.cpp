@@ -74,10 +74,29 @@ b2WheelJoint::b2WheelJoint(const b2WheelJointDef* def)
 	m_ay.SetZero();
 }
 
-void b2WheelJoint::InitVelocityConstraints(const b2SolverData& data)
+void b2WheelJoint::InitIslandIndices()
 {
 	m_indexA = m_bodyA->m_islandIndex;
 	m_indexB = m_bodyB->m_islandIndex;
+}
+
+int32 b2WheelJoint::SaveState(float32* values) const
+{
+	values[0] = m_impulse;
+	values[1] = m_motorImpulse;
+	values[2] = m_springImpulse;
+	return 3;
+}
+
+void b2WheelJoint::LoadState(const float32* values)
+{
+	m_impulse = values[0];
+	m_motorImpulse = values[1];
+	m_springImpulse = values[2];
+}
+
+void b2WheelJoint::InitVelocityConstraints(const b2SolverData& data)
+{
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -118,6 +118,8 @@ void b2Body::SetType(b2BodyType type)
 		return;
 	}
 
+	m_world->m_contactManager.m_modificationCount++;
+
 	if (m_type == type)
 	{
 		return;
@@ -171,6 +173,8 @@ b2Fixture* b2Body::CreateFixture(const b2FixtureDef* def)
 		return NULL;
 	}
 
+	m_world->m_contactManager.m_modificationCount++;
+
 	b2BlockAllocator* allocator = &m_world->m_blockAllocator;
 
 	void* memory = allocator->Allocate(sizeof(b2Fixture));
@@ -219,6 +223,8 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 		return;
 	}
 
+	m_world->m_contactManager.m_modificationCount++;
+
 	b2Assert(fixture->m_body == this);
 
 	// Remove the fixture from this body's singly linked list.
@@ -422,6 +428,8 @@ void b2Body::SetTransform(const b2Vec2& position, float32 angle)
 		return;
 	}
 
+	m_world->m_contactManager.m_modificationCount++;
+
 	m_xf.q.Set(angle);
 	m_xf.p = position;
 
@@ -460,6 +468,8 @@ void b2Body::SetActive(bool flag)
 		return;
 	}
 
+	m_world->m_contactManager.m_modificationCount++;
+
 	if (flag)
 	{
 		m_flags |= e_activeFlag;
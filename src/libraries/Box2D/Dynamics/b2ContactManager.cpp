@@ -31,7 +31,13 @@ b2ContactManager::b2ContactManager()
 	m_contactCount = 0;
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
+	m_destructionListener = NULL;
 	m_allocator = NULL;
+	m_taskExecutor = NULL;
+	m_createdCount = 0;
+	m_destroyedCount = 0;
+	m_proxyMoveCount = 0;
+	m_modificationCount = 0;
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -46,6 +52,11 @@ void b2ContactManager::Destroy(b2Contact* c)
 		m_contactListener->EndContact(c);
 	}
 
+	if (m_destructionListener)
+	{
+		m_destructionListener->SayGoodbye(c);
+	}
+
 	// Remove from the world.
 	if (c->m_prev)
 	{
@@ -97,6 +108,7 @@ void b2ContactManager::Destroy(b2Contact* c)
 	// Call the factory.
 	b2Contact::Destroy(c, m_allocator);
 	--m_contactCount;
+	++m_destroyedCount;
 }
 
 // This is the top level collision call for the time step. Here
@@ -104,6 +116,12 @@ void b2ContactManager::Destroy(b2Contact* c)
 // contact list.
 void b2ContactManager::Collide()
 {
+	if (m_taskExecutor != NULL && m_taskExecutor->GetWorkerCount() > 1)
+	{
+		CollideParallel();
+		return;
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
@@ -169,8 +187,179 @@ void b2ContactManager::Collide()
 	}
 }
 
+// Computes the manifolds of a range of contacts. This only reads shared state.
+struct b2CollideTask : public b2Task
+{
+	void Execute(int32 index, int32 workerIndex)
+	{
+		B2_NOT_USED(workerIndex);
+
+		int32 begin = index * itemsPerTask;
+		int32 end = b2Min(begin + itemsPerTask, count);
+		for (int32 i = begin; i < end; ++i)
+		{
+			touching[i] = contacts[i]->ComputeManifold(manifolds + i);
+		}
+	}
+
+	b2Contact** contacts;
+	b2Manifold* manifolds;
+	bool* touching;
+	int32 count;
+	int32 itemsPerTask;
+};
+
+// Same as Collide, but the contact manifolds are computed up front by the task
+// executor. Filtering, contact destruction, waking bodies and listener
+// callbacks then happen here in contact list order, so the results match
+// those of Collide.
+void b2ContactManager::CollideParallel()
+{
+	int32 contactCount = m_contactCount;
+	if (contactCount == 0)
+	{
+		return;
+	}
+
+	// slots[i] is the manifold slot of the i-th contact in the list, or -1 if
+	// it was not precomputed.
+	int32* slots = (int32*)b2Alloc(contactCount * sizeof(int32));
+	b2Contact** contacts = (b2Contact**)b2Alloc(contactCount * sizeof(b2Contact*));
+	b2Manifold* manifolds = (b2Manifold*)b2Alloc(contactCount * sizeof(b2Manifold));
+	bool* touching = (bool*)b2Alloc(contactCount * sizeof(bool));
+
+	// Gather the contacts that will most likely be updated. Anything else
+	// that ends up being updated (e.g. a body woken up by an earlier contact)
+	// is handled serially below.
+	int32 count = 0;
+	int32 listIndex = 0;
+	for (b2Contact* c = m_contactList; c; c = c->GetNext(), ++listIndex)
+	{
+		slots[listIndex] = -1;
+
+		b2Body* bodyA = c->GetFixtureA()->GetBody();
+		b2Body* bodyB = c->GetFixtureB()->GetBody();
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+		if (activeA == false && activeB == false)
+		{
+			continue;
+		}
+
+		int32 proxyIdA = c->GetFixtureA()->m_proxies[c->GetChildIndexA()].proxyId;
+		int32 proxyIdB = c->GetFixtureB()->m_proxies[c->GetChildIndexB()].proxyId;
+		if (m_broadPhase.TestOverlap(proxyIdA, proxyIdB) == false)
+		{
+			continue;
+		}
+
+		slots[listIndex] = count;
+		contacts[count++] = c;
+	}
+
+	b2CollideTask task;
+	task.contacts = contacts;
+	task.manifolds = manifolds;
+	task.touching = touching;
+	task.count = count;
+	task.itemsPerTask = b2_collideItemsPerTask;
+	m_taskExecutor->Run(&task, (count + task.itemsPerTask - 1) / task.itemsPerTask);
+
+	int32 modificationCount = m_modificationCount;
+
+	// Contacts are only removed from the list as they are visited and no
+	// contacts are created here, so the list order matches the slots.
+	listIndex = 0;
+	b2Contact* c = m_contactList;
+	while (c)
+	{
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		int32 indexA = c->GetChildIndexA();
+		int32 indexB = c->GetChildIndexB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+		int32 slot = slots[listIndex++];
+
+		// Is this contact flagged for filtering?
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			// Should these bodies collide?
+			if (bodyB->ShouldCollide(bodyA) == false)
+			{
+				b2Contact* cNuke = c;
+				c = cNuke->GetNext();
+				Destroy(cNuke);
+				continue;
+			}
+
+			// Check user filtering.
+			if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
+			{
+				b2Contact* cNuke = c;
+				c = cNuke->GetNext();
+				Destroy(cNuke);
+				continue;
+			}
+
+			// Clear the filtering flag.
+			c->m_flags &= ~b2Contact::e_filterFlag;
+		}
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+		// At least one body must be awake and it must be dynamic or kinematic.
+		if (activeA == false && activeB == false)
+		{
+			c = c->GetNext();
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+
+		// Here we destroy contacts that cease to overlap in the broad-phase.
+		if (overlap == false)
+		{
+			b2Contact* cNuke = c;
+			c = cNuke->GetNext();
+			Destroy(cNuke);
+			continue;
+		}
+
+		// The contact persists. A listener called for an earlier contact may
+		// have changed a fixture's sensor state or filter data, or a body or
+		// fixture may have been added, removed or (de)activated. Any of these
+		// can invalidate the precomputed manifolds and touching states, so
+		// the remaining contacts are then updated serially.
+		if (slot >= 0 && m_modificationCount != modificationCount)
+		{
+			slot = -1;
+		}
+
+		if (slot >= 0)
+		{
+			c->FinishUpdate(m_contactListener, manifolds[slot], touching[slot]);
+		}
+		else
+		{
+			c->Update(m_contactListener);
+		}
+		c = c->GetNext();
+	}
+
+	b2Free(touching);
+	b2Free(manifolds);
+	b2Free(contacts);
+	b2Free(slots);
+}
+
 void b2ContactManager::FindNewContacts()
 {
+	m_proxyMoveCount += m_broadPhase.GetMoveCount();
 	m_broadPhase.UpdatePairs(this);
 }
 
@@ -242,6 +431,8 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 		return;
 	}
 
+	++m_createdCount;
+
 	// Contact creation may swap fixtures.
 	fixtureA = c->GetFixtureA();
 	fixtureB = c->GetFixtureB();
@@ -250,6 +441,21 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	bodyA = fixtureA->GetBody();
 	bodyB = fixtureB->GetBody();
 
+	Link(c);
+
+	// Wake up the bodies
+	if (fixtureA->IsSensor() == false && fixtureB->IsSensor() == false)
+	{
+		bodyA->SetAwake(true);
+		bodyB->SetAwake(true);
+	}
+}
+
+void b2ContactManager::Link(b2Contact* c)
+{
+	b2Body* bodyA = c->GetFixtureA()->GetBody();
+	b2Body* bodyB = c->GetFixtureB()->GetBody();
+
 	// Insert into the world.
 	c->m_prev = NULL;
 	c->m_next = m_contactList;
@@ -285,12 +491,5 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	}
 	bodyB->m_contactList = &c->m_nodeB;
 
-	// Wake up the bodies
-	if (fixtureA->IsSensor() == false && fixtureB->IsSensor() == false)
-	{
-		bodyA->SetAwake(true);
-		bodyB->SetAwake(true);
-	}
-
 	++m_contactCount;
 }
@@ -24,7 +24,9 @@
 class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
+class b2DestructionListener;
 class b2BlockAllocator;
+class b2TaskExecutor;
 
 // Delegate of b2World.
 class b2ContactManager
@@ -39,14 +41,29 @@ public:
 
 	void Destroy(b2Contact* c);
 
+	// Insert a new contact into the contact list and the island graph.
+	void Link(b2Contact* c);
+
 	void Collide();
+	void CollideParallel();
             
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
 	int32 m_contactCount;
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
+	b2DestructionListener* m_destructionListener;
 	b2BlockAllocator* m_allocator;
+	b2TaskExecutor* m_taskExecutor;
+
+	// Counters for b2Profile, reset after b2World::Step reads them.
+	int32 m_createdCount;
+	int32 m_destroyedCount;
+	int32 m_proxyMoveCount;
+
+	// Incremented whenever a change to a fixture or body can invalidate the
+	// manifolds computed up front by CollideParallel.
+	int32 m_modificationCount;
 };
 
 #endif
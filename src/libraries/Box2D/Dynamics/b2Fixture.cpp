@@ -187,6 +187,8 @@ void b2Fixture::Refilter()
 		return;
 	}
 
+	m_body->GetWorld()->m_contactManager.m_modificationCount++;
+
 	// Flag associated contacts for filtering.
 	b2ContactEdge* edge = m_body->GetContactList();
 	while (edge)
@@ -222,6 +224,7 @@ void b2Fixture::SetSensor(bool sensor)
 	if (sensor != m_isSensor)
 	{
 		m_body->SetAwake(true);
+		m_body->GetWorld()->m_contactManager.m_modificationCount++;
 		m_isSensor = sensor;
 	}
 }
@@ -28,6 +28,7 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
+struct b2ContactImpulse;
 struct b2Profile;
 
 /// This is an internal class.
@@ -45,6 +46,12 @@ public:
 		m_jointCount = 0;
 	}
 
+	// Store the island indices of the bodies in each contact and joint. Call
+	// this once the island is built, before solving it. Static bodies can be
+	// shared by islands that are solved at the same time, so the solver does
+	// not read b2Body::m_islandIndex itself.
+	void InitIndices();
+
 	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
 
 	void SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB);
@@ -74,6 +81,13 @@ public:
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
+	// If set, Report stores the contact impulses here instead of calling the listener.
+	b2ContactImpulse* m_impulses;
+
+	// Set by Solve when the island fell asleep. Static bodies are not touched
+	// by Solve, so putting those to sleep is up to the caller.
+	bool m_asleep;
+
 	b2Body** m_bodies;
 	b2Contact** m_contacts;
 	b2Joint** m_joints;
@@ -21,7 +21,8 @@
 
 #include <Box2D/Common/b2Math.h>
 
-/// Profiling data. Times are in milliseconds.
+/// Profiling data. Times are in milliseconds, counts are for the last time step.
+/// Contacts and proxies created, destroyed or moved between steps count towards the next step.
 struct b2Profile
 {
 	float32 step;
@@ -32,6 +33,12 @@ struct b2Profile
 	float32 solvePosition;
 	float32 broadphase;
 	float32 solveTOI;
+
+	int32 contactsCreated;
+	int32 contactsDestroyed;
+	int32 islands;
+	int32 toiEvents;
+	int32 proxyMoves;	///< proxies moved (or added) that had to look for new pairs
 };
 
 /// This is an internal structure.
@@ -33,12 +33,17 @@
 #include <Box2D/Common/b2Draw.h>
 #include <Box2D/Common/b2Timer.h>
 #include <new>
+#include <string.h>
 
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = NULL;
 	g_debugDraw = NULL;
 
+	m_workerAllocators = NULL;
+	m_workerAllocatorCount = 0;
+	m_taskExecutor = NULL;
+
 	m_bodyList = NULL;
 	m_jointList = NULL;
 
@@ -82,11 +87,18 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	for (int32 i = 0; i < m_workerAllocatorCount; ++i)
+	{
+		m_workerAllocators[i].~b2StackAllocator();
+	}
+	b2Free(m_workerAllocators);
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
 {
 	m_destructionListener = listener;
+	m_contactManager.m_destructionListener = listener;
 }
 
 void b2World::SetContactFilter(b2ContactFilter* filter)
@@ -104,6 +116,18 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	g_debugDraw = debugDraw;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	m_taskExecutor = executor;
+	m_contactManager.m_taskExecutor = executor;
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -137,6 +161,8 @@ void b2World::DestroyBody(b2Body* b)
 		return;
 	}
 
+	m_contactManager.m_modificationCount++;
+
 	// Delete the attached joints.
 	b2JointEdge* je = b->m_jointList;
 	while (je)
@@ -389,13 +415,6 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
-	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
-					m_contactManager.m_contactCount,
-					m_jointCount,
-					&m_stackAllocator,
-					m_contactManager.m_contactListener);
-
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -410,123 +429,176 @@ void b2World::Solve(const b2TimeStep& step)
 		j->m_islandFlag = false;
 	}
 
-	// Build and simulate all awake islands.
-	int32 stackSize = m_bodyCount;
-	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
-	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	if (m_taskExecutor != NULL && m_taskExecutor->GetWorkerCount() > 1)
 	{
-		if (seed->m_flags & b2Body::e_islandFlag)
-		{
-			continue;
-		}
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
 
-		if (seed->IsAwake() == false || seed->IsActive() == false)
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
 		{
-			continue;
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
 		}
 
-		// The seed can be dynamic or kinematic.
-		if (seed->GetType() == b2_staticBody)
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Add the seed and everything connected to it to the island.
+void b2World::BuildIsland(b2Island* island, b2Body* seed, b2Body** stack, int32 stackSize)
+{
+	int32 stackCount = 0;
+	stack[stackCount++] = seed;
+	seed->m_flags |= b2Body::e_islandFlag;
+
+	// Perform a depth first search (DFS) on the constraint graph.
+	while (stackCount > 0)
+	{
+		// Grab the next body off the stack and add it to the island.
+		b2Body* b = stack[--stackCount];
+		b2Assert(b->IsActive() == true);
+		island->Add(b);
+
+		// Make sure the body is awake.
+		b->SetAwake(true);
+
+		// To keep islands as small as possible, we don't
+		// propagate islands across static bodies.
+		if (b->GetType() == b2_staticBody)
 		{
 			continue;
 		}
 
-		// Reset island and stack.
-		island.Clear();
-		int32 stackCount = 0;
-		stack[stackCount++] = seed;
-		seed->m_flags |= b2Body::e_islandFlag;
-
-		// Perform a depth first search (DFS) on the constraint graph.
-		while (stackCount > 0)
+		// Search all contacts connected to this body.
+		for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
 		{
-			// Grab the next body off the stack and add it to the island.
-			b2Body* b = stack[--stackCount];
-			b2Assert(b->IsActive() == true);
-			island.Add(b);
+			b2Contact* contact = ce->contact;
 
-			// Make sure the body is awake.
-			b->SetAwake(true);
+			// Has this contact already been added to an island?
+			if (contact->m_flags & b2Contact::e_islandFlag)
+			{
+				continue;
+			}
 
-			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
-			if (b->GetType() == b2_staticBody)
+			// Is this contact solid and touching?
+			if (contact->IsEnabled() == false ||
+				contact->IsTouching() == false)
 			{
 				continue;
 			}
 
-			// Search all contacts connected to this body.
-			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			// Skip sensors.
+			bool sensorA = contact->m_fixtureA->m_isSensor;
+			bool sensorB = contact->m_fixtureB->m_isSensor;
+			if (sensorA || sensorB)
 			{
-				b2Contact* contact = ce->contact;
+				continue;
+			}
 
-				// Has this contact already been added to an island?
-				if (contact->m_flags & b2Contact::e_islandFlag)
-				{
-					continue;
-				}
+			island->Add(contact);
+			contact->m_flags |= b2Contact::e_islandFlag;
 
-				// Is this contact solid and touching?
-				if (contact->IsEnabled() == false ||
-					contact->IsTouching() == false)
-				{
-					continue;
-				}
+			b2Body* other = ce->other;
 
-				// Skip sensors.
-				bool sensorA = contact->m_fixtureA->m_isSensor;
-				bool sensorB = contact->m_fixtureB->m_isSensor;
-				if (sensorA || sensorB)
-				{
-					continue;
-				}
+			// Was the other body already added to this island?
+			if (other->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
 
-				island.Add(contact);
-				contact->m_flags |= b2Contact::e_islandFlag;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
 
-				b2Body* other = ce->other;
+		// Search all joints connect to this body.
+		for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+		{
+			if (je->joint->m_islandFlag == true)
+			{
+				continue;
+			}
 
-				// Was the other body already added to this island?
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+			b2Body* other = je->other;
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
+			// Don't simulate joints connected to inactive bodies.
+			if (other->IsActive() == false)
+			{
+				continue;
 			}
 
-			// Search all joints connect to this body.
-			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			island->Add(je->joint);
+			je->joint->m_islandFlag = true;
+
+			if (other->m_flags & b2Body::e_islandFlag)
 			{
-				if (je->joint->m_islandFlag == true)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				b2Body* other = je->other;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
+	}
 
-				// Don't simulate joints connected to inactive bodies.
-				if (other->IsActive() == false)
-				{
-					continue;
-				}
+	B2_NOT_USED(stackSize);
+}
 
-				island.Add(je->joint);
-				je->joint->m_islandFlag = true;
+// Build and simulate all awake islands, one after another.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
+	// Size the island for the worst case.
+	b2Island island(m_bodyCount,
+					m_contactManager.m_contactCount,
+					m_jointCount,
+					&m_stackAllocator,
+					m_contactManager.m_contactListener);
 
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
-			}
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
 		}
 
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		island.Clear();
+		BuildIsland(&island, seed, stack, stackSize);
+		island.InitIndices();
+		++m_profile.islands;
+
 		b2Profile profile;
 		island.Solve(&profile, step, m_gravity, m_allowSleep);
 		m_profile.solveInit += profile.solveInit;
@@ -541,36 +613,211 @@ void b2World::Solve(const b2TimeStep& step)
 			if (b->GetType() == b2_staticBody)
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
+
+				if (island.m_asleep)
+				{
+					b->SetAwake(false);
+				}
 			}
 		}
 	}
 
 	m_stackAllocator.Free(stack);
+}
+
+// The bodies, contacts and joints of one island built by SolveIslandsParallel.
+struct b2IslandRecord
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+	b2Profile profile;
+	bool asleep;
+};
 
+// Solves one recorded island per work item.
+struct b2SolveIslandTask : public b2Task
+{
+	void Execute(int32 index, int32 workerIndex)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		b2IslandRecord* record = records + index;
+
+		b2Island island(record->bodyCount,
+						record->contactCount,
+						record->jointCount,
+						allocators + workerIndex,
+						NULL);
+
+		// Don't use b2Island::Add, it writes to the bodies.
+		memcpy(island.m_bodies, bodies + record->bodyStart, record->bodyCount * sizeof(b2Body*));
+		memcpy(island.m_contacts, contacts + record->contactStart, record->contactCount * sizeof(b2Contact*));
+		memcpy(island.m_joints, joints + record->jointStart, record->jointCount * sizeof(b2Joint*));
+		island.m_bodyCount = record->bodyCount;
+		island.m_contactCount = record->contactCount;
+		island.m_jointCount = record->jointCount;
+		island.m_impulses = impulses + record->contactStart;
+
+		island.Solve(&record->profile, *step, gravity, allowSleep);
+		record->asleep = island.m_asleep;
+	}
+
+	b2IslandRecord* records;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2ContactImpulse* impulses;
+	b2StackAllocator* allocators;
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+};
+
+// Build all awake islands on this thread, then let the task executor solve
+// them. Islands only share static bodies, which the island solver does not
+// modify. Everything that would otherwise be done between two island solves
+// (putting static bodies to sleep, post-solve callbacks) is done afterwards in
+// island order, so the results match those of SolveIslands.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	int32 contactCount = m_contactManager.m_contactCount;
+
+	// A static body can be part of many islands, but only through a contact or a joint.
+	int32 bodyCapacity = m_bodyCount + contactCount + m_jointCount;
+
+	b2Island island(m_bodyCount, contactCount, m_jointCount, &m_stackAllocator, NULL);
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(bodyCapacity * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCount * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2IslandRecord* records = (b2IslandRecord*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRecord));
+
+	int32 islandCount = 0;
+	int32 bodyTotal = 0;
+	int32 contactTotal = 0;
+	int32 jointTotal = 0;
+
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		island.Clear();
+		BuildIsland(&island, seed, stack, stackSize);
+		island.InitIndices();
+		++m_profile.islands;
+
+		b2IslandRecord* record = records + islandCount++;
+		record->bodyStart = bodyTotal;
+		record->bodyCount = island.m_bodyCount;
+		record->contactStart = contactTotal;
+		record->contactCount = island.m_contactCount;
+		record->jointStart = jointTotal;
+		record->jointCount = island.m_jointCount;
+		record->asleep = false;
+
+		memcpy(bodies + bodyTotal, island.m_bodies, island.m_bodyCount * sizeof(b2Body*));
+		memcpy(contacts + contactTotal, island.m_contacts, island.m_contactCount * sizeof(b2Contact*));
+		memcpy(joints + jointTotal, island.m_joints, island.m_jointCount * sizeof(b2Joint*));
+		bodyTotal += island.m_bodyCount;
+		contactTotal += island.m_contactCount;
+		jointTotal += island.m_jointCount;
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		{
+			b2Body* b = island.m_bodies[i];
+			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->m_flags &= ~b2Body::e_islandFlag;
 			}
+		}
+	}
+	m_stackAllocator.Free(stack);
+
+	b2Assert(bodyTotal <= bodyCapacity);
 
+	b2ContactImpulse* impulses = (b2ContactImpulse*)m_stackAllocator.Allocate(contactTotal * sizeof(b2ContactImpulse));
+
+	int32 workerCount = m_taskExecutor->GetWorkerCount();
+	if (m_workerAllocatorCount < workerCount)
+	{
+		for (int32 i = 0; i < m_workerAllocatorCount; ++i)
+		{
+			m_workerAllocators[i].~b2StackAllocator();
+		}
+		b2Free(m_workerAllocators);
+
+		m_workerAllocators = (b2StackAllocator*)b2Alloc(workerCount * sizeof(b2StackAllocator));
+		for (int32 i = 0; i < workerCount; ++i)
+		{
+			new (m_workerAllocators + i) b2StackAllocator();
+		}
+		m_workerAllocatorCount = workerCount;
+	}
+
+	b2SolveIslandTask task;
+	task.records = records;
+	task.bodies = bodies;
+	task.contacts = contacts;
+	task.joints = joints;
+	task.impulses = impulses;
+	task.allocators = m_workerAllocators;
+	task.step = &step;
+	task.gravity = m_gravity;
+	task.allowSleep = m_allowSleep;
+	m_taskExecutor->Run(&task, islandCount);
+
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRecord* record = records + i;
+
+		m_profile.solveInit += record->profile.solveInit;
+		m_profile.solveVelocity += record->profile.solveVelocity;
+		m_profile.solvePosition += record->profile.solvePosition;
+
+		// Static bodies follow the last island they were part of, as they
+		// would if the islands were solved one after another.
+		for (int32 j = record->bodyStart; j < record->bodyStart + record->bodyCount; ++j)
+		{
+			b2Body* b = bodies[j];
 			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->SetAwake(record->asleep == false);
 			}
-
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		if (listener)
+		{
+			for (int32 j = record->contactStart; j < record->contactStart + record->contactCount; ++j)
+			{
+				listener->PostSolve(contacts[j], impulses + j);
+			}
+		}
 	}
+
+	m_stackAllocator.Free(impulses);
+	m_stackAllocator.Free(records);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
 }
 
 // Find TOI contacts and solve them.
@@ -719,6 +966,8 @@ void b2World::SolveTOI(const b2TimeStep& step)
 			break;
 		}
 
+		++m_profile.toiEvents;
+
 		// Advance the bodies to the TOI.
 		b2Fixture* fA = minContact->GetFixtureA();
 		b2Fixture* fB = minContact->GetFixtureB();
@@ -860,6 +1109,7 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		subStep.positionIterations = 20;
 		subStep.velocityIterations = step.velocityIterations;
 		subStep.warmStarting = false;
+		island.InitIndices();
 		island.SolveTOI(subStep, bA->m_islandIndex, bB->m_islandIndex);
 
 		// Reset island flags and synchronize broad-phase proxies.
@@ -898,6 +1148,9 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 {
 	b2Timer stepTimer;
 
+	m_profile.islands = 0;
+	m_profile.toiEvents = 0;
+
 	// If new fixtures were added, we need to find the new contacts.
 	if (m_flags & e_newFixture)
 	{
@@ -959,6 +1212,16 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 
 	m_flags &= ~e_locked;
 
+	m_profile.contactsCreated = m_contactManager.m_createdCount;
+	m_profile.contactsDestroyed = m_contactManager.m_destroyedCount;
+	m_profile.proxyMoves = m_contactManager.m_proxyMoveCount;
+
+	// The contact manager's counters are reset once they're read, so contacts
+	// destroyed between steps count towards the next one.
+	m_contactManager.m_createdCount = 0;
+	m_contactManager.m_destroyedCount = 0;
+	m_contactManager.m_proxyMoveCount = 0;
+
 	m_profile.step = stepTimer.GetMilliseconds();
 }
 
@@ -1337,3 +1600,404 @@ void b2World::Dump()
 	b2Log("joints = NULL;\n");
 	b2Log("bodies = NULL;\n");
 }
+
+// World snapshots are a flat sequence of values in native byte order. Bodies,
+// fixtures and joints are stored in list order and only checked against the
+// current ones. Contacts refer to fixtures by broad-phase proxy id, which stays
+// the same as long as the fixtures exist.
+
+static const uint32 b2_stateMagic = 0x53573262; // "b2WS"
+static const int32 b2_stateVersion = 1;
+
+struct b2StateWriter
+{
+	template <typename T>
+	void Write(const T& value)
+	{
+		if (data)
+		{
+			memcpy(data + size, &value, sizeof(T));
+		}
+		size += sizeof(T);
+	}
+
+	uint8* data;
+	int32 size;
+};
+
+struct b2StateReader
+{
+	template <typename T>
+	T Read()
+	{
+		T value;
+		if (ok == false || size - offset < (int32)sizeof(T))
+		{
+			ok = false;
+			memset((void*)&value, 0, sizeof(T));
+			return value;
+		}
+		memcpy((void*)&value, data + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+
+	const uint8* data;
+	int32 size;
+	int32 offset;
+	bool ok;
+};
+
+int32 b2World::GetStateSize() const
+{
+	return WriteState(NULL);
+}
+
+void b2World::SaveState(void* buffer) const
+{
+	WriteState((uint8*)buffer);
+}
+
+int32 b2World::WriteState(uint8* buffer) const
+{
+	b2StateWriter w;
+	w.data = buffer;
+	w.size = 0;
+
+	const b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+
+	w.Write(b2_stateMagic);
+	w.Write(b2_stateVersion);
+	w.Write(m_bodyCount);
+	w.Write(m_jointCount);
+	w.Write(m_contactManager.m_contactCount);
+	w.Write(broadPhase.GetMoveCount());
+
+	w.Write((int32)(m_flags & e_newFixture));
+	w.Write((int32)m_stepComplete);
+	w.Write(m_inv_dt0);
+	w.Write(m_gravity);
+
+	for (const b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		w.Write((int32)b->m_type);
+		w.Write((int32)b->m_flags);
+		w.Write(b->m_xf);
+		w.Write(b->m_sweep);
+		w.Write(b->m_linearVelocity);
+		w.Write(b->m_angularVelocity);
+		w.Write(b->m_force);
+		w.Write(b->m_torque);
+		w.Write(b->m_mass);
+		w.Write(b->m_invMass);
+		w.Write(b->m_I);
+		w.Write(b->m_invI);
+		w.Write(b->m_linearDamping);
+		w.Write(b->m_angularDamping);
+		w.Write(b->m_gravityScale);
+		w.Write(b->m_sleepTime);
+		w.Write(b->m_fixtureCount);
+
+		for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			w.Write(f->m_proxyCount);
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				const b2FixtureProxy* proxy = f->m_proxies + i;
+				w.Write(proxy->proxyId);
+				w.Write(proxy->aabb);
+				w.Write(broadPhase.GetFatAABB(proxy->proxyId));
+			}
+		}
+	}
+
+	for (const b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		float32 values[b2_maxJointStateValues];
+		memset(values, 0, sizeof(values));
+		j->SaveState(values);
+
+		w.Write((int32)j->m_type);
+		for (int32 i = 0; i < b2_maxJointStateValues; ++i)
+		{
+			w.Write(values[i]);
+		}
+	}
+
+	// Contacts are stored from the end of the list, so recreating them in
+	// order rebuilds the same world and body contact lists.
+	const b2Contact* last = m_contactManager.m_contactList;
+	while (last && last->m_next)
+	{
+		last = last->m_next;
+	}
+
+	for (const b2Contact* c = last; c; c = c->m_prev)
+	{
+		w.Write(c->m_fixtureA->m_proxies[c->m_indexA].proxyId);
+		w.Write(c->m_fixtureB->m_proxies[c->m_indexB].proxyId);
+		w.Write(c->m_flags);
+		w.Write(c->m_manifold);
+		w.Write(c->m_toiCount);
+		w.Write(c->m_toi);
+		w.Write(c->m_friction);
+		w.Write(c->m_restitution);
+		w.Write(c->m_tangentSpeed);
+	}
+
+	const int32* moveBuffer = broadPhase.GetMoveBuffer();
+	for (int32 i = 0; i < broadPhase.GetMoveCount(); ++i)
+	{
+		w.Write(moveBuffer[i]);
+	}
+
+	return w.size;
+}
+
+bool b2World::RestoreState(const void* buffer, int32 size)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return false;
+	}
+
+	// Check everything before changing anything.
+	if (ReadState((const uint8*)buffer, size, false) == false)
+	{
+		return false;
+	}
+
+	ReadState((const uint8*)buffer, size, true);
+	return true;
+}
+
+bool b2World::ReadState(const uint8* buffer, int32 size, bool apply)
+{
+	b2StateReader r;
+	r.data = buffer;
+	r.size = size;
+	r.offset = 0;
+	r.ok = true;
+
+	b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+
+	uint32 magic = r.Read<uint32>();
+	int32 version = r.Read<int32>();
+	int32 bodyCount = r.Read<int32>();
+	int32 jointCount = r.Read<int32>();
+	int32 contactCount = r.Read<int32>();
+	int32 moveCount = r.Read<int32>();
+
+	if (r.ok == false || magic != b2_stateMagic || version != b2_stateVersion
+		|| bodyCount != m_bodyCount || jointCount != m_jointCount
+		|| contactCount < 0 || moveCount < 0)
+	{
+		return false;
+	}
+
+	int32 newFixture = r.Read<int32>();
+	int32 stepComplete = r.Read<int32>();
+	float32 inv_dt0 = r.Read<float32>();
+	b2Vec2 gravity = r.Read<b2Vec2>();
+
+	if (apply)
+	{
+		m_flags = (m_flags & ~e_newFixture) | (newFixture ? e_newFixture : 0);
+		m_stepComplete = stepComplete != 0;
+		m_inv_dt0 = inv_dt0;
+		m_gravity = gravity;
+	}
+
+	// Proxies by id, to look up the fixtures of contacts.
+	int32 proxyIdCount = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				proxyIdCount = b2Max(proxyIdCount, f->m_proxies[i].proxyId + 1);
+			}
+		}
+	}
+
+	b2FixtureProxy** proxies = (b2FixtureProxy**)m_stackAllocator.Allocate(b2Max(proxyIdCount, 1) * sizeof(b2FixtureProxy*));
+	memset(proxies, 0, proxyIdCount * sizeof(b2FixtureProxy*));
+
+	for (b2Body* b = m_bodyList; b && r.ok; b = b->m_next)
+	{
+		int32 type = r.Read<int32>();
+		int32 flags = r.Read<int32>();
+		b2Transform xf = r.Read<b2Transform>();
+		b2Sweep sweep = r.Read<b2Sweep>();
+		b2Vec2 linearVelocity = r.Read<b2Vec2>();
+		float32 angularVelocity = r.Read<float32>();
+		b2Vec2 force = r.Read<b2Vec2>();
+		float32 torque = r.Read<float32>();
+		float32 mass = r.Read<float32>();
+		float32 invMass = r.Read<float32>();
+		float32 I = r.Read<float32>();
+		float32 invI = r.Read<float32>();
+		float32 linearDamping = r.Read<float32>();
+		float32 angularDamping = r.Read<float32>();
+		float32 gravityScale = r.Read<float32>();
+		float32 sleepTime = r.Read<float32>();
+		int32 fixtureCount = r.Read<int32>();
+
+		if (fixtureCount != b->m_fixtureCount || type < b2_staticBody || type > b2_dynamicBody)
+		{
+			r.ok = false;
+			break;
+		}
+
+		if (apply)
+		{
+			b->m_type = (b2BodyType)type;
+			b->m_flags = (uint16)flags;
+			b->m_xf = xf;
+			b->m_sweep = sweep;
+			b->m_linearVelocity = linearVelocity;
+			b->m_angularVelocity = angularVelocity;
+			b->m_force = force;
+			b->m_torque = torque;
+			b->m_mass = mass;
+			b->m_invMass = invMass;
+			b->m_I = I;
+			b->m_invI = invI;
+			b->m_linearDamping = linearDamping;
+			b->m_angularDamping = angularDamping;
+			b->m_gravityScale = gravityScale;
+			b->m_sleepTime = sleepTime;
+		}
+
+		for (b2Fixture* f = b->m_fixtureList; f && r.ok; f = f->m_next)
+		{
+			int32 proxyCount = r.Read<int32>();
+			if (proxyCount != f->m_proxyCount)
+			{
+				r.ok = false;
+				break;
+			}
+
+			for (int32 i = 0; i < proxyCount; ++i)
+			{
+				b2FixtureProxy* proxy = f->m_proxies + i;
+				int32 proxyId = r.Read<int32>();
+				b2AABB aabb = r.Read<b2AABB>();
+				b2AABB fatAABB = r.Read<b2AABB>();
+
+				if (proxyId != proxy->proxyId)
+				{
+					r.ok = false;
+					break;
+				}
+
+				proxies[proxyId] = proxy;
+
+				if (apply)
+				{
+					proxy->aabb = aabb;
+					broadPhase.SetFatAABB(proxyId, fatAABB);
+				}
+			}
+		}
+	}
+
+	for (b2Joint* j = m_jointList; j && r.ok; j = j->m_next)
+	{
+		int32 type = r.Read<int32>();
+		float32 values[b2_maxJointStateValues];
+		for (int32 i = 0; i < b2_maxJointStateValues; ++i)
+		{
+			values[i] = r.Read<float32>();
+		}
+
+		if (type != (int32)j->m_type)
+		{
+			r.ok = false;
+			break;
+		}
+
+		if (apply)
+		{
+			j->LoadState(values);
+		}
+	}
+
+	if (apply)
+	{
+		b2ContactListener* listener = m_contactManager.m_contactListener;
+		m_contactManager.m_contactListener = NULL;
+
+		while (m_contactManager.m_contactList)
+		{
+			m_contactManager.Destroy(m_contactManager.m_contactList);
+		}
+
+		m_contactManager.m_contactListener = listener;
+	}
+
+	for (int32 i = 0; i < contactCount && r.ok; ++i)
+	{
+		int32 proxyIdA = r.Read<int32>();
+		int32 proxyIdB = r.Read<int32>();
+		uint32 flags = r.Read<uint32>();
+		b2Manifold manifold = r.Read<b2Manifold>();
+		int32 toiCount = r.Read<int32>();
+		float32 toi = r.Read<float32>();
+		float32 friction = r.Read<float32>();
+		float32 restitution = r.Read<float32>();
+		float32 tangentSpeed = r.Read<float32>();
+
+		if (proxyIdA < 0 || proxyIdA >= proxyIdCount || proxies[proxyIdA] == NULL
+			|| proxyIdB < 0 || proxyIdB >= proxyIdCount || proxies[proxyIdB] == NULL
+			|| proxies[proxyIdA]->fixture->m_body == proxies[proxyIdB]->fixture->m_body
+			|| manifold.pointCount < 0 || manifold.pointCount > b2_maxManifoldPoints)
+		{
+			r.ok = false;
+			break;
+		}
+
+		if (apply)
+		{
+			b2FixtureProxy* proxyA = proxies[proxyIdA];
+			b2FixtureProxy* proxyB = proxies[proxyIdB];
+
+			b2Contact* c = b2Contact::Create(proxyA->fixture, proxyA->childIndex, proxyB->fixture, proxyB->childIndex, m_contactManager.m_allocator);
+			b2Assert(c && c->m_fixtureA == proxyA->fixture);
+
+			c->m_flags = flags;
+			c->m_manifold = manifold;
+			c->m_toiCount = toiCount;
+			c->m_toi = toi;
+			c->m_friction = friction;
+			c->m_restitution = restitution;
+			c->m_tangentSpeed = tangentSpeed;
+
+			m_contactManager.Link(c);
+		}
+	}
+
+	int32* moveBuffer = (int32*)m_stackAllocator.Allocate(b2Max(moveCount, 1) * sizeof(int32));
+	for (int32 i = 0; i < moveCount && r.ok; ++i)
+	{
+		int32 proxyId = r.Read<int32>();
+		if (proxyId != b2BroadPhase::e_nullProxy && (proxyId < 0 || proxyId >= proxyIdCount || proxies[proxyId] == NULL))
+		{
+			r.ok = false;
+			break;
+		}
+		moveBuffer[i] = proxyId;
+	}
+
+	if (apply)
+	{
+		broadPhase.SetMoveBuffer(moveBuffer, moveCount);
+	}
+
+	m_stackAllocator.Free(moveBuffer);
+	m_stackAllocator.Free(proxies);
+
+	return r.ok && r.offset == r.size;
+}
@@ -33,6 +33,7 @@ struct b2JointDef;
 class b2Body;
 class b2Draw;
 class b2Fixture;
+class b2Island;
 class b2Joint;
 
 /// The world class manages all physics entities, dynamic simulation,
@@ -66,6 +67,17 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// Register a task executor to run the narrow-phase and independent islands
+	/// on several threads. Results do not depend on the number of workers, and
+	/// listener callbacks are still made from the thread calling Step. Pass NULL
+	/// to go back to solving everything on the calling thread. The executor is
+	/// owned by you and must remain in scope.
+	/// @warning This function is locked during callbacks.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
+	/// Get the registered task executor, if any.
+	b2TaskExecutor* GetTaskExecutor() const { return m_taskExecutor; }
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -209,6 +221,25 @@ public:
 	/// @warning this should be called outside of a time step.
 	void Dump();
 
+	/// Get the number of bytes written by SaveState.
+	int32 GetStateSize() const;
+
+	/// Save the state which changes while stepping the world: body transforms,
+	/// velocities, forces, mass and sleep state, joint impulses, contacts with
+	/// their manifolds and the broad-phase proxies. Restoring it into a world
+	/// with the same bodies, fixtures and joints reproduces the following time
+	/// steps exactly. The layout is only meant to be read by the same build.
+	/// @param buffer receives GetStateSize() bytes.
+	void SaveState(void* buffer) const;
+
+	/// Restore state written by SaveState. Existing contacts are replaced by
+	/// the saved ones without calling the contact listener. The destruction
+	/// listener is still told about the contacts being replaced.
+	/// @return false, without changing anything, if the state doesn't match the
+	/// bodies, fixtures and joints of this world.
+	/// @warning This function is locked during callbacks.
+	bool RestoreState(const void* buffer, int32 size);
+
 private:
 
 	// m_flags
@@ -224,7 +255,13 @@ private:
 	friend class b2ContactManager;
 	friend class b2Controller;
 
+	int32 WriteState(uint8* buffer) const;
+	bool ReadState(const uint8* buffer, int32 size, bool apply);
+
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
+	void BuildIsland(b2Island* island, b2Body* seed, b2Body** stack, int32 stackSize);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -233,6 +270,11 @@ private:
 	b2BlockAllocator m_blockAllocator;
 	b2StackAllocator m_stackAllocator;
 
+	// One stack allocator per task executor worker.
+	b2StackAllocator* m_workerAllocators;
+	int32 m_workerAllocatorCount;
+	b2TaskExecutor* m_taskExecutor;
+
 	int32 m_flags;
 
 	b2ContactManager m_contactManager;
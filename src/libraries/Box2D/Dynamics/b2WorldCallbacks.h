@@ -45,6 +45,10 @@ public:
 	/// Called when any fixture is about to be destroyed due
 	/// to the destruction of its parent body.
 	virtual void SayGoodbye(b2Fixture* fixture) = 0;
+
+	/// Called when any contact is about to be destroyed, whether or not
+	/// it is touching. Lets you release anything associated with it.
+	virtual void SayGoodbye(b2Contact* contact) { B2_NOT_USED(contact); }
 };
 
 /// Implement this class to provide collision filtering. In other words, you can implement
@@ -152,4 +156,35 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+/// A batch of independent work items handed to a b2TaskExecutor.
+class b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	/// Process one work item. Items of the same batch may run at the same time.
+	/// @param index the work item, in the range [0, count).
+	/// @param workerIndex the worker running this item, in the range
+	/// [0, b2TaskExecutor::GetWorkerCount()). No two items run at the same time
+	/// with the same worker index.
+	virtual void Execute(int32 index, int32 workerIndex) = 0;
+};
+
+/// Implement this class to let the world spread the narrow-phase and the
+/// island solver across several threads. Listener callbacks are still made
+/// from the thread that calls b2World::Step, in a deterministic order.
+/// See b2World::SetTaskExecutor
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// The number of workers that may execute items at the same time,
+	/// including the calling thread.
+	virtual int32 GetWorkerCount() const = 0;
+
+	/// Execute every item of the task and return once all of them are done.
+	virtual void Run(b2Task* task, int32 count) = 0;
+};
+
 #endif
@@ -124,17 +124,6 @@ static char *luaL_prepbuffsize_53 (luaL_Buffer_53 *B, size_t s) {
 #define luaL_addsize_53(B, s) \
 	((B)->nelems += (s))
 
-#define luaL_addchar_53(B, c) \
-	((void)((B)->nelems < (B)->capacity || luaL_prepbuffsize_53((B), 1)), \
-	((B)->ptr[(B)->nelems++] = (c)))
-
-
-static void luaL_addlstring_53 (luaL_Buffer_53 *B, const char *s, size_t l) {
-	memcpy(luaL_prepbuffsize_53(B, l), s, l);
-	luaL_addsize_53(B, l);
-}
-
-
 void lua53_pushresult (luaL_Buffer_53 *B) {
 	lua_pushlstring(B->L2, B->ptr, B->nelems);
 	if (B->ptr != LUAL_BUFFER53_BUFFER(B))
@@ -327,15 +316,15 @@ static KOption getoption (Header *h, const char **fmt, int *size) {
 
 /*
 ** Read, classify, and fill other details about the next option.
-** 'psize' is filled with option's size, 'notoalign' with its
-** alignment requirements.
-** Local variable 'size' gets the size to be aligned. (Kpadal option
+** 'psize' is filled with option's size, 'palign' with its
+** alignment requirements (1 when it needs no alignment).
+** Local variable 'align' gets the size to be aligned. (Kpadal option
 ** always gets its full alignment, other options are limited by
 ** the maximum alignment ('maxalign'). Kchar option needs no alignment
 ** despite its size.
 */
-static KOption getdetails (Header *h, size_t totalsize,
-                           const char **fmt, int *psize, int *ntoalign) {
+static KOption getdetails (Header *h, const char **fmt, int *psize,
+                           int *palign) {
   KOption opt = getoption(h, fmt, psize);
   int align = *psize;  /* usually, alignment follows size */
   if (opt == Kpaddalign) {  /* 'X' gets alignment from following option */
@@ -343,27 +332,92 @@ static KOption getdetails (Header *h, size_t totalsize,
       luaL_argerror(h->L, 1, "invalid next option for option 'X'");
   }
   if (align <= 1 || opt == Kchar)  /* need no alignment? */
-    *ntoalign = 0;
+    align = 1;
   else {
     if (align > h->maxalign)  /* enforce maximum alignment */
       align = h->maxalign;
     if ((align & (align - 1)) != 0)  /* is 'align' not a power of 2? */
       luaL_argerror(h->L, 1, "format asks for alignment not power of 2");
-    *ntoalign = (align - (int)(totalsize & (align - 1))) & (align - 1);
   }
+  *palign = align;
   return opt;
 }
 
 
+/*
+** Number of padding bytes needed to align 'pos' to 'align', which is
+** a power of 2.
+*/
+static size_t ntoalign (size_t pos, int align) {
+  size_t mask = (size_t)align - 1;
+  return ((size_t)align - (pos & mask)) & mask;
+}
+
+
+/*
+** Iterates over the options of a format, either by reading a format
+** string or from options already read by 'lua53_str_compile'.
+** Configuration options and spaces are only seen while reading a
+** format string; they are applied to the options which follow them.
+*/
+typedef struct OptionIter {
+  Header h;
+  const char *fmt;  /* format string, or NULL for compiled options */
+  const lua53_PackOption *opt;  /* next compiled option */
+  const lua53_PackOption *end;
+} OptionIter;
+
+
+static void initformatiter (lua_State *L, OptionIter *it, const char *fmt) {
+  initheader(L, &it->h);
+  it->fmt = fmt;
+  it->opt = it->end = NULL;
+}
+
+
+static void initcompilediter (lua_State *L, OptionIter *it,
+                              const lua53_PackOption *options, int count) {
+  initheader(L, &it->h);
+  it->fmt = NULL;
+  it->opt = options;
+  it->end = options + count;
+}
+
+
+/*
+** Get the next option which packs or unpacks something. Returns 0 at
+** the end of the format.
+*/
+static int nextoption (OptionIter *it, lua53_PackOption *o) {
+  if (it->fmt != NULL) {
+    while (*it->fmt != '\0') {
+      int size, align;
+      KOption opt = getdetails(&it->h, &it->fmt, &size, &align);
+      if (opt != Knop) {
+        o->kind = (int)opt;
+        o->size = size;
+        o->align = align;
+        o->islittle = it->h.islittle;
+        return 1;
+      }
+    }
+    return 0;
+  }
+  if (it->opt == it->end)
+    return 0;
+  *o = *(it->opt++);
+  return 1;
+}
+
+
 /*
 ** Pack integer 'n' with 'size' bytes and 'islittle' endianness.
 ** The final 'if' handles the case when 'size' is larger than
 ** the size of a Lua integer, correcting the extra sign-extension
 ** bytes if necessary (by default they would be zeros).
 */
-static void packint (luaL_Buffer_53 *b, lua_Unsigned n,
+static void packint (char *buff, lua_Unsigned n,
                      int islittle, int size, int neg) {
-  char *buff = luaL_prepbuffsize_53(b, size);
   int i;
   buff[islittle ? 0 : size - 1] = (char)(n & MC);  /* first byte */
   for (i = 1; i < size; i++) {
@@ -374,7 +428,6 @@ static void packint (luaL_Buffer_53 *b, lua_Unsigned n,
     for (i = SZINT; i < size; i++)  /* correct extra bytes */
       buff[islittle ? i : size - 1 - i] = (char)MC;
   }
-  luaL_addsize_53(b, size);  /* add result to buffer */
 }
 
 
@@ -396,86 +449,160 @@ static void copywithendian (volatile char *dest, volatile const char *src,
 }
 
 
-void lua53_str_pack (lua_State *L, const char *fmt, int startidx, luaL_Buffer_53 *b) {
-  Header h;
+/*
+** Number of bytes option 'o' packs argument 'arg' into, not counting
+** alignment. String arguments are returned in 's' and 'len'.
+*/
+static size_t packedsize (lua_State *L, const lua53_PackOption *o, int arg,
+                          const char **s, size_t *len) {
+  switch ((KOption)o->kind) {
+    case Kchar: {  /* fixed-size string */
+      *s = luaL_checklstring(L, arg, len);
+      luaL_argcheck(L, *len <= (size_t)o->size, arg,
+                       "string longer than given size");
+      return (size_t)o->size;
+    }
+    case Kstring: {  /* strings with length count */
+      *s = luaL_checklstring(L, arg, len);
+      luaL_argcheck(L, o->size >= (int)sizeof(size_t) ||
+                       *len < ((size_t)1 << (o->size * NB)),
+                       arg, "string length does not fit in given size");
+      return (size_t)o->size + *len;
+    }
+    case Kzstr: {  /* zero-terminated string */
+      *s = luaL_checklstring(L, arg, len);
+      luaL_argcheck(L, strlen(*s) == *len, arg, "string contains zeros");
+      return *len + 1;
+    }
+    default:
+      return (size_t)o->size;
+  }
+}
+
+
+/*
+** Pack argument 'arg' with option 'o' into 'buff', which has room for
+** the size given by 'packedsize'.
+*/
+static void packoption (lua_State *L, const lua53_PackOption *o, int arg,
+                        const char *s, size_t len, char *buff) {
+  int size = o->size;
+  switch ((KOption)o->kind) {
+    case Kint: {  /* signed integers */
+      lua_Integer n = luaL_checkinteger(L, arg);
+      if (size < SZINT) {  /* need overflow check? */
+        lua_Integer lim = (lua_Integer)1 << ((size * NB) - 1);
+        luaL_argcheck(L, -lim <= n && n < lim, arg, "integer overflow");
+      }
+      packint(buff, (lua_Unsigned)n, o->islittle, size, (n < 0));
+      break;
+    }
+    case Kuint: {  /* unsigned integers */
+      lua_Integer n = luaL_checkinteger(L, arg);
+      if (size < SZINT)  /* need overflow check? */
+        luaL_argcheck(L, (lua_Unsigned)n < ((lua_Unsigned)1 << (size * NB)),
+                         arg, "unsigned overflow");
+      packint(buff, (lua_Unsigned)n, o->islittle, size, 0);
+      break;
+    }
+    case Kfloat: {  /* floating-point options */
+      volatile Ftypes u;
+      lua_Number n = luaL_checknumber(L, arg);  /* get argument */
+      if (size == sizeof(u.f)) u.f = (float)n;  /* copy it into 'u' */
+      else if (size == sizeof(u.d)) u.d = (double)n;
+      else u.n = n;
+      /* move 'u' to final result, correcting endianness if needed */
+      copywithendian(buff, u.buff, size, o->islittle);
+      break;
+    }
+    case Kchar: {  /* fixed-size string */
+      memcpy(buff, s, len);
+      memset(buff + len, LUAL_PACKPADBYTE, (size_t)size - len);  /* pad extra space */
+      break;
+    }
+    case Kstring: {  /* strings with length count */
+      packint(buff, (lua_Unsigned)len, o->islittle, size, 0);  /* pack length */
+      memcpy(buff + size, s, len);
+      break;
+    }
+    case Kzstr: {  /* zero-terminated string */
+      memcpy(buff, s, len);
+      buff[len] = '\0';  /* add zero at the end */
+      break;
+    }
+    case Kpadding: buff[0] = LUAL_PACKPADBYTE; break;
+    case Kpaddalign: case Knop: break;
+  }
+}
+
+
+/*
+** Pack the arguments following 'startidx' - 1. The result goes into the
+** buffer 'b' if it isn't NULL, or otherwise into the 'dstsize' bytes at
+** 'dst' (which raises an error for argument 'dstidx' if they don't fit).
+** Returns the size of the result.
+*/
+static size_t packoptions (lua_State *L, OptionIter *it, int startidx,
+                           luaL_Buffer_53 *b, char *dst, size_t dstsize,
+                           int dstidx) {
+  lua53_PackOption o;
   int arg = startidx - 1;  /* current argument to pack */
   size_t totalsize = 0;  /* accumulate total size of result */
-  initheader(L, &h);
-  lua_pushnil(L);  /* mark to separate arguments from string buffer */
-  luaL_buffinit_53(L, b);
-  while (*fmt != '\0') {
-    int size, ntoalign;
-    KOption opt = getdetails(&h, totalsize, &fmt, &size, &ntoalign);
-    totalsize += ntoalign + size;
-    while (ntoalign-- > 0)
-     luaL_addchar_53(b, LUAL_PACKPADBYTE);  /* fill alignment */
-    arg++;
-    switch (opt) {
-      case Kint: {  /* signed integers */
-        lua_Integer n = luaL_checkinteger(L, arg);
-        if (size < SZINT) {  /* need overflow check? */
-          lua_Integer lim = (lua_Integer)1 << ((size * NB) - 1);
-          luaL_argcheck(L, -lim <= n && n < lim, arg, "integer overflow");
-        }
-        packint(b, (lua_Unsigned)n, h.islittle, size, (n < 0));
-        break;
-      }
-      case Kuint: {  /* unsigned integers */
-        lua_Integer n = luaL_checkinteger(L, arg);
-        if (size < SZINT)  /* need overflow check? */
-          luaL_argcheck(L, (lua_Unsigned)n < ((lua_Unsigned)1 << (size * NB)),
-                           arg, "unsigned overflow");
-        packint(b, (lua_Unsigned)n, h.islittle, size, 0);
-        break;
-      }
-      case Kfloat: {  /* floating-point options */
-        volatile Ftypes u;
-        char *buff = luaL_prepbuffsize_53(b, size);
-        lua_Number n = luaL_checknumber(L, arg);  /* get argument */
-        if (size == sizeof(u.f)) u.f = (float)n;  /* copy it into 'u' */
-        else if (size == sizeof(u.d)) u.d = (double)n;
-        else u.n = n;
-        /* move 'u' to final result, correcting endianness if needed */
-        copywithendian(buff, u.buff, size, h.islittle);
-        luaL_addsize_53(b, size);
-        break;
-      }
-      case Kchar: {  /* fixed-size string */
-        size_t len;
-        const char *s = luaL_checklstring(L, arg, &len);
-        luaL_argcheck(L, len <= (size_t)size, arg,
-                         "string longer than given size");
-        luaL_addlstring_53(b, s, len);  /* add string */
-        while (len++ < (size_t)size)  /* pad extra space */
-          luaL_addchar_53(b, LUAL_PACKPADBYTE);
-        break;
-      }
-      case Kstring: {  /* strings with length count */
-        size_t len;
-        const char *s = luaL_checklstring(L, arg, &len);
-        luaL_argcheck(L, size >= (int)sizeof(size_t) ||
-                         len < ((size_t)1 << (size * NB)),
-                         arg, "string length does not fit in given size");
-        packint(b, (lua_Unsigned)len, h.islittle, size, 0);  /* pack length */
-        luaL_addlstring_53(b, s, len);
-        totalsize += len;
-        break;
-      }
-      case Kzstr: {  /* zero-terminated string */
-        size_t len;
-        const char *s = luaL_checklstring(L, arg, &len);
-        luaL_argcheck(L, strlen(s) == len, arg, "string contains zeros");
-        luaL_addlstring_53(b, s, len);
-        luaL_addchar_53(b, '\0');  /* add zero at the end */
-        totalsize += len + 1;
-        break;
-      }
-      case Kpadding: luaL_addchar_53(b, LUAL_PACKPADBYTE);  /* FALLTHROUGH */
-      case Kpaddalign: case Knop:
-        arg--;  /* undo increment */
-        break;
+  while (nextoption(it, &o)) {
+    size_t pad = ntoalign(totalsize, o.align);
+    const char *s = NULL;
+    size_t len = 0;
+    size_t size;
+    char *buff;
+    if (o.kind != Kpadding && o.kind != Kpaddalign)
+      arg++;
+    size = packedsize(L, &o, arg, &s, &len);
+    if (b != NULL)
+      buff = luaL_prepbuffsize_53(b, pad + size);
+    else {
+      if (pad + size > dstsize - totalsize)
+        luaL_argerror(L, dstidx, "not enough space for the packed values");
+      buff = dst + totalsize;
     }
+    memset(buff, LUAL_PACKPADBYTE, pad);  /* fill alignment */
+    packoption(L, &o, arg, s, len, buff + pad);
+    if (b != NULL)
+      luaL_addsize_53(b, pad + size);
+    totalsize += pad + size;
   }
+  return totalsize;
+}
+
+
+void lua53_str_pack (lua_State *L, const char *fmt, int startidx, luaL_Buffer_53 *b) {
+  OptionIter it;
+  initformatiter(L, &it, fmt);
+  lua_pushnil(L);  /* mark to separate arguments from string buffer */
+  luaL_buffinit_53(L, b);
+  packoptions(L, &it, startidx, b, NULL, 0, 0);
+}
+
+
+void lua53_str_pack_compiled (lua_State *L, const lua53_PackOption *options, int count, int startidx, luaL_Buffer_53 *b) {
+  OptionIter it;
+  initcompilediter(L, &it, options, count);
+  lua_pushnil(L);  /* mark to separate arguments from string buffer */
+  luaL_buffinit_53(L, b);
+  packoptions(L, &it, startidx, b, NULL, 0, 0);
+}
+
+
+size_t lua53_str_packinto (lua_State *L, const char *fmt, int startidx, char *dst, size_t dstsize, int dstidx) {
+  OptionIter it;
+  initformatiter(L, &it, fmt);
+  return packoptions(L, &it, startidx, NULL, dst, dstsize, dstidx);
+}
+
+
+size_t lua53_str_packinto_compiled (lua_State *L, const lua53_PackOption *options, int count, int startidx, char *dst, size_t dstsize, int dstidx) {
+  OptionIter it;
+  initcompilediter(L, &it, options, count);
+  return packoptions(L, &it, startidx, NULL, dst, dstsize, dstidx);
 }
 
 
@@ -485,9 +612,9 @@ int lua53_str_packsize (lua_State *L) {
   size_t totalsize = 0;  /* accumulate total size of result */
   initheader(L, &h);
   while (*fmt != '\0') {
-    int size, ntoalign;
-    KOption opt = getdetails(&h, totalsize, &fmt, &size, &ntoalign);
-    size += ntoalign;  /* total space used by option */
+    int size, align;
+    KOption opt = getdetails(&h, &fmt, &size, &align);
+    size += (int)ntoalign(totalsize, align);  /* total space used by option */
     luaL_argcheck(L, totalsize <= MAXSIZE - size, 1,
                      "format result too large");
     totalsize += size;
@@ -504,6 +631,33 @@ int lua53_str_packsize (lua_State *L) {
 }
 
 
+int lua53_str_compile (lua_State *L, const char *fmt, lua53_PackOption *options) {
+  OptionIter it;
+  lua53_PackOption o;
+  int count = 0;
+  initformatiter(L, &it, fmt);
+  while (nextoption(&it, &o)) {
+    if (options != NULL)
+      options[count] = o;
+    count++;
+  }
+  return count;
+}
+
+
+int lua53_str_compiledsize (const lua53_PackOption *options, int count, size_t *size) {
+  size_t totalsize = 0;
+  int i;
+  for (i = 0; i < count; i++) {
+    if (options[i].kind == Kstring || options[i].kind == Kzstr)
+      return 0;  /* variable-length format */
+    totalsize += ntoalign(totalsize, options[i].align) + (size_t)options[i].size;
+  }
+  *size = totalsize;
+  return 1;
+}
+
+
 /*
 ** Unpack an integer with 'size' bytes and 'islittle' endianness.
 ** If size is smaller than the size of a Lua integer and integer
@@ -538,33 +692,32 @@ static lua_Integer unpackint (lua_State *L, const char *str,
 }
 
 
-int lua53_str_unpack (lua_State *L, const char *fmt, const char *data, size_t ld, int dataidx, int posidx) {
-  Header h;
+static int unpackoptions (lua_State *L, OptionIter *it, const char *data, size_t ld, int dataidx, int posidx) {
+  lua53_PackOption o;
   size_t pos = (size_t)posrelat(luaL_optinteger(L, posidx, 1), ld) - 1;
   int n = 0;  /* number of results */
   luaL_argcheck(L, pos <= ld, posidx, "initial position out of string");
-  initheader(L, &h);
-  while (*fmt != '\0') {
-    int size, ntoalign;
-    KOption opt = getdetails(&h, pos, &fmt, &size, &ntoalign);
-    if ((size_t)ntoalign + size > ~pos || pos + ntoalign + size > ld)
+  while (nextoption(it, &o)) {
+    size_t pad = ntoalign(pos, o.align);
+    size_t size = (size_t)o.size;
+    if (pad + size > ~pos || pos + pad + size > ld)
       luaL_argerror(L, dataidx, "data string too short");
-    pos += ntoalign;  /* skip alignment */
+    pos += pad;  /* skip alignment */
     /* stack space for item + next position */
-    luaL_checkstack(L, dataidx, "too many results");
+    luaL_checkstack(L, 2, "too many results");
     n++;
-    switch (opt) {
+    switch ((KOption)o.kind) {
       case Kint:
       case Kuint: {
-        lua_Integer res = unpackint(L, data + pos, h.islittle, size,
-                                       (opt == Kint));
+        lua_Integer res = unpackint(L, data + pos, o.islittle, o.size,
+                                       (o.kind == Kint));
         lua_pushinteger(L, res);
         break;
       }
       case Kfloat: {
         volatile Ftypes u;
         lua_Number num;
-        copywithendian(u.buff, data + pos, size, h.islittle);
+        copywithendian(u.buff, data + pos, o.size, o.islittle);
         if (size == sizeof(u.f)) num = (lua_Number)u.f;
         else if (size == sizeof(u.d)) num = (lua_Number)u.d;
         else num = u.n;
@@ -576,14 +729,18 @@ int lua53_str_unpack (lua_State *L, const char *fmt, const char *data, size_t ld
         break;
       }
       case Kstring: {
-        size_t len = (size_t)unpackint(L, data + pos, h.islittle, size, 0);
-        luaL_argcheck(L, pos + len + size <= ld, dataidx, "data string too short");
+        size_t len = (size_t)unpackint(L, data + pos, o.islittle, o.size, 0);
+        luaL_argcheck(L, len <= ld - pos - size, dataidx, "data string too short");
         lua_pushlstring(L, data + pos + size, len);
         pos += len;  /* skip string */
         break;
       }
       case Kzstr: {
-        size_t len = (int)strlen(data + pos);
+        /* Data objects aren't zero-terminated, so look for the end */
+        const char *end = (const char *)memchr(data + pos, '\0', ld - pos);
+        size_t len;
+        luaL_argcheck(L, end != NULL, dataidx, "unfinished string for format 'z'");
+        len = (size_t)(end - (data + pos));
         lua_pushlstring(L, data + pos, len);
         pos += len + 1;  /* skip string plus final '\0' */
         break;
@@ -598,5 +755,19 @@ int lua53_str_unpack (lua_State *L, const char *fmt, const char *data, size_t ld
   return n + 1;
 }
 
+
+int lua53_str_unpack (lua_State *L, const char *fmt, const char *data, size_t ld, int dataidx, int posidx) {
+  OptionIter it;
+  initformatiter(L, &it, fmt);
+  return unpackoptions(L, &it, data, ld, dataidx, posidx);
+}
+
+
+int lua53_str_unpack_compiled (lua_State *L, const lua53_PackOption *options, int count, const char *data, size_t ld, int dataidx, int posidx) {
+  OptionIter it;
+  initcompilediter(L, &it, options, count);
+  return unpackoptions(L, &it, data, ld, dataidx, posidx);
+}
+
 /* }====================================================== */
 
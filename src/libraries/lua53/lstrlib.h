@@ -7,6 +7,7 @@ extern "C" {
 #endif
 
 #include "lua.h"
+#include "lauxlib.h"
 
 typedef struct luaL_Buffer_53 {
 	luaL_Buffer b; /* make incorrect code crash! */
@@ -16,6 +17,14 @@ typedef struct luaL_Buffer_53 {
 	lua_State *L2;
 } luaL_Buffer_53;
 
+/* a format option read ahead of time by lua53_str_compile */
+typedef struct lua53_PackOption {
+	int kind;
+	int size;
+	int align;
+	int islittle;
+} lua53_PackOption;
+
 void lua53_pushresult (luaL_Buffer_53 *B);
 void lua53_cleanupbuffer (luaL_Buffer_53 *B);
 
@@ -23,6 +32,18 @@ void lua53_str_pack (lua_State *L, const char *fmt, int startidx, luaL_Buffer_53
 int lua53_str_packsize (lua_State *L);
 int lua53_str_unpack (lua_State *L, const char *fmt, const char *data, size_t ld, int dataidx, int posidx);
 
+/* packs into existing memory, returning the number of bytes written */
+size_t lua53_str_packinto (lua_State *L, const char *fmt, int startidx, char *dst, size_t dstsize, int dstidx);
+
+/* fills 'options' (if not NULL) and returns the number of options */
+int lua53_str_compile (lua_State *L, const char *fmt, lua53_PackOption *options);
+/* returns 0 if the size depends on the packed values */
+int lua53_str_compiledsize (const lua53_PackOption *options, int count, size_t *size);
+
+void lua53_str_pack_compiled (lua_State *L, const lua53_PackOption *options, int count, int startidx, luaL_Buffer_53 *b);
+size_t lua53_str_packinto_compiled (lua_State *L, const lua53_PackOption *options, int count, int startidx, char *dst, size_t dstsize, int dstidx);
+int lua53_str_unpack_compiled (lua_State *L, const lua53_PackOption *options, int count, const char *data, size_t ld, int dataidx, int posidx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,8 +47,12 @@ class Noise1234 {
     static float pnoise( float x, float y, float z, float w,
                               int px, int py, int pz, int pw );
 
-  private:
+/** The permutation table, identical to the one in SimplexNoise1234. Public so
+ *  vectorized versions of the noise functions can use the same hashes.
+ */
     static unsigned char perm[];
+
+  private:
     static float  grad( int hash, float x );
     static float  grad( int hash, float x, float y );
     static float  grad( int hash, float x, float y , float z );
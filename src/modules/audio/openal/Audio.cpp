@@ -74,6 +74,9 @@ void Audio::PoolThread::setFinish()
 
 ALenum Audio::getFormat(int bitDepth, int channels)
 {
+	if (bitDepth == 32)
+		return getFloatFormat(channels);
+
 	if (bitDepth != 8 && bitDepth != 16)
 		return AL_NONE;
 
@@ -93,6 +96,31 @@ ALenum Audio::getFormat(int bitDepth, int channels)
 	return AL_NONE;
 }
 
+ALenum Audio::getFloatFormat(int channels)
+{
+#ifdef AL_EXT_float32
+	if (!alIsExtensionPresent("AL_EXT_float32"))
+		return AL_NONE;
+
+	if (channels == 1)
+		return AL_FORMAT_MONO_FLOAT32;
+	else if (channels == 2)
+		return AL_FORMAT_STEREO_FLOAT32;
+#ifdef AL_EXT_MCFORMATS
+	else if (alIsExtensionPresent("AL_EXT_MCFORMATS"))
+	{
+		if (channels == 6)
+			return AL_FORMAT_51CHN32;
+		else if (channels == 8)
+			return AL_FORMAT_71CHN32;
+	}
+#endif
+#else
+	LOVE_UNUSED(channels);
+#endif
+	return AL_NONE;
+}
+
 Audio::Audio()
 	: device(nullptr)
 	, context(nullptr)
@@ -73,7 +73,8 @@ public:
 	 * Gets the OpenAL format identifier based on number of
 	 * channels and bits.
 	 * @param channels.
-	 * @param bitDepth Either 8-bit samples, or 16-bit samples.
+	 * @param bitDepth Either 8-bit samples, 16-bit samples, or 32-bit floating
+	 *        point samples (only if the AL_EXT_float32 extension is present).
 	 * @return One of AL_FORMAT_*, or AL_NONE if unsupported format.
 	 **/
 	static ALenum getFormat(int bitDepth, int channels);
@@ -128,6 +129,8 @@ public:
 	bool getEffectID(const char *name, ALuint &id);
 
 private:
+	static ALenum getFloatFormat(int channels);
+
 	void initializeEFX();
 	// The OpenAL device.
 	ALCdevice *device;
@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "BlockContainer.h"
+#include "common/Exception.h"
+#include "thread/threads.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace love
+{
+namespace data
+{
+
+// The container starts with this header, followed by the compressed size of
+// each block (as 32 bit integers), followed by the blocks themselves. All
+// values are little-endian.
+//
+//   char   magic[8]
+//   uint8  format
+//   uint8  version
+//   uint16 reserved
+//   uint32 blockSize
+//   uint64 rawSize
+//   uint32 blockCount
+
+static const char CONTAINER_MAGIC[8] = {'L', 'O', 'V', 'E', 'B', 'L', 'K', 'S'};
+static const uint8 CONTAINER_VERSION = 1;
+static const size_t HEADER_SIZE = 28;
+
+static const size_t MIN_BLOCK_SIZE = 1024;
+static const size_t MAX_BLOCK_SIZE = 1 << 30;
+
+static void writeLE(char *dst, uint64 v, int bytes)
+{
+	for (int i = 0; i < bytes; i++)
+		dst[i] = (char) ((v >> (i * 8)) & 0xFF);
+}
+
+static uint64 readLE(const char *src, int bytes)
+{
+	uint64 v = 0;
+	for (int i = 0; i < bytes; i++)
+		v |= (uint64) (uint8) src[i] << (i * 8);
+	return v;
+}
+
+bool BlockContainer::isContainer(const char *data, size_t size)
+{
+	return size >= HEADER_SIZE && memcmp(data, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC)) == 0;
+}
+
+BlockContainer::BlockContainer(const char *data, size_t size)
+	: data(data)
+	, format(Compressor::FORMAT_MAX_ENUM)
+	, blockSize(0)
+	, rawSize(0)
+{
+	if (!isContainer(data, size))
+		throw love::Exception("Invalid compressed block container.");
+
+	uint8 formatvalue = (uint8) data[8];
+	uint8 version = (uint8) data[9];
+
+	if (version != CONTAINER_VERSION)
+		throw love::Exception("Unsupported compressed block container version (%d).", (int) version);
+
+	if (formatvalue >= Compressor::FORMAT_MAX_ENUM)
+		throw love::Exception("Invalid compressed block container format.");
+
+	format = (Compressor::Format) formatvalue;
+
+	uint64 blocksize = readLE(data + 12, 4);
+	uint64 rawsize = readLE(data + 16, 8);
+	uint64 blockcount = readLE(data + 24, 4);
+
+	if (blocksize < MIN_BLOCK_SIZE || blocksize > MAX_BLOCK_SIZE || rawsize > std::numeric_limits<size_t>::max())
+		throw love::Exception("Invalid compressed block container header.");
+
+	// Written without (rawsize + blocksize - 1) so a huge rawsize can't wrap
+	// around to a block count which passes the checks.
+	uint64 expectedcount = rawsize / blocksize + (rawsize % blocksize != 0 ? 1 : 0);
+
+	if (blockcount != expectedcount || blockcount > (size - HEADER_SIZE) / 4 || rawsize > blockcount * blocksize)
+		throw love::Exception("Invalid compressed block container header.");
+
+	blockSize = (size_t) blocksize;
+	rawSize = (size_t) rawsize;
+
+	blockOffsets.resize((size_t) blockcount + 1);
+
+	size_t offset = HEADER_SIZE + (size_t) blockcount * 4;
+	for (size_t i = 0; i < (size_t) blockcount; i++)
+	{
+		blockOffsets[i] = offset;
+
+		size_t csize = (size_t) readLE(data + HEADER_SIZE + i * 4, 4);
+		if (offset > size || csize > size - offset)
+			throw love::Exception("Invalid compressed block container: block %d is truncated.", (int) i);
+
+		offset += csize;
+	}
+
+	blockOffsets[(size_t) blockcount] = offset;
+
+	// decompress() indexes blockOffsets[block + 1] directly, so make sure the
+	// offsets only ever increase and stay inside the data.
+	for (size_t i = 0; i < (size_t) blockcount; i++)
+	{
+		if (blockOffsets[i] > blockOffsets[i + 1] || blockOffsets[i + 1] > size)
+			throw love::Exception("Invalid compressed block container: block %d is outside of the data.", (int) i);
+	}
+}
+
+char *BlockContainer::compress(Compressor::Format format, const char *data, size_t size, int level, size_t blockSize, int threadCount, size_t &compressedSize)
+{
+	Compressor *compressor = Compressor::getCompressor(format);
+
+	if (compressor == nullptr)
+		throw love::Exception("Invalid compression format.");
+
+	if (blockSize < MIN_BLOCK_SIZE || blockSize > MAX_BLOCK_SIZE)
+		throw love::Exception("Block size must be between %d and %d bytes.", (int) MIN_BLOCK_SIZE, (int) MAX_BLOCK_SIZE);
+
+	size_t blockcount = (size + blockSize - 1) / blockSize;
+
+	if ((uint64) blockcount > 0xFFFFFFFF)
+		throw love::Exception("Too many blocks for a compressed block container.");
+
+	std::vector<char *> blocks(blockcount, nullptr);
+	std::vector<size_t> blocksizes(blockcount, 0);
+
+	char *result = nullptr;
+
+	try
+	{
+		love::thread::parallelFor((int) blockcount, threadCount, [&](int i)
+		{
+			size_t offset = (size_t) i * blockSize;
+			size_t rawsize = std::min(blockSize, size - offset);
+
+			blocks[i] = compressor->compress(format, data + offset, rawsize, level, blocksizes[i]);
+
+			if (blocksizes[i] > 0xFFFFFFFF)
+				throw love::Exception("Compressed block is too large.");
+		});
+
+		size_t indexsize = HEADER_SIZE + blockcount * 4;
+
+		compressedSize = indexsize;
+		for (size_t csize : blocksizes)
+			compressedSize += csize;
+
+		try
+		{
+			result = new char[compressedSize];
+		}
+		catch (std::bad_alloc &)
+		{
+			throw love::Exception("Out of memory.");
+		}
+	}
+	catch (love::Exception &)
+	{
+		for (char *block : blocks)
+			delete[] block;
+		throw;
+	}
+
+	memcpy(result, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+	writeLE(result + 8, (uint64) format, 1);
+	writeLE(result + 9, CONTAINER_VERSION, 1);
+	writeLE(result + 10, 0, 2);
+	writeLE(result + 12, (uint64) blockSize, 4);
+	writeLE(result + 16, (uint64) size, 8);
+	writeLE(result + 24, (uint64) blockcount, 4);
+
+	char *dst = result + HEADER_SIZE + blockcount * 4;
+
+	for (size_t i = 0; i < blockcount; i++)
+	{
+		writeLE(result + HEADER_SIZE + i * 4, (uint64) blocksizes[i], 4);
+
+		memcpy(dst, blocks[i], blocksizes[i]);
+		dst += blocksizes[i];
+
+		delete[] blocks[i];
+	}
+
+	return result;
+}
+
+Compressor::Format BlockContainer::getFormat() const
+{
+	return format;
+}
+
+size_t BlockContainer::getBlockSize() const
+{
+	return blockSize;
+}
+
+size_t BlockContainer::getBlockCount() const
+{
+	return blockOffsets.size() - 1;
+}
+
+size_t BlockContainer::getDecompressedSize() const
+{
+	return rawSize;
+}
+
+char *BlockContainer::decompress(size_t offset, size_t size, int threadCount) const
+{
+	if (offset > rawSize || size > rawSize - offset)
+		throw love::Exception("The range to decompress is outside of the compressed data's bounds.");
+
+	Compressor *compressor = Compressor::getCompressor(format);
+
+	if (compressor == nullptr)
+		throw love::Exception("Invalid compression format.");
+
+	char *result = nullptr;
+
+	try
+	{
+		result = new char[std::max(size, (size_t) 1)];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	if (size == 0)
+		return result;
+
+	size_t firstblock = offset / blockSize;
+	size_t lastblock = (offset + size - 1) / blockSize;
+
+	try
+	{
+		love::thread::parallelFor((int) (lastblock - firstblock + 1), threadCount, [&](int i)
+		{
+			size_t block = firstblock + (size_t) i;
+			size_t blockstart = block * blockSize;
+			size_t blockrawsize = std::min(blockSize, rawSize - blockstart);
+
+			// The expected size saves zlib from guessing. LZ4 would trust it
+			// without any bounds checks though, so it reads the size stored in
+			// the block itself instead.
+			size_t decompressedsize = format == Compressor::FORMAT_LZ4 ? 0 : blockrawsize;
+			char *raw = compressor->decompress(format, data + blockOffsets[block], blockOffsets[block + 1] - blockOffsets[block], decompressedsize);
+
+			if (decompressedsize != blockrawsize)
+			{
+				delete[] raw;
+				throw love::Exception("Invalid compressed block container: block %d has the wrong size.", (int) block);
+			}
+
+			size_t start = std::max(offset, blockstart);
+			size_t end = std::min(offset + size, blockstart + blockrawsize);
+
+			memcpy(result + (start - offset), raw + (start - blockstart), end - start);
+			delete[] raw;
+		});
+	}
+	catch (love::Exception &)
+	{
+		delete[] result;
+		throw;
+	}
+
+	return result;
+}
+
+} // data
+} // love
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * A container for data which has been split into fixed-size blocks, each
+ * compressed independently with one of the regular formats. Blocks can be
+ * compressed and decompressed on several threads at once, and the block index
+ * stored up front allows decompressing part of the data without touching the
+ * rest of it.
+ **/
+class BlockContainer
+{
+public:
+
+	static const size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+
+	/**
+	 * Gets whether the given compressed data starts with a block container
+	 * header.
+	 **/
+	static bool isContainer(const char *data, size_t size);
+
+	/**
+	 * Reads the block index of a container. The data is referenced rather
+	 * than copied, so it must outlive this object. Throws an exception if the
+	 * header or index is invalid.
+	 **/
+	BlockContainer(const char *data, size_t size);
+
+	/**
+	 * Compresses data into a new block container.
+	 *
+	 * @param[in] format The format each block is compressed with.
+	 * @param[in] data The data to compress.
+	 * @param[in] size The size in bytes of the data to compress.
+	 * @param[in] level The amount of compression to apply to each block.
+	 * @param[in] blockSize The uncompressed size of each block.
+	 * @param[in] threadCount The maximum number of threads to use.
+	 * @param[out] compressedSize The size in bytes of the container.
+	 * @return The container (allocated with new[]).
+	 **/
+	static char *compress(Compressor::Format format, const char *data, size_t size, int level, size_t blockSize, int threadCount, size_t &compressedSize);
+
+	Compressor::Format getFormat() const;
+	size_t getBlockSize() const;
+	size_t getBlockCount() const;
+	size_t getDecompressedSize() const;
+
+	/**
+	 * Decompresses a range of the original data, only touching the blocks
+	 * which overlap it.
+	 *
+	 * @param offset The offset in bytes into the uncompressed data.
+	 * @param size The number of bytes to decompress.
+	 * @param threadCount The maximum number of threads to use.
+	 * @return The decompressed bytes (allocated with new[]).
+	 **/
+	char *decompress(size_t offset, size_t size, int threadCount) const;
+
+private:
+
+	const char *data;
+
+	Compressor::Format format;
+	size_t blockSize;
+	size_t rawSize;
+
+	// Offsets of each block's compressed data, plus the end of the last one.
+	std::vector<size_t> blockOffsets;
+
+}; // BlockContainer
+
+} // data
+} // love
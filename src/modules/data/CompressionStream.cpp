@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "CompressionStream.h"
+#include "common/Exception.h"
+
+#include "libraries/lz4/lz4.h"
+#include "libraries/lz4/lz4hc.h"
+#include "libraries/xxHash/xxhash.h"
+
+#include <zlib.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+namespace love
+{
+namespace data
+{
+
+// Output is produced in pieces of this size.
+static const size_t OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+static void writeLE32(char *dst, uint32 v)
+{
+	dst[0] = (char) (v & 0xFF);
+	dst[1] = (char) ((v >> 8) & 0xFF);
+	dst[2] = (char) ((v >> 16) & 0xFF);
+	dst[3] = (char) ((v >> 24) & 0xFF);
+}
+
+static void appendLE32(std::vector<char> &out, uint32 v)
+{
+	char bytes[4];
+	writeLE32(bytes, v);
+	out.insert(out.end(), bytes, bytes + 4);
+}
+
+class zlibCompressionStream : public CompressionStream
+{
+public:
+
+	zlibCompressionStream(Compressor::Format format, int level)
+		: CompressionStream(format)
+		, stream()
+	{
+		int windowbits = 15;
+		if (format == Compressor::FORMAT_GZIP)
+			windowbits += 16; // This tells zlib to use a gzip header.
+		else if (format == Compressor::FORMAT_DEFLATE)
+			windowbits = -windowbits;
+
+		if (level < 0)
+			level = Z_DEFAULT_COMPRESSION;
+		else if (level > 9)
+			level = 9;
+
+		if (deflateInit2(&stream, level, Z_DEFLATED, windowbits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			throw love::Exception("Could not initialize zlib/gzip compression.");
+	}
+
+	virtual ~zlibCompressionStream()
+	{
+		deflateEnd(&stream);
+	}
+
+protected:
+
+	void compress(const char *data, size_t size, std::vector<char> &out) override
+	{
+		deflateData(data, size, Z_NO_FLUSH, out);
+	}
+
+	void flushOutput(std::vector<char> &out) override
+	{
+		deflateData(nullptr, 0, Z_SYNC_FLUSH, out);
+	}
+
+	void finishOutput(std::vector<char> &out) override
+	{
+		deflateData(nullptr, 0, Z_FINISH, out);
+	}
+
+private:
+
+	void deflateData(const char *data, size_t size, int flush, std::vector<char> &out)
+	{
+		// zlib counts input in uInts, so very large inputs are split up.
+		const size_t maxchunk = 1 << 30;
+
+		do
+		{
+			size_t chunk = std::min(size, maxchunk);
+
+			stream.next_in = (Bytef *) data;
+			stream.avail_in = (uInt) chunk;
+
+			data += chunk;
+			size -= chunk;
+
+			int mode = size > 0 ? Z_NO_FLUSH : flush;
+
+			while (true)
+			{
+				size_t start = out.size();
+				out.resize(start + OUTPUT_CHUNK_SIZE);
+
+				stream.next_out = (Bytef *) &out[start];
+				stream.avail_out = (uInt) OUTPUT_CHUNK_SIZE;
+
+				int err = deflate(&stream, mode);
+
+				out.resize(start + OUTPUT_CHUNK_SIZE - stream.avail_out);
+
+				if (err == Z_STREAM_ERROR)
+					throw love::Exception("Could not zlib/gzip-compress data.");
+
+				// Everything has been consumed and written once zlib stops
+				// filling the output buffer (or ends the stream.)
+				if (mode == Z_FINISH ? err == Z_STREAM_END : stream.avail_out != 0)
+					break;
+			}
+		} while (size > 0);
+	}
+
+	z_stream stream;
+
+}; // zlibCompressionStream
+
+/**
+ * Writes the LZ4 frame format (as used by the lz4 command line tool), with
+ * 64 KB linked blocks and a content checksum.
+ **/
+class LZ4FrameCompressionStream : public CompressionStream
+{
+public:
+
+	LZ4FrameCompressionStream(int level)
+		: CompressionStream(Compressor::FORMAT_LZ4_FRAME)
+		, stream(nullptr)
+		, streamHC(nullptr)
+		, checksum(nullptr)
+		, block(BLOCK_SIZE)
+		, blockUsed(0)
+		, dictionary(DICTIONARY_SIZE)
+		, headerWritten(false)
+	{
+		// Use LZ4-HC for compression level 9 and higher.
+		if (level >= 9)
+		{
+			streamHC = LZ4_createStreamHC();
+			if (streamHC != nullptr)
+				LZ4_resetStreamHC(streamHC, LZ4HC_CLEVEL_DEFAULT);
+		}
+		else
+			stream = LZ4_createStream();
+
+		checksum = XXH32_createState();
+
+		if ((stream == nullptr && streamHC == nullptr) || checksum == nullptr)
+		{
+			release();
+			throw love::Exception("Out of memory.");
+		}
+
+		XXH32_reset(checksum, 0);
+	}
+
+	virtual ~LZ4FrameCompressionStream()
+	{
+		release();
+	}
+
+protected:
+
+	void compress(const char *data, size_t size, std::vector<char> &out) override
+	{
+		writeHeader(out);
+
+		XXH32_update(checksum, data, size);
+
+		while (size > 0)
+		{
+			size_t n = std::min(size, BLOCK_SIZE - blockUsed);
+			memcpy(&block[blockUsed], data, n);
+
+			blockUsed += n;
+			data += n;
+			size -= n;
+
+			if (blockUsed == BLOCK_SIZE)
+				writeBlock(out);
+		}
+	}
+
+	void flushOutput(std::vector<char> &out) override
+	{
+		writeHeader(out);
+		writeBlock(out);
+	}
+
+	void finishOutput(std::vector<char> &out) override
+	{
+		writeHeader(out);
+		writeBlock(out);
+
+		// End mark, followed by the content checksum.
+		appendLE32(out, 0);
+		appendLE32(out, XXH32_digest(checksum));
+	}
+
+private:
+
+	static const size_t BLOCK_SIZE = 64 * 1024;
+	static const size_t DICTIONARY_SIZE = 64 * 1024;
+
+	void release()
+	{
+		if (stream != nullptr)
+			LZ4_freeStream(stream);
+		if (streamHC != nullptr)
+			LZ4_freeStreamHC(streamHC);
+		if (checksum != nullptr)
+			XXH32_freeState(checksum);
+
+		stream = nullptr;
+		streamHC = nullptr;
+		checksum = nullptr;
+	}
+
+	void writeHeader(std::vector<char> &out)
+	{
+		if (headerWritten)
+			return;
+
+		appendLE32(out, 0x184D2204);
+
+		// Version 1, linked blocks, content checksum; 64 KB maximum block size.
+		char descriptor[3] = {0x44, 0x40, 0};
+		descriptor[2] = (char) ((XXH32(descriptor, 2, 0) >> 8) & 0xFF);
+
+		out.insert(out.end(), descriptor, descriptor + 3);
+		headerWritten = true;
+	}
+
+	void writeBlock(std::vector<char> &out)
+	{
+		if (blockUsed == 0)
+			return;
+
+		int rawsize = (int) blockUsed;
+		int maxsize = LZ4_compressBound(rawsize);
+
+		size_t start = out.size();
+		out.resize(start + 4 + maxsize);
+
+		char *dst = &out[start + 4];
+		int csize = 0;
+
+		if (streamHC != nullptr)
+			csize = LZ4_compress_HC_continue(streamHC, &block[0], dst, rawsize, maxsize);
+		else
+			csize = LZ4_compress_fast_continue(stream, &block[0], dst, rawsize, maxsize, 1);
+
+		// Blocks which don't shrink are stored as they are.
+		if (csize > 0 && csize < rawsize)
+		{
+			out.resize(start + 4 + csize);
+			writeLE32(&out[start], (uint32) csize);
+		}
+		else
+		{
+			out.resize(start);
+			appendLE32(out, (uint32) rawsize | 0x80000000);
+			out.insert(out.end(), block.begin(), block.begin() + rawsize);
+		}
+
+		// Later blocks refer back to this one, but the block buffer is about to
+		// be reused, so the history is moved somewhere safe.
+		if (streamHC != nullptr)
+			LZ4_saveDictHC(streamHC, &dictionary[0], (int) DICTIONARY_SIZE);
+		else
+			LZ4_saveDict(stream, &dictionary[0], (int) DICTIONARY_SIZE);
+
+		blockUsed = 0;
+	}
+
+	LZ4_stream_t *stream;
+	LZ4_streamHC_t *streamHC;
+	XXH32_state_t *checksum;
+
+	std::vector<char> block;
+	size_t blockUsed;
+
+	std::vector<char> dictionary;
+
+	bool headerWritten;
+
+}; // LZ4FrameCompressionStream
+
+love::Type CompressionStream::type("CompressionStream", &Object::type);
+
+CompressionStream *CompressionStream::create(Compressor::Format format, int level)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_ZLIB:
+	case Compressor::FORMAT_GZIP:
+	case Compressor::FORMAT_DEFLATE:
+		return new zlibCompressionStream(format, level);
+	case Compressor::FORMAT_LZ4_FRAME:
+		return new LZ4FrameCompressionStream(level);
+	case Compressor::FORMAT_LZ4:
+		throw love::Exception("The lz4 format can't be streamed. Use lz4frame instead.");
+	default:
+		throw love::Exception("Invalid compression format.");
+	}
+}
+
+CompressionStream::CompressionStream(Compressor::Format format)
+	: format(format)
+	, finished(false)
+	, inputSize(0)
+	, outputSize(0)
+{
+}
+
+CompressionStream::~CompressionStream()
+{
+}
+
+Compressor::Format CompressionStream::getFormat() const
+{
+	return format;
+}
+
+void CompressionStream::update(const char *data, size_t size, std::vector<char> &out)
+{
+	if (finished)
+		throw love::Exception("Cannot compress more data after the stream has been finished.");
+
+	size_t start = out.size();
+	compress(data, size, out);
+
+	inputSize += size;
+	outputSize += out.size() - start;
+}
+
+void CompressionStream::flush(std::vector<char> &out)
+{
+	if (finished)
+		throw love::Exception("Cannot flush a compression stream after it has been finished.");
+
+	size_t start = out.size();
+	flushOutput(out);
+
+	outputSize += out.size() - start;
+}
+
+void CompressionStream::finish(std::vector<char> &out)
+{
+	if (finished)
+		throw love::Exception("The compression stream has already been finished.");
+
+	size_t start = out.size();
+	finishOutput(out);
+
+	outputSize += out.size() - start;
+	finished = true;
+}
+
+bool CompressionStream::isFinished() const
+{
+	return finished;
+}
+
+uint64 CompressionStream::getInputSize() const
+{
+	return inputSize;
+}
+
+uint64 CompressionStream::getOutputSize() const
+{
+	return outputSize;
+}
+
+} // data
+} // love
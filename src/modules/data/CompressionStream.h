@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/int.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Compresses data incrementally, so neither the whole input nor the whole
+ * output has to be in memory at once.
+ **/
+class CompressionStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	/**
+	 * Creates a stream which compresses to the given format. LOVE's own LZ4
+	 * format stores the total size up front, so it can't be streamed.
+	 *
+	 * @param format The format to compress to.
+	 * @param level The amount of compression to apply (between 0 and 9.)
+	 *              A value of -1 indicates the default amount of compression.
+	 **/
+	static CompressionStream *create(Compressor::Format format, int level);
+
+	virtual ~CompressionStream();
+
+	Compressor::Format getFormat() const;
+
+	/**
+	 * Compresses more data, appending any compressed output which is ready to
+	 * 'out'. Input may be held back internally until later calls.
+	 **/
+	void update(const char *data, size_t size, std::vector<char> &out);
+
+	/**
+	 * Appends compressed output for all of the data given so far, so that
+	 * everything up to this point can be decompressed by the receiver. This
+	 * costs some compression ratio, so it's meant for message boundaries.
+	 **/
+	void flush(std::vector<char> &out);
+
+	/**
+	 * Ends the stream, appending the remaining compressed output. No more
+	 * data can be compressed afterwards.
+	 **/
+	void finish(std::vector<char> &out);
+
+	bool isFinished() const;
+
+	uint64 getInputSize() const;
+	uint64 getOutputSize() const;
+
+protected:
+
+	CompressionStream(Compressor::Format format);
+
+	virtual void compress(const char *data, size_t size, std::vector<char> &out) = 0;
+	virtual void flushOutput(std::vector<char> &out) = 0;
+	virtual void finishOutput(std::vector<char> &out) = 0;
+
+private:
+
+	Compressor::Format format;
+	bool finished;
+
+	uint64 inputSize;
+	uint64 outputSize;
+
+}; // CompressionStream
+
+} // data
+} // love
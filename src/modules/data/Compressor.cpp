@@ -20,6 +20,8 @@
 
 // LOVE
 #include "Compressor.h"
+#include "CompressionStream.h"
+#include "DecompressionStream.h"
 #include "common/config.h"
 #include "common/int.h"
 
@@ -28,6 +30,9 @@
 
 #include <zlib.h>
 
+// C++
+#include <cstring>
+
 namespace love
 {
 namespace data
@@ -358,12 +363,80 @@ public:
 
 }; // zlibCompressor
 
+/**
+ * The standard LZ4 frame format. Unlike LOVE's own LZ4 format it doesn't
+ * store the uncompressed size up front, so it's handled by the streams.
+ **/
+class LZ4FrameCompressor : public Compressor
+{
+public:
+
+	char *compress(Format format, const char *data, size_t dataSize, int level, size_t &compressedSize) override
+	{
+		if (format != FORMAT_LZ4_FRAME)
+			throw love::Exception("Invalid format (expecting LZ4 frame)");
+
+		StrongRef<CompressionStream> stream(CompressionStream::create(format, level), Acquire::NORETAIN);
+
+		std::vector<char> out;
+		stream->update(data, dataSize, out);
+		stream->finish(out);
+
+		return copyOutput(out, compressedSize);
+	}
+
+	char *decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize) override
+	{
+		if (format != FORMAT_LZ4_FRAME)
+			throw love::Exception("Invalid format (expecting LZ4 frame)");
+
+		StrongRef<DecompressionStream> stream(DecompressionStream::create(format), Acquire::NORETAIN);
+
+		std::vector<char> out;
+		out.reserve(decompressedSize);
+
+		stream->update(data, dataSize, out);
+		stream->finish();
+
+		return copyOutput(out, decompressedSize);
+	}
+
+	bool isSupported(Format format) const override
+	{
+		return format == FORMAT_LZ4_FRAME;
+	}
+
+private:
+
+	char *copyOutput(const std::vector<char> &out, size_t &size)
+	{
+		char *result = nullptr;
+
+		try
+		{
+			result = new char[std::max(out.size(), (size_t) 1)];
+		}
+		catch (std::bad_alloc &)
+		{
+			throw love::Exception("Out of memory.");
+		}
+
+		if (!out.empty())
+			memcpy(result, out.data(), out.size());
+
+		size = out.size();
+		return result;
+	}
+
+}; // LZ4FrameCompressor
+
 Compressor *Compressor::getCompressor(Format format)
 {
 	static LZ4Compressor lz4compressor;
 	static zlibCompressor zlibcompressor;
+	static LZ4FrameCompressor lz4framecompressor;
 
-	Compressor *compressors[] = {&lz4compressor, &zlibcompressor};
+	Compressor *compressors[] = {&lz4compressor, &zlibcompressor, &lz4framecompressor};
 
 	for (Compressor *c : compressors)
 	{
@@ -391,10 +464,11 @@ std::vector<std::string> Compressor::getConstants(Format)
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM>::Entry Compressor::formatEntries[] =
 {
-	{ "lz4",     FORMAT_LZ4     },
-	{ "zlib",    FORMAT_ZLIB    },
-	{ "gzip",    FORMAT_GZIP    },
-	{ "deflate", FORMAT_DEFLATE },
+	{ "lz4",      FORMAT_LZ4       },
+	{ "zlib",     FORMAT_ZLIB      },
+	{ "gzip",     FORMAT_GZIP      },
+	{ "deflate",  FORMAT_DEFLATE   },
+	{ "lz4frame", FORMAT_LZ4_FRAME },
 };
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM> Compressor::formatNames(Compressor::formatEntries, sizeof(Compressor::formatEntries));
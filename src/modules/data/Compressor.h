@@ -41,6 +41,7 @@ public:
 		FORMAT_ZLIB,
 		FORMAT_GZIP,
 		FORMAT_DEFLATE,
+		FORMAT_LZ4_FRAME,
 		FORMAT_MAX_ENUM
 	};
 
@@ -20,9 +20,17 @@
 
 // LOVE
 #include "DataModule.h"
+#include "BlockContainer.h"
 #include "common/b64.h"
 #include "common/int.h"
 #include "common/StringMap.h"
+#include "thread/threads.h"
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 // STL
 #include <cmath>
@@ -34,6 +42,56 @@ namespace
 
 static const char hexchars[] = "0123456789abcdef";
 
+#if defined(LOVE_SIMD_SSE2)
+
+// Maps 4-bit values to '0'-'9' and 'a'-'f'.
+inline __m128i hexDigits(__m128i v)
+{
+	__m128i letters = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+	return _mm_add_epi8(v, _mm_add_epi8(_mm_set1_epi8('0'), letters));
+}
+
+// Maps hex characters to 4-bit values. Other characters become 0.
+inline __m128i hexNibbles(__m128i v)
+{
+	__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+	__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('F' + 1)));
+	__m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('f' + 1)));
+
+	__m128i n = _mm_and_si128(digit, _mm_sub_epi8(v, _mm_set1_epi8('0')));
+	n = _mm_or_si128(n, _mm_and_si128(upper, _mm_sub_epi8(v, _mm_set1_epi8('A' - 10))));
+	n = _mm_or_si128(n, _mm_and_si128(lower, _mm_sub_epi8(v, _mm_set1_epi8('a' - 10))));
+	return n;
+}
+
+// Joins pairs of nibbles (high nibble first) in each 16-bit lane into a byte.
+inline __m128i hexJoin(__m128i n)
+{
+	return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(n, 4), _mm_set1_epi16(0x00F0)), _mm_srli_epi16(n, 8));
+}
+
+#elif defined(LOVE_SIMD_NEON)
+
+inline uint8x16_t hexDigits(uint8x16_t v)
+{
+	uint8x16_t letters = vandq_u8(vcgtq_u8(v, vdupq_n_u8(9)), vdupq_n_u8('a' - '0' - 10));
+	return vaddq_u8(v, vaddq_u8(vdupq_n_u8('0'), letters));
+}
+
+inline uint8x16_t hexNibbles(uint8x16_t v)
+{
+	uint8x16_t digit = vandq_u8(vcgeq_u8(v, vdupq_n_u8('0')), vcleq_u8(v, vdupq_n_u8('9')));
+	uint8x16_t upper = vandq_u8(vcgeq_u8(v, vdupq_n_u8('A')), vcleq_u8(v, vdupq_n_u8('F')));
+	uint8x16_t lower = vandq_u8(vcgeq_u8(v, vdupq_n_u8('a')), vcleq_u8(v, vdupq_n_u8('f')));
+
+	uint8x16_t n = vandq_u8(digit, vsubq_u8(v, vdupq_n_u8('0')));
+	n = vorrq_u8(n, vandq_u8(upper, vsubq_u8(v, vdupq_n_u8('A' - 10))));
+	n = vorrq_u8(n, vandq_u8(lower, vsubq_u8(v, vdupq_n_u8('a' - 10))));
+	return n;
+}
+
+#endif
+
 char *bytesToHex(const love::uint8 *src, size_t srclen, size_t &dstlen)
 {
 	dstlen = srclen * 2;
@@ -51,7 +109,32 @@ char *bytesToHex(const love::uint8 *src, size_t srclen, size_t &dstlen)
 		throw love::Exception("Out of memory.");
 	}
 
-	for (size_t i = 0; i < srclen; i++)
+	size_t i = 0;
+
+#if defined(LOVE_SIMD_SSE2)
+	for (; i + 16 <= srclen; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i hi = hexDigits(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+		__m128i lo = hexDigits(_mm_and_si128(v, _mm_set1_epi8(0x0F)));
+
+		_mm_storeu_si128((__m128i *) (dst + i * 2 + 0), _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *) (dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	for (; i + 16 <= srclen; i += 16)
+	{
+		uint8x16_t v = vld1q_u8(src + i);
+
+		uint8x16x2_t out;
+		out.val[0] = hexDigits(vshrq_n_u8(v, 4));
+		out.val[1] = hexDigits(vandq_u8(v, vdupq_n_u8(0x0F)));
+
+		vst2q_u8((love::uint8 *) (dst + i * 2), out);
+	}
+#endif
+
+	for (; i < srclen; i++)
 	{
 		love::uint8 b = src[i];
 		dst[i * 2 + 0] = hexchars[b >> 4];
@@ -76,13 +159,53 @@ love::uint8 nibble(char c)
 	return 0;
 }
 
-love::uint8 *hexToBytes(const char *src, size_t srclen, size_t &dstlen)
+void skipHexPrefix(const char *&src, size_t &srclen)
 {
 	if (srclen >= 2 && src[0] == '0' && (src[1] == 'x' || src[1] == 'X'))
 	{
 		src += 2;
 		srclen -= 2;
 	}
+}
+
+// Writes (srclen + 1) / 2 bytes. The destination may overlap the source as
+// long as it doesn't start after it.
+void hexToBytes(const char *src, size_t srclen, love::uint8 *dst)
+{
+	size_t dstlen = (srclen + 1) / 2;
+	size_t i = 0;
+
+#if defined(LOVE_SIMD_SSE2)
+	for (; (i + 16) * 2 <= srclen; i += 16)
+	{
+		__m128i a = hexJoin(hexNibbles(_mm_loadu_si128((const __m128i *) (src + i * 2 + 0))));
+		__m128i b = hexJoin(hexNibbles(_mm_loadu_si128((const __m128i *) (src + i * 2 + 16))));
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(a, b));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	for (; (i + 16) * 2 <= srclen; i += 16)
+	{
+		uint8x16x2_t in = vld2q_u8((const love::uint8 *) (src + i * 2));
+		uint8x16_t hi = hexNibbles(in.val[0]);
+		uint8x16_t lo = hexNibbles(in.val[1]);
+		vst1q_u8(dst + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+	}
+#endif
+
+	for (; i < dstlen; i++)
+	{
+		love::uint8 b = nibble(src[i * 2]) << 4;
+
+		if (i * 2 + 1 < srclen)
+			b |= nibble(src[i * 2 + 1]);
+
+		dst[i] = b;
+	}
+}
+
+love::uint8 *hexToBytes(const char *src, size_t srclen, size_t &dstlen)
+{
+	skipHexPrefix(src, srclen);
 
 	dstlen = (srclen + 1) / 2;
 
@@ -99,14 +222,7 @@ love::uint8 *hexToBytes(const char *src, size_t srclen, size_t &dstlen)
 		throw love::Exception("Out of memory.");
 	}
 
-	for (size_t i = 0; i < dstlen; i++)
-	{
-		dst[i] = nibble(src[i * 2]) << 4;
-
-		if (i * 2 + 1 < srclen)
-			dst[i] |= nibble(src[i * 2 + 1]);
-	}
-
+	hexToBytes(src, srclen, dst);
 	return dst;
 }
 
@@ -142,6 +258,26 @@ CompressedData *compress(Compressor::Format format, const char *rawbytes, size_t
 	return data;
 }
 
+CompressedData *compress(Compressor::Format format, const char *rawbytes, size_t rawsize, int level, size_t blocksize, int threadcount)
+{
+	size_t compressedsize = 0;
+	char *cbytes = BlockContainer::compress(format, rawbytes, rawsize, level, blocksize, threadcount, compressedsize);
+
+	CompressedData *data = nullptr;
+
+	try
+	{
+		data = new CompressedData(format, cbytes, compressedsize, rawsize, true);
+	}
+	catch (love::Exception &)
+	{
+		delete[] cbytes;
+		throw;
+	}
+
+	return data;
+}
+
 char *decompress(CompressedData *data, size_t &decompressedsize)
 {
 	size_t rawsize = data->getDecompressedSize();
@@ -155,6 +291,17 @@ char *decompress(CompressedData *data, size_t &decompressedsize)
 
 char *decompress(Compressor::Format format, const char *cbytes, size_t compressedsize, size_t &rawsize)
 {
+	if (BlockContainer::isContainer(cbytes, compressedsize))
+	{
+		BlockContainer container(cbytes, compressedsize);
+
+		if (container.getFormat() != format)
+			throw love::Exception("Compressed data format does not match the format of its blocks.");
+
+		rawsize = container.getDecompressedSize();
+		return container.decompress(0, rawsize, love::thread::getProcessorCount());
+	}
+
 	Compressor *compressor = Compressor::getCompressor(format);
 
 	if (compressor == nullptr)
@@ -163,6 +310,19 @@ char *decompress(Compressor::Format format, const char *cbytes, size_t compresse
 	return compressor->decompress(format, cbytes, compressedsize, rawsize);
 }
 
+char *decompressRange(Compressor::Format format, const char *cbytes, size_t compressedsize, size_t offset, size_t size)
+{
+	if (!BlockContainer::isContainer(cbytes, compressedsize))
+		throw love::Exception("Only data compressed into blocks can be partially decompressed.");
+
+	BlockContainer container(cbytes, compressedsize);
+
+	if (container.getFormat() != format)
+		throw love::Exception("Compressed data format does not match the format of its blocks.");
+
+	return container.decompress(offset, size, love::thread::getProcessorCount());
+}
+
 char *encode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen, size_t linelen)
 {
 	switch (format)
@@ -187,6 +347,35 @@ char *decode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen
 	}
 }
 
+size_t decode(EncodeFormat format, const char *src, size_t srclen, char *dst, size_t dstlen)
+{
+	if (dst > src && dst < src + srclen)
+		throw love::Exception("The decoded data cannot start after the encoded data if they overlap.");
+
+	size_t size = 0;
+
+	switch (format)
+	{
+	case ENCODE_BASE64:
+	default:
+		// Line breaks and padding make the upper bound an overestimate, so
+		// only count the exact size when the bound doesn't fit.
+		size = (srclen / 4) * 3 + (srclen % 4 > 1 ? srclen % 4 - 1 : 0);
+		if (size > dstlen)
+			size = b64_decode_size(src, srclen);
+		if (size > dstlen)
+			throw love::Exception("Not enough space in the destination for the decoded data (need %d bytes).", (int) size);
+		return b64_decode(src, srclen, dst);
+	case ENCODE_HEX:
+		skipHexPrefix(src, srclen);
+		size = (srclen + 1) / 2;
+		if (size > dstlen)
+			throw love::Exception("Not enough space in the destination for the decoded data (need %d bytes).", (int) size);
+		hexToBytes(src, srclen, (uint8 *) dst);
+		return size;
+	}
+}
+
 std::string hash(HashFunction::Function function, Data *input)
 {
 	return hash(function, (const char*) input->getData(), input->getSize());
@@ -241,6 +430,21 @@ ByteData *DataModule::newByteData(void *d, size_t size, bool own)
 	return new ByteData(d, size, own);
 }
 
+CompressionStream *DataModule::newCompressionStream(Compressor::Format format, int level)
+{
+	return CompressionStream::create(format, level);
+}
+
+DecompressionStream *DataModule::newDecompressionStream(Compressor::Format format)
+{
+	return DecompressionStream::create(format);
+}
+
+Hasher *DataModule::newHasher(HashFunction::Function function)
+{
+	return new Hasher(function);
+}
+
 static StringMap<EncodeFormat, ENCODE_MAX_ENUM>::Entry encoderEntries[] =
 {
 	{ "base64", ENCODE_BASE64 },
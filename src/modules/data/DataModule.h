@@ -22,7 +22,10 @@
 
 #include "CompressedData.h"
 #include "Compressor.h"
+#include "CompressionStream.h"
+#include "DecompressionStream.h"
 #include "HashFunction.h"
+#include "Hasher.h"
 #include "DataView.h"
 #include "ByteData.h"
 
@@ -62,6 +65,21 @@ enum ContainerType
  **/
 CompressedData *compress(Compressor::Format format, const char *rawbytes, size_t rawsize, int level = -1);
 
+/**
+ * Compresses a block of memory into a container of independently compressed
+ * blocks. Blocks are compressed in parallel, and can later be decompressed
+ * in parallel or individually (see decompressRange.)
+ *
+ * @param format The compression format to use for each block.
+ * @param rawbytes The data to compress.
+ * @param rawsize The size in bytes of the data to compress.
+ * @param level The amount of compression to apply (between 0 and 9.)
+ * @param blocksize The uncompressed size in bytes of each block.
+ * @param threadcount The maximum number of threads to compress with.
+ * @return The newly compressed data.
+ **/
+CompressedData *compress(Compressor::Format format, const char *rawbytes, size_t rawsize, int level, size_t blocksize, int threadcount);
+
 /**
  * Decompresses existing compressed data into raw bytes.
  *
@@ -84,9 +102,36 @@ char *decompress(CompressedData *data, size_t &decompressedsize);
  **/
 char *decompress(Compressor::Format format, const char *cbytes, size_t compressedsize, size_t &rawsize);
 
+/**
+ * Decompresses part of a block container created by the block-based compress
+ * function, only decompressing the blocks which overlap the range.
+ *
+ * @param format The compression format the data is in.
+ * @param cbytes The compressed data.
+ * @param compressedsize The size in bytes of the compressed data.
+ * @param offset The offset in bytes into the uncompressed data.
+ * @param size The number of uncompressed bytes to return.
+ * @return The newly decompressed data (allocated with new[]).
+ **/
+char *decompressRange(Compressor::Format format, const char *cbytes, size_t compressedsize, size_t offset, size_t size);
+
 char *encode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen, size_t linelen = 0);
 char *decode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen);
 
+/**
+ * Decodes data into an existing buffer. The buffer may be the source itself,
+ * in which case the data is decoded in-place.
+ *
+ * @param format The format the data is encoded in.
+ * @param src The encoded data.
+ * @param srclen The size in bytes of the encoded data.
+ * @param dst The buffer to write the decoded data to. It may overlap the
+ *        source as long as it doesn't start after it.
+ * @param dstlen The size in bytes of the destination buffer.
+ * @return The size in bytes of the decoded data.
+ **/
+size_t decode(EncodeFormat format, const char *src, size_t srclen, char *dst, size_t dstlen);
+
 /**
  * Hash the input, producing an set of bytes as output.
  *
@@ -126,6 +171,11 @@ public:
 	ByteData *newByteData(const void *d, size_t size);
 	ByteData *newByteData(void *d, size_t size, bool own);
 
+	CompressionStream *newCompressionStream(Compressor::Format format, int level);
+	DecompressionStream *newDecompressionStream(Compressor::Format format);
+
+	Hasher *newHasher(HashFunction::Function function);
+
 }; // DataModule
 
 } // data
@@ -0,0 +1,559 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "DecompressionStream.h"
+#include "common/Exception.h"
+
+#include "libraries/lz4/lz4.h"
+#include "libraries/xxHash/xxhash.h"
+
+#include <zlib.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+namespace love
+{
+namespace data
+{
+
+// Output is produced in pieces of this size.
+static const size_t OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+static uint32 readLE32(const char *data)
+{
+	const unsigned char *b = (const unsigned char *) data;
+	return (uint32) b[0] | ((uint32) b[1] << 8) | ((uint32) b[2] << 16) | ((uint32) b[3] << 24);
+}
+
+class zlibDecompressionStream : public DecompressionStream
+{
+public:
+
+	zlibDecompressionStream(Compressor::Format format)
+		: DecompressionStream(format)
+		, outputFull(false)
+		, stream()
+	{
+		// 15 + 32 lets zlib detect whether a zlib or gzip header is present.
+		int windowbits = format == Compressor::FORMAT_DEFLATE ? -15 : 15 + 32;
+
+		if (inflateInit2(&stream, windowbits) != Z_OK)
+			throw love::Exception("Could not initialize zlib/gzip decompression.");
+	}
+
+	virtual ~zlibDecompressionStream()
+	{
+		inflateEnd(&stream);
+	}
+
+protected:
+
+	void decompress(const char *data, size_t size, size_t maxOutput, std::vector<char> &out) override
+	{
+		// Input left over from a call which reached its output limit comes
+		// first. Otherwise the new data is used directly, and only what's
+		// left of it is kept.
+		if (!input.empty())
+		{
+			input.insert(input.end(), data, data + size);
+			size_t used = inflateInput(input.data(), input.size(), maxOutput, out);
+			input.erase(input.begin(), input.begin() + used);
+		}
+		else
+		{
+			size_t used = inflateInput(data, size, maxOutput, out);
+			input.assign(data + used, data + size);
+		}
+
+		outputPending = outputFull || !input.empty();
+	}
+
+private:
+
+	// Returns the number of bytes of input which were used.
+	size_t inflateInput(const char *data, size_t size, size_t maxOutput, std::vector<char> &out)
+	{
+		// zlib counts input in uInts, so very large inputs are split up.
+		const size_t maxchunk = 1 << 30;
+
+		size_t used = 0;
+		size_t produced = 0;
+
+		while ((used < size || outputFull) && produced < maxOutput)
+		{
+			if (complete)
+			{
+				// gzip allows several members to be concatenated together.
+				if (getFormat() != Compressor::FORMAT_GZIP || inflateReset(&stream) != Z_OK)
+					throw love::Exception("Unexpected data after the end of the compressed stream.");
+
+				complete = false;
+			}
+
+			size_t inchunk = std::min(size - used, maxchunk);
+			size_t outchunk = std::min(maxOutput - produced, OUTPUT_CHUNK_SIZE);
+
+			stream.next_in = (Bytef *) (data + used);
+			stream.avail_in = (uInt) inchunk;
+
+			size_t start = out.size();
+			out.resize(start + outchunk);
+
+			stream.next_out = (Bytef *) &out[start];
+			stream.avail_out = (uInt) outchunk;
+
+			int err = inflate(&stream, Z_NO_FLUSH);
+
+			size_t written = outchunk - stream.avail_out;
+			out.resize(start + written);
+
+			used += inchunk - stream.avail_in;
+			produced += written;
+
+			// zlib might have more output for the input it's been given.
+			outputFull = stream.avail_out == 0;
+
+			if (err == Z_STREAM_END)
+			{
+				complete = true;
+				outputFull = false;
+			}
+			else if (err == Z_BUF_ERROR)
+			{
+				// No progress is possible until more data arrives.
+				outputFull = false;
+				break;
+			}
+			else if (err != Z_OK)
+				throw love::Exception("Could not decompress zlib/gzip-compressed data.");
+		}
+
+		return used;
+	}
+
+	std::vector<char> input;
+	bool outputFull;
+
+	z_stream stream;
+
+}; // zlibDecompressionStream
+
+/**
+ * Reads the LZ4 frame format, including concatenated and skippable frames.
+ * Incoming data is buffered until a whole header or block is available.
+ **/
+class LZ4FrameDecompressionStream : public DecompressionStream
+{
+public:
+
+	LZ4FrameDecompressionStream()
+		: DecompressionStream(Compressor::FORMAT_LZ4_FRAME)
+		, state(STATE_MAGIC)
+		, checksum(nullptr)
+		, flags(0)
+		, blockMaxSize(0)
+		, contentSize(0)
+		, frameOutputSize(0)
+		, skipSize(0)
+		, decodedPos(0)
+	{
+		checksum = XXH32_createState();
+		if (checksum == nullptr)
+			throw love::Exception("Out of memory.");
+	}
+
+	virtual ~LZ4FrameDecompressionStream()
+	{
+		XXH32_freeState(checksum);
+	}
+
+protected:
+
+	void decompress(const char *data, size_t size, size_t maxOutput, std::vector<char> &out) override
+	{
+		pending.insert(pending.end(), data, data + size);
+
+		size_t start = out.size();
+		size_t pos = 0;
+
+		while (true)
+		{
+			size_t room = maxOutput - (out.size() - start);
+
+			// A block which didn't fit in the output limit is handed out first.
+			if (decodedPos < decoded.size())
+			{
+				size_t n = std::min(decoded.size() - decodedPos, room);
+				out.insert(out.end(), decoded.begin() + decodedPos, decoded.begin() + decodedPos + n);
+				decodedPos += n;
+
+				if (decodedPos < decoded.size())
+					break;
+
+				decoded.clear();
+				decodedPos = 0;
+				continue;
+			}
+
+			if (room == 0 || !parse(pos, room, out))
+				break;
+		}
+
+		pending.erase(pending.begin(), pending.begin() + pos);
+
+		outputPending = out.size() - start == maxOutput && (decodedPos < decoded.size() || !pending.empty());
+	}
+
+private:
+
+	enum State
+	{
+		STATE_MAGIC,
+		STATE_SKIP,
+		STATE_HEADER,
+		STATE_BLOCK,
+		STATE_CHECKSUM,
+	};
+
+	enum FrameFlag
+	{
+		FLAG_CONTENT_CHECKSUM = 0x04,
+		FLAG_CONTENT_SIZE = 0x08,
+		FLAG_BLOCK_CHECKSUM = 0x10,
+		FLAG_INDEPENDENT_BLOCKS = 0x20,
+		FLAG_DICTIONARY_ID = 0x01,
+	};
+
+	static const size_t HISTORY_SIZE = 64 * 1024;
+
+	// Handles the next part of the stream, if enough data for it is buffered.
+	// Blocks which could be larger than 'room' are decoded into 'decoded'.
+	bool parse(size_t &pos, size_t room, std::vector<char> &out)
+	{
+		const char *data = pending.data() + pos;
+		size_t available = pending.size() - pos;
+
+		switch (state)
+		{
+		case STATE_MAGIC:
+		{
+			if (available < 4)
+				return false;
+
+			uint32 magic = readLE32(data);
+			pos += 4;
+
+			if (magic == 0x184D2204)
+				state = STATE_HEADER;
+			else if ((magic & 0xFFFFFFF0) == 0x184D2A50)
+				state = STATE_SKIP;
+			else
+				throw love::Exception("Invalid LZ4 frame: unknown magic number.");
+
+			complete = false;
+			return true;
+		}
+		case STATE_SKIP:
+		{
+			if (skipSize == 0)
+			{
+				if (available < 4)
+					return false;
+
+				skipSize = (uint64) readLE32(data) + 1;
+				pos += 4;
+				available -= 4;
+			}
+
+			// One extra byte is counted so a zero-length frame is distinguishable.
+			size_t n = (size_t) std::min<uint64>(skipSize - 1, available);
+			pos += n;
+			skipSize -= n;
+
+			if (skipSize > 1)
+				return false;
+
+			skipSize = 0;
+			state = STATE_MAGIC;
+			complete = true;
+			return true;
+		}
+		case STATE_HEADER:
+		{
+			if (available < 2)
+				return false;
+
+			flags = (unsigned char) data[0];
+			unsigned char bd = (unsigned char) data[1];
+
+			size_t headersize = 3;
+			if (flags & FLAG_CONTENT_SIZE)
+				headersize += 8;
+			if (flags & FLAG_DICTIONARY_ID)
+				headersize += 4;
+
+			if (available < headersize)
+				return false;
+
+			if ((flags >> 6) != 1)
+				throw love::Exception("Invalid LZ4 frame: unsupported version.");
+			if ((flags & 0x02) != 0 || (bd & 0x8F) != 0)
+				throw love::Exception("Invalid LZ4 frame: reserved bits are set.");
+			if (flags & FLAG_DICTIONARY_ID)
+				throw love::Exception("LZ4 frames which use a dictionary are not supported.");
+
+			unsigned char hc = (unsigned char) ((XXH32(data, headersize - 1, 0) >> 8) & 0xFF);
+			if (hc != (unsigned char) data[headersize - 1])
+				throw love::Exception("Invalid LZ4 frame: header checksum mismatch.");
+
+			int blocksizeid = (bd >> 4) & 0x7;
+			if (blocksizeid < 4)
+				throw love::Exception("Invalid LZ4 frame: unknown block size.");
+
+			blockMaxSize = (size_t) 1 << (8 + 2 * blocksizeid);
+
+			contentSize = 0;
+			if (flags & FLAG_CONTENT_SIZE)
+			{
+				contentSize = (uint64) readLE32(data + 2) | ((uint64) readLE32(data + 6) << 32);
+			}
+
+			frameOutputSize = 0;
+			history.clear();
+			XXH32_reset(checksum, 0);
+
+			pos += headersize;
+			state = STATE_BLOCK;
+			return true;
+		}
+		case STATE_BLOCK:
+		{
+			if (available < 4)
+				return false;
+
+			uint32 header = readLE32(data);
+
+			if (header == 0)
+			{
+				pos += 4;
+
+				if (flags & FLAG_CONTENT_CHECKSUM)
+					state = STATE_CHECKSUM;
+				else
+					endFrame();
+
+				return true;
+			}
+
+			size_t blocksize = header & 0x7FFFFFFF;
+			bool uncompressed = (header & 0x80000000) != 0;
+
+			if (blocksize > blockMaxSize)
+				throw love::Exception("Invalid LZ4 frame: block is too large.");
+
+			size_t totalsize = 4 + blocksize + ((flags & FLAG_BLOCK_CHECKSUM) ? 4 : 0);
+			if (available < totalsize)
+				return false;
+
+			const char *block = data + 4;
+
+			if ((flags & FLAG_BLOCK_CHECKSUM) && XXH32(block, blocksize, 0) != readLE32(block + blocksize))
+				throw love::Exception("Invalid LZ4 frame: block checksum mismatch.");
+
+			std::vector<char> &dst = room >= (uncompressed ? blocksize : blockMaxSize) ? out : decoded;
+			size_t start = dst.size();
+
+			if (uncompressed)
+				dst.insert(dst.end(), block, block + blocksize);
+			else
+			{
+				dst.resize(start + blockMaxSize);
+
+				int result = 0;
+				if (flags & FLAG_INDEPENDENT_BLOCKS)
+					result = LZ4_decompress_safe(block, &dst[start], (int) blocksize, (int) blockMaxSize);
+				else
+					result = LZ4_decompress_safe_usingDict(block, &dst[start], (int) blocksize, (int) blockMaxSize, history.data(), (int) history.size());
+
+				if (result < 0)
+					throw love::Exception("Could not decompress LZ4-compressed data.");
+
+				dst.resize(start + result);
+			}
+
+			size_t outsize = dst.size() - start;
+
+			if (flags & FLAG_CONTENT_CHECKSUM)
+				XXH32_update(checksum, &dst[start], outsize);
+
+			// Linked blocks can refer back to the last 64 KB of output.
+			if (!(flags & FLAG_INDEPENDENT_BLOCKS))
+			{
+				if (outsize >= HISTORY_SIZE)
+					history.assign(dst.end() - HISTORY_SIZE, dst.end());
+				else
+				{
+					size_t keep = std::min(history.size(), HISTORY_SIZE - outsize);
+					history.erase(history.begin(), history.end() - keep);
+					history.insert(history.end(), dst.begin() + start, dst.end());
+				}
+			}
+
+			frameOutputSize += outsize;
+			pos += totalsize;
+			return true;
+		}
+		case STATE_CHECKSUM:
+		{
+			if (available < 4)
+				return false;
+
+			if (XXH32_digest(checksum) != readLE32(data))
+				throw love::Exception("Invalid LZ4 frame: content checksum mismatch.");
+
+			pos += 4;
+			endFrame();
+			return true;
+		}
+		}
+
+		return false;
+	}
+
+	void endFrame()
+	{
+		if ((flags & FLAG_CONTENT_SIZE) && frameOutputSize != contentSize)
+			throw love::Exception("Invalid LZ4 frame: content size mismatch.");
+
+		state = STATE_MAGIC;
+		complete = true;
+	}
+
+	State state;
+
+	XXH32_state_t *checksum;
+
+	std::vector<char> pending;
+	std::vector<char> history;
+
+	unsigned char flags;
+	size_t blockMaxSize;
+
+	uint64 contentSize;
+	uint64 frameOutputSize;
+
+	uint64 skipSize;
+
+	// A decoded block, and how much of it has been handed out.
+	std::vector<char> decoded;
+	size_t decodedPos;
+
+}; // LZ4FrameDecompressionStream
+
+love::Type DecompressionStream::type("DecompressionStream", &Object::type);
+
+DecompressionStream *DecompressionStream::create(Compressor::Format format)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_ZLIB:
+	case Compressor::FORMAT_GZIP:
+	case Compressor::FORMAT_DEFLATE:
+		return new zlibDecompressionStream(format);
+	case Compressor::FORMAT_LZ4_FRAME:
+		return new LZ4FrameDecompressionStream();
+	case Compressor::FORMAT_LZ4:
+		throw love::Exception("The lz4 format can't be streamed. Use lz4frame instead.");
+	default:
+		throw love::Exception("Invalid compression format.");
+	}
+}
+
+DecompressionStream::DecompressionStream(Compressor::Format format)
+	: complete(false)
+	, outputPending(false)
+	, format(format)
+	, finished(false)
+	, inputSize(0)
+	, outputSize(0)
+{
+}
+
+DecompressionStream::~DecompressionStream()
+{
+}
+
+Compressor::Format DecompressionStream::getFormat() const
+{
+	return format;
+}
+
+void DecompressionStream::update(const char *data, size_t size, std::vector<char> &out, size_t maxOutput)
+{
+	if (finished)
+		throw love::Exception("Cannot decompress more data after the stream has been finished.");
+
+	size_t start = out.size();
+	decompress(data, size, maxOutput, out);
+
+	inputSize += size;
+	outputSize += out.size() - start;
+}
+
+bool DecompressionStream::hasPendingOutput() const
+{
+	return outputPending;
+}
+
+void DecompressionStream::finish()
+{
+	if (finished)
+		throw love::Exception("The decompression stream has already been finished.");
+
+	finished = true;
+
+	if (!complete)
+		throw love::Exception("Compressed data ends partway through a stream.");
+}
+
+bool DecompressionStream::isComplete() const
+{
+	return complete;
+}
+
+bool DecompressionStream::isFinished() const
+{
+	return finished;
+}
+
+uint64 DecompressionStream::getInputSize() const
+{
+	return inputSize;
+}
+
+uint64 DecompressionStream::getOutputSize() const
+{
+	return outputSize;
+}
+
+} // data
+} // love
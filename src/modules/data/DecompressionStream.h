@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/int.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+#include <limits>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Decompresses data incrementally, as it arrives.
+ **/
+class DecompressionStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	/**
+	 * Creates a stream which decompresses data in the given format. LOVE's own
+	 * LZ4 format can't be streamed.
+	 **/
+	static DecompressionStream *create(Compressor::Format format);
+
+	virtual ~DecompressionStream();
+
+	Compressor::Format getFormat() const;
+
+	/**
+	 * Decompresses more data, appending the output it produces to 'out'.
+	 * Incomplete blocks are held back until the rest arrives.
+	 *
+	 * At most maxOutput bytes are appended. If there's more, the input it
+	 * comes from is kept and hasPendingOutput returns true. Calling update
+	 * again (with or without more data) continues where it left off; such a
+	 * call can occasionally produce no output.
+	 **/
+	void update(const char *data, size_t size, std::vector<char> &out, size_t maxOutput = std::numeric_limits<size_t>::max());
+
+	/**
+	 * Gets whether the last update stopped at its output limit, with input
+	 * left which may produce more output.
+	 **/
+	bool hasPendingOutput() const;
+
+	/**
+	 * Ends the stream. Throws an exception if the compressed data so far
+	 * stops partway through.
+	 **/
+	void finish();
+
+	/**
+	 * Gets whether the data so far ends exactly at the end of a compressed
+	 * stream (or the last of several concatenated ones.)
+	 **/
+	bool isComplete() const;
+
+	bool isFinished() const;
+
+	uint64 getInputSize() const;
+	uint64 getOutputSize() const;
+
+protected:
+
+	DecompressionStream(Compressor::Format format);
+
+	virtual void decompress(const char *data, size_t size, size_t maxOutput, std::vector<char> &out) = 0;
+
+	// Set by implementations when the end of a compressed stream is reached.
+	bool complete;
+
+	// Set by implementations when they stop at the output limit.
+	bool outputPending;
+
+private:
+
+	Compressor::Format format;
+	bool finished;
+
+	uint64 inputSize;
+	uint64 outputSize;
+
+}; // DecompressionStream
+
+} // data
+} // love
@@ -20,6 +20,12 @@
 
 #include "HashFunction.h"
 
+#include "libraries/xxHash/xxhash.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+
 // FIXME: Probably trivial by having tole and tobe functions, which can be ifdeffed to being identity functions
 #ifdef LOVE_BIG_ENDIAN
 #	error Hashing not yet implemented for big endian
@@ -50,6 +56,95 @@ inline uint64 rightrot(uint64 x, uint8 amount)
 	return (x >> amount) | (x << (64 - amount));
 }
 
+inline uint32 readBE32(const uint8 *b)
+{
+	return ((uint32) b[0] << 24) | ((uint32) b[1] << 16) | ((uint32) b[2] << 8) | (uint32) b[3];
+}
+
+/**
+ * Splits input into the fixed-size blocks MD5, SHA-1 and SHA-2 work on, and
+ * applies the padding they share once the input has ended. Whole blocks are
+ * processed straight from the input, so only partial ones are copied.
+ **/
+template <size_t blockSize>
+class BlockState : public HashFunction::State
+{
+public:
+	BlockState()
+		: bufferUsed(0)
+		, totalLength(0)
+	{
+	}
+
+	void update(const char *input, uint64 length) override
+	{
+		const uint8 *in = (const uint8 *) input;
+		totalLength += length;
+
+		if (bufferUsed > 0)
+		{
+			size_t n = (size_t) std::min<uint64>(blockSize - bufferUsed, length);
+			memcpy(buffer + bufferUsed, in, n);
+
+			bufferUsed += n;
+			in += n;
+			length -= n;
+
+			if (bufferUsed < blockSize)
+				return;
+
+			processBlock(buffer);
+			bufferUsed = 0;
+		}
+
+		for (; length >= blockSize; length -= blockSize, in += blockSize)
+			processBlock(in);
+
+		memcpy(buffer, in, (size_t) length);
+		bufferUsed = (size_t) length;
+	}
+
+protected:
+	virtual void processBlock(const uint8 *block) = 0;
+
+	/**
+	 * Appends the 0x80 byte, zeroes, and the input length in bits, which fills
+	 * the last lengthSize bytes of the final block.
+	 **/
+	void pad(size_t lengthSize, bool bigEndian)
+	{
+		uint64 bits = totalLength * 8;
+
+		buffer[bufferUsed++] = 0x80;
+
+		if (bufferUsed > blockSize - lengthSize)
+		{
+			memset(buffer + bufferUsed, 0, blockSize - bufferUsed);
+			processBlock(buffer);
+			bufferUsed = 0;
+		}
+
+		memset(buffer + bufferUsed, 0, blockSize - bufferUsed);
+
+		for (int i = 0; i < 8; i++)
+		{
+			uint8 b = (uint8) ((bits >> (i * 8)) & 0xFF);
+			if (bigEndian)
+				buffer[blockSize - 1 - i] = b;
+			else
+				buffer[blockSize - 8 + i] = b;
+		}
+
+		processBlock(buffer);
+		bufferUsed = 0;
+	}
+
+private:
+	uint8 buffer[blockSize];
+	size_t bufferUsed;
+	uint64 totalLength;
+};
+
 /**
  * The following implementation is based on the pseudocode provided by multiple
  * authors on wikipedia: https://en.wikipedia.org/wiki/MD5
@@ -63,41 +158,33 @@ private:
 	static const uint8 shifts[64];
 	static const uint32 constants[64];
 
-public:
-	bool isSupported(Function function) const override
+	class Context : public BlockState<64>
 	{
-		return function == FUNCTION_MD5;
-	}
-
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
-	{
-		if (function != FUNCTION_MD5)
-			throw love::Exception("Hash function not supported by MD5 implementation");
-
-		uint32 a0 = 0x67452301;
-		uint32 b0 = 0xefcdab89;
-		uint32 c0 = 0x98badcfe;
-		uint32 d0 = 0x10325476;
-
-		//Do the required padding (MD5, SHA1 and SHA2 use the same padding)
-		uint64 paddedLength = length + 1; //Consider the appended bit
-		if (paddedLength % 64 < 56)
-			paddedLength += 56 - paddedLength % 64;
-		if (paddedLength % 64 > 56)
-			paddedLength += 120 - paddedLength % 64;
+	public:
+		Context()
+			: a0(0x67452301)
+			, b0(0xefcdab89)
+			, c0(0x98badcfe)
+			, d0(0x10325476)
+		{
+		}
 
-		uint8 *padded = new uint8[paddedLength + 8];
-		memcpy(padded, input, length);
-		memset(padded + length, 0, paddedLength - length);
-		padded[length] = 0x80;
+		void finish(Value &output) override
+		{
+			pad(8, false);
 
-		//Now we need the length in bits
-		*((uint64*) &padded[paddedLength]) = length * 8;
-		paddedLength += 8;
+			memcpy(&output.data[ 0], &a0, 4);
+			memcpy(&output.data[ 4], &b0, 4);
+			memcpy(&output.data[ 8], &c0, 4);
+			memcpy(&output.data[12], &d0, 4);
+			output.size = 16;
+		}
 
-		for (uint64 i = 0; i < paddedLength; i += 64)
+	protected:
+		void processBlock(const uint8 *block) override
 		{
-			uint32 *chunk = (uint32*) &padded[i];
+			uint32 chunk[16];
+			memcpy(chunk, block, sizeof(chunk));
 
 			uint32 A = a0;
 			uint32 B = b0;
@@ -142,13 +229,32 @@ public:
 			d0 += D;
 		}
 
-		delete[] padded;
+	private:
+		uint32 a0, b0, c0, d0;
+	};
 
-		memcpy(&output.data[ 0], &a0, 4);
-		memcpy(&output.data[ 4], &b0, 4);
-		memcpy(&output.data[ 8], &c0, 4);
-		memcpy(&output.data[12], &d0, 4);
-		output.size = 16;
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_MD5;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function != FUNCTION_MD5)
+			throw love::Exception("Hash function not supported by MD5 implementation");
+
+		Context context;
+		context.update(input, length);
+		context.finish(output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function != FUNCTION_MD5)
+			throw love::Exception("Hash function not supported by MD5 implementation");
+
+		return new Context();
 	}
 } md5;
 
@@ -185,52 +291,38 @@ const uint32 MD5::constants[64] = {
  **/
 class SHA1 : public HashFunction
 {
-public:
-	bool isSupported(Function function) const override
-	{
-		return function == FUNCTION_SHA1;
-	}
-
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+private:
+	class Context : public BlockState<64>
 	{
-		if (function != FUNCTION_SHA1)
-			throw love::Exception("Hash function not supported by SHA1 implementation");
-
-		uint32 intermediate[5] = {
-			0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
-		};
-
-		//Do the required padding (MD5, SHA1 and SHA2 use the same padding)
-		uint64 paddedLength = length + 1; //Consider the appended bit
-		if (paddedLength % 64 < 56)
-			paddedLength += 56 - paddedLength % 64;
-		if (paddedLength % 64 > 56)
-			paddedLength += 120 - paddedLength % 64;
+	public:
+		Context()
+			: intermediate{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0}
+		{
+		}
 
-		uint8 *padded = new uint8[paddedLength + 8];
-		memcpy(padded, input, length);
-		memset(padded + length, 0, paddedLength - length);
-		padded[length] = 0x80;
+		void finish(Value &output) override
+		{
+			pad(8, true);
 
-		// Now we need the length in bits (big endian)
-		length *= 8;
-		for (int i = 0; i < 8; ++i, ++paddedLength)
-			padded[paddedLength] = (length >> (56 - i * 8)) & 0xFF;
+			for (int i = 0; i < 20; i += 4)
+			{
+				output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
+				output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
+				output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
+				output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
+			}
 
-		// Allocate our extended words
-		uint32 words[80];
+			output.size = 20;
+		}
 
-		for (uint64 i = 0; i < paddedLength; i += 64)
+	protected:
+		void processBlock(const uint8 *block) override
 		{
-			uint32 *chunk = (uint32*) &padded[i];
+			// Allocate our extended words
+			uint32 words[80];
+
 			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = readBE32(block + j * 4);
 			for (int j = 16; j < 80; j++)
 				words[j] = leftrot(words[j-3] ^ words[j-8] ^ words[j-14] ^ words[j-16], 1);
 
@@ -267,17 +359,32 @@ public:
 			intermediate[4] += E;
 		}
 
-		delete[] padded;
+	private:
+		uint32 intermediate[5];
+	};
 
-		for (int i = 0; i < 20; i += 4)
-		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
-		}
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA1;
+	}
 
-		output.size = 20;
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function != FUNCTION_SHA1)
+			throw love::Exception("Hash function not supported by SHA1 implementation");
+
+		Context context;
+		context.update(input, length);
+		context.finish(output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function != FUNCTION_SHA1)
+			throw love::Exception("Hash function not supported by SHA1 implementation");
+
+		return new Context();
 	}
 } sha1;
 
@@ -292,54 +399,41 @@ private:
 	static const uint32 initial256[8];
 	static const uint32 constants[64];
 
-public:
-	bool isSupported(Function function) const override
-	{
-		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
-	}
-
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	class Context : public BlockState<64>
 	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
-
-		//Do the required padding (MD5, SHA1 and SHA2 use the same padding)
-		uint64 paddedLength = length + 1; //Consider the appended bit
-		if (paddedLength % 64 < 56)
-			paddedLength += 56 - paddedLength % 64;
-		if (paddedLength % 64 > 56)
-			paddedLength += 120 - paddedLength % 64;
-
-		uint8 *padded = new uint8[paddedLength + 8];
-		memcpy(padded, input, length);
-		memset(padded + length, 0, paddedLength - length);
-		padded[length] = 0x80;
+	public:
+		Context(Function function)
+			: hashlength(function == FUNCTION_SHA224 ? 28 : 32)
+		{
+			if (function == FUNCTION_SHA224)
+				memcpy(intermediate, initial224, sizeof(intermediate));
+			else
+				memcpy(intermediate, initial256, sizeof(intermediate));
+		}
 
-		// Now we need the length in bits (big endian)
-		length *= 8;
-		for (int i = 0; i < 8; ++i, ++paddedLength)
-			padded[paddedLength] = (length >> (56 - i * 8)) & 0xFF;
+		void finish(Value &output) override
+		{
+			pad(8, true);
 
-		uint32 intermediate[8];
-		if (function == FUNCTION_SHA224)
-			memcpy(intermediate, initial224, sizeof(intermediate));
-		else
-			memcpy(intermediate, initial256, sizeof(intermediate));
+			for (int i = 0; i < hashlength; i += 4)
+			{
+				output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
+				output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
+				output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
+				output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
+			}
 
-		// Allocate our extended words
-		uint32 words[64];
+			output.size = hashlength;
+		}
 
-		for (uint64 i = 0; i < paddedLength; i += 64)
+	protected:
+		void processBlock(const uint8 *block) override
 		{
-			uint32 *chunk = (uint32*) &padded[i];
+			// Allocate our extended words
+			uint32 words[64];
+
 			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = readBE32(block + j * 4);
 			for (int j = 16; j < 64; j++)
 			{
 				words[j] = rightrot(words[j-2], 17) ^ rightrot(words[j-2], 19) ^ (words[j-2] >> 10);
@@ -384,21 +478,33 @@ public:
 			intermediate[7] += H;
 		}
 
-		delete[] padded;
+	private:
+		uint32 intermediate[8];
+		int hashlength;
+	};
 
-		int hashlength = 32;
-		if (function == FUNCTION_SHA224)
-			hashlength = 28;
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
+	}
 
-		for (int i = 0; i < hashlength; i += 4)
-		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
-		}
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
 
-		output.size = hashlength;
+		Context context(function);
+		context.update(input, length);
+		context.finish(output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
+
+		return new Context(function);
 	}
 } sha256;
 
@@ -442,60 +548,47 @@ private:
 	static const uint64 initial512[8];
 	static const uint64 constants[80];
 
-public:
-	bool isSupported(Function function) const override
+	class Context : public BlockState<128>
 	{
-		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
-	}
-
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
-	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
+	public:
+		Context(Function function)
+			: hashlength(function == FUNCTION_SHA384 ? 48 : 64)
+		{
+			if (function == FUNCTION_SHA384)
+				memcpy(intermediates, initial384, sizeof(intermediates));
+			else
+				memcpy(intermediates, initial512, sizeof(intermediates));
+		}
 
-		uint64 intermediates[8];
-		if (function == FUNCTION_SHA384)
-			memcpy(intermediates, initial384, sizeof(intermediates));
-		else
-			memcpy(intermediates, initial512, sizeof(intermediates));
-
-		//Do the required padding
-		uint64 paddedLength = length + 1; //Consider the appended bit
-		if (paddedLength % 128 < 112)
-			paddedLength += 112 - paddedLength % 128;
-		if (paddedLength % 128 > 112)
-			paddedLength += 240 - paddedLength % 128;
-
-		uint8 *padded = new uint8[paddedLength + 16];
-		paddedLength += 8;
-		memcpy(padded, input, length);
-		memset(padded + length, 0, paddedLength - length);
-		padded[length] = 0x80;
-
-		// Now we need the length in bits (big endian), note we only write a 64-bit int, so
-		// we have filled the first 8 bytes with zeroes
-		length *= 8;
-		for (int i = 0; i < 8; ++i, ++paddedLength)
-			padded[paddedLength] = (length >> (56 - i * 8)) & 0xFF;
-
-		// Allocate our extended words
-		uint64 words[80];
-
-		for (uint64 i = 0; i < paddedLength; i += 128)
+		void finish(Value &output) override
 		{
-			uint64 *chunk = (uint64*) &padded[i];
-			for (int j = 0; j < 16; ++j)
+			// The length is stored as a 128-bit int, but we only write the low
+			// 64 bits (the high bytes are left as zeroes.)
+			pad(16, true);
+
+			for (int i = 0; i < hashlength; i += 8)
 			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 56) & 0xFF;
-				c[1] = (chunk[j] >> 48) & 0xFF;
-				c[2] = (chunk[j] >> 40) & 0xFF;
-				c[3] = (chunk[j] >> 32) & 0xFF;
-				c[4] = (chunk[j] >> 24) & 0xFF;
-				c[5] = (chunk[j] >> 16) & 0xFF;
-				c[6] = (chunk[j] >>  8) & 0xFF;
-				c[7] = (chunk[j] >>  0) & 0xFF;
+				output.data[i+0] = (intermediates[i/8] >> 56) & 0xFF;
+				output.data[i+1] = (intermediates[i/8] >> 48) & 0xFF;
+				output.data[i+2] = (intermediates[i/8] >> 40) & 0xFF;
+				output.data[i+3] = (intermediates[i/8] >> 32) & 0xFF;
+				output.data[i+4] = (intermediates[i/8] >> 24) & 0xFF;
+				output.data[i+5] = (intermediates[i/8] >> 16) & 0xFF;
+				output.data[i+6] = (intermediates[i/8] >>  8) & 0xFF;
+				output.data[i+7] = (intermediates[i/8] >>  0) & 0xFF;
 			}
+
+			output.size = hashlength;
+		}
+
+	protected:
+		void processBlock(const uint8 *block) override
+		{
+			// Allocate our extended words
+			uint64 words[80];
+
+			for (int j = 0; j < 16; ++j)
+				words[j] = ((uint64) readBE32(block + j * 8) << 32) | readBE32(block + j * 8 + 4);
 			for (int j = 16; j < 80; ++j)
 			{
 				words[j] = words[j-7] + words[j-16];
@@ -539,25 +632,33 @@ public:
 			intermediates[7] += H;
 		}
 
-		delete[] padded;
+	private:
+		uint64 intermediates[8];
+		int hashlength;
+	};
 
-		int hashlength = 64;
-		if (function == FUNCTION_SHA384)
-			hashlength = 48;
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
+	}
 
-		for (int i = 0; i < hashlength; i += 8)
-		{
-			output.data[i+0] = (intermediates[i/8] >> 56) & 0xFF;
-			output.data[i+1] = (intermediates[i/8] >> 48) & 0xFF;
-			output.data[i+2] = (intermediates[i/8] >> 40) & 0xFF;
-			output.data[i+3] = (intermediates[i/8] >> 32) & 0xFF;
-			output.data[i+4] = (intermediates[i/8] >> 24) & 0xFF;
-			output.data[i+5] = (intermediates[i/8] >> 16) & 0xFF;
-			output.data[i+6] = (intermediates[i/8] >>  8) & 0xFF;
-			output.data[i+7] = (intermediates[i/8] >>  0) & 0xFF;
-		}
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
 
-		output.size = hashlength;
+		Context context(function);
+		context.update(input, length);
+		context.finish(output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
+
+		return new Context(function);
 	}
 } sha512;
 
@@ -594,6 +695,108 @@ const uint64 SHA512::constants[80] = {
 	0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
 };
 
+/**
+ * xxHash is a fast non-cryptographic hash, for checksums and cache keys rather
+ * than anything which needs to resist tampering. Results are stored as big
+ * endian bytes (xxHash's canonical representation.)
+ **/
+class XXHash : public HashFunction
+{
+private:
+	class Context : public HashFunction::State
+	{
+	public:
+		Context(Function function)
+			: state32(nullptr)
+			, state64(nullptr)
+		{
+			if (function == FUNCTION_XXHASH32)
+			{
+				state32 = XXH32_createState();
+				if (state32 == nullptr)
+					throw love::Exception("Out of memory.");
+				XXH32_reset(state32, 0);
+			}
+			else
+			{
+				state64 = XXH64_createState();
+				if (state64 == nullptr)
+					throw love::Exception("Out of memory.");
+				XXH64_reset(state64, 0);
+			}
+		}
+
+		virtual ~Context()
+		{
+			if (state32 != nullptr)
+				XXH32_freeState(state32);
+			if (state64 != nullptr)
+				XXH64_freeState(state64);
+		}
+
+		void update(const char *input, uint64 length) override
+		{
+			if (state32 != nullptr)
+				XXH32_update(state32, input, (size_t) length);
+			else
+				XXH64_update(state64, input, (size_t) length);
+		}
+
+		void finish(Value &output) override
+		{
+			if (state32 != nullptr)
+				store32(XXH32_digest(state32), output);
+			else
+				store64(XXH64_digest(state64), output);
+		}
+
+	private:
+		XXH32_state_t *state32;
+		XXH64_state_t *state64;
+	};
+
+	static void store32(XXH32_hash_t hash, Value &output)
+	{
+		XXH32_canonical_t canonical;
+		XXH32_canonicalFromHash(&canonical, hash);
+		memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+		output.size = sizeof(canonical.digest);
+	}
+
+	static void store64(XXH64_hash_t hash, Value &output)
+	{
+		XXH64_canonical_t canonical;
+		XXH64_canonicalFromHash(&canonical, hash);
+		memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+		output.size = sizeof(canonical.digest);
+	}
+
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_XXHASH32 || function == FUNCTION_XXHASH64;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by xxHash implementation");
+
+		if (function == FUNCTION_XXHASH32)
+			store32(XXH32(input, (size_t) length, 0), output);
+		else
+			store64(XXH64(input, (size_t) length, 0), output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by xxHash implementation");
+
+		return new Context(function);
+	}
+} xxhash;
+
 } // impl
 }
 
@@ -611,6 +814,9 @@ HashFunction *HashFunction::getHashFunction(Function function)
 	case FUNCTION_SHA384:
 	case FUNCTION_SHA512:
 		return &impl::sha512;
+	case FUNCTION_XXHASH32:
+	case FUNCTION_XXHASH64:
+		return &impl::xxhash;
 	case FUNCTION_MAX_ENUM:
 		return nullptr;
 	// No default for compiler warnings
@@ -640,6 +846,8 @@ StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM>::Entry HashFu
 	{"sha256", FUNCTION_SHA256},
 	{"sha384", FUNCTION_SHA384},
 	{"sha512", FUNCTION_SHA512},
+	{"xxhash32", FUNCTION_XXHASH32},
+	{"xxhash64", FUNCTION_XXHASH64},
 };
 
 StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM> HashFunction::functionNames(HashFunction::functionEntries, sizeof(HashFunction::functionEntries));
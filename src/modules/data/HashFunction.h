@@ -42,6 +42,8 @@ public:
 		FUNCTION_SHA256,
 		FUNCTION_SHA384,
 		FUNCTION_SHA512,
+		FUNCTION_XXHASH32,
+		FUNCTION_XXHASH64,
 		FUNCTION_MAX_ENUM
 	};
 
@@ -51,6 +53,19 @@ public:
 		size_t size;
 	};
 
+	/**
+	 * The progress of a hash which is computed from input given in several
+	 * pieces.
+	 **/
+	class State
+	{
+	public:
+		virtual ~State() {}
+
+		virtual void update(const char *input, uint64 length) = 0;
+		virtual void finish(Value &output) = 0;
+	};
+
 	/**
 	 * Get a HashFunction instance for the given function.
 	 *
@@ -72,6 +87,14 @@ public:
 	 **/
 	virtual void hash(Function function, const char *input, uint64 length, Value &output) const = 0;
 
+	/**
+	 * Creates the state for hashing input which is given in several pieces.
+	 *
+	 * @param[in] function The selected hash function.
+	 * @return The new state (allocated with new.)
+	 **/
+	virtual State *newState(Function function) const = 0;
+
 	/**
 	 * @param[in] function The requested hash function.
 	 * @return Whether this HashFunction instance implements the given function.
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/int.h"
+#include "HashFunction.h"
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Computes a hash from input given in several pieces, without needing all of
+ * it in memory at once.
+ **/
+class Hasher : public Object
+{
+public:
+
+	static love::Type type;
+
+	Hasher(HashFunction::Function function);
+	virtual ~Hasher();
+
+	HashFunction::Function getFunction() const;
+
+	/**
+	 * Adds more input to the hash.
+	 **/
+	void update(const char *data, uint64 size);
+
+	/**
+	 * Gets the hash of all of the input given so far. No more input can be
+	 * added afterwards.
+	 **/
+	void finish(HashFunction::Value &output);
+
+	bool isFinished() const;
+
+	uint64 getInputSize() const;
+
+private:
+
+	HashFunction::Function function;
+	HashFunction::State *state;
+	bool finished;
+
+	uint64 inputSize;
+
+}; // Hasher
+
+} // data
+} // love
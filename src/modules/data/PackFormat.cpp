@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "PackFormat.h"
+
+namespace love
+{
+namespace data
+{
+
+love::Type PackFormat::type("PackFormat", &Object::type);
+
+PackFormat::PackFormat(const std::string &format, const std::vector<lua53_PackOption> &options)
+	: format(format)
+	, options(options)
+	, fixedSize(false)
+	, size(0)
+{
+	fixedSize = lua53_str_compiledsize(options.data(), (int) options.size(), &size) != 0;
+}
+
+PackFormat::~PackFormat()
+{
+}
+
+const std::string &PackFormat::getFormat() const
+{
+	return format;
+}
+
+const lua53_PackOption *PackFormat::getOptions() const
+{
+	return options.data();
+}
+
+int PackFormat::getOptionCount() const
+{
+	return (int) options.size();
+}
+
+bool PackFormat::getSize(size_t &size) const
+{
+	size = this->size;
+	return fixedSize;
+}
+
+} // data
+} // love
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+
+// Lua 5.3
+#include "libraries/lua53/lstrlib.h"
+
+// C++
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * A love.data.pack format string which has been read ahead of time, so
+ * packing and unpacking with it doesn't need to parse the string again.
+ **/
+class PackFormat : public Object
+{
+public:
+
+	static love::Type type;
+
+	PackFormat(const std::string &format, const std::vector<lua53_PackOption> &options);
+	virtual ~PackFormat();
+
+	const std::string &getFormat() const;
+
+	const lua53_PackOption *getOptions() const;
+	int getOptionCount() const;
+
+	/**
+	 * Gets the size in bytes of the values packed with this format.
+	 * @return False if the size depends on the packed strings.
+	 **/
+	bool getSize(size_t &size) const;
+
+private:
+
+	std::string format;
+	std::vector<lua53_PackOption> options;
+
+	bool fixedSize;
+	size_t size;
+
+}; // PackFormat
+
+} // data
+} // love
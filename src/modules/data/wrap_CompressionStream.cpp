@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_CompressionStream.h"
+#include "wrap_Data.h"
+
+namespace love
+{
+namespace data
+{
+
+CompressionStream *luax_checkcompressionstream(lua_State *L, int idx)
+{
+	return luax_checktype<CompressionStream>(L, idx);
+}
+
+static const char *luax_checkstreaminput(lua_State *L, int idx, size_t &size)
+{
+	if (lua_isstring(L, idx))
+		return luaL_checklstring(L, idx, &size);
+
+	Data *data = luax_checktype<Data>(L, idx);
+	size = data->getSize();
+	return (const char *) data->getData();
+}
+
+static void luax_pushstreamoutput(lua_State *L, const std::vector<char> &out)
+{
+	if (out.empty())
+		lua_pushliteral(L, "");
+	else
+		lua_pushlstring(L, out.data(), out.size());
+}
+
+int w_CompressionStream_update(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	size_t size = 0;
+	const char *data = luax_checkstreaminput(L, 2, size);
+
+	std::vector<char> out;
+	luax_catchexcept(L, [&](){ t->update(data, size, out); });
+
+	luax_pushstreamoutput(L, out);
+	return 1;
+}
+
+int w_CompressionStream_flush(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	std::vector<char> out;
+	luax_catchexcept(L, [&](){ t->flush(out); });
+
+	luax_pushstreamoutput(L, out);
+	return 1;
+}
+
+int w_CompressionStream_finish(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	size_t size = 0;
+	const char *data = nullptr;
+
+	if (!lua_isnoneornil(L, 2))
+		data = luax_checkstreaminput(L, 2, size);
+
+	std::vector<char> out;
+	luax_catchexcept(L, [&]()
+	{
+		if (data != nullptr)
+			t->update(data, size, out);
+		t->finish(out);
+	});
+
+	luax_pushstreamoutput(L, out);
+	return 1;
+}
+
+int w_CompressionStream_isFinished(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+	luax_pushboolean(L, t->isFinished());
+	return 1;
+}
+
+int w_CompressionStream_getFormat(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	const char *fname = nullptr;
+	if (!Compressor::getConstant(t->getFormat(), fname))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(Compressor::FORMAT_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+int w_CompressionStream_getSizes(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+	lua_pushnumber(L, (lua_Number) t->getInputSize());
+	lua_pushnumber(L, (lua_Number) t->getOutputSize());
+	return 2;
+}
+
+static const luaL_Reg w_CompressionStream_functions[] =
+{
+	{ "update", w_CompressionStream_update },
+	{ "flush", w_CompressionStream_flush },
+	{ "finish", w_CompressionStream_finish },
+	{ "isFinished", w_CompressionStream_isFinished },
+	{ "getFormat", w_CompressionStream_getFormat },
+	{ "getSizes", w_CompressionStream_getSizes },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_compressionstream(lua_State *L)
+{
+	return luax_register_type(L, &CompressionStream::type, w_CompressionStream_functions, nullptr);
+}
+
+} // data
+} // love
@@ -24,8 +24,14 @@
 #include "wrap_ByteData.h"
 #include "wrap_DataView.h"
 #include "wrap_CompressedData.h"
+#include "wrap_CompressionStream.h"
+#include "wrap_DecompressionStream.h"
+#include "wrap_Hasher.h"
+#include "wrap_PackFormat.h"
 #include "DataModule.h"
+#include "BlockContainer.h"
 #include "common/b64.h"
+#include "thread/threads.h"
 
 // Lua 5.3
 #include "libraries/lua53/lstrlib.h"
@@ -35,6 +41,7 @@
 #include <iostream>
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace love
 {
@@ -136,8 +143,30 @@ int w_compress(lua_State *L)
 		rawbytes = (const char *) rawdata->getData();
 	}
 
+	bool parallel = false;
+	lua_Integer blocksize = (lua_Integer) BlockContainer::DEFAULT_BLOCK_SIZE;
+	int threadcount = love::thread::getProcessorCount();
+
+	if (!lua_isnoneornil(L, 5))
+	{
+		luaL_checktype(L, 5, LUA_TTABLE);
+
+		parallel = luax_boolflag(L, 5, "parallel", parallel);
+		blocksize = (lua_Integer) luax_numberflag(L, 5, "blocksize", (double) blocksize);
+		threadcount = luax_intflag(L, 5, "threads", threadcount);
+
+		if (blocksize <= 0)
+			return luaL_error(L, "Block size must be greater than 0.");
+	}
+
 	CompressedData *cdata = nullptr;
-	luax_catchexcept(L, [&](){ cdata = compress(format, rawbytes, rawsize, level); });
+	luax_catchexcept(L, [&]()
+	{
+		if (parallel)
+			cdata = compress(format, rawbytes, rawsize, level, (size_t) blocksize, threadcount);
+		else
+			cdata = compress(format, rawbytes, rawsize, level);
+	});
 
 	if (ctype == CONTAINER_DATA)
 		luax_pushtype(L, cdata);
@@ -158,8 +187,23 @@ int w_decompress(lua_State *L)
 	if (luax_istype(L, 2, CompressedData::type))
 	{
 		CompressedData *data = luax_checkcompresseddata(L, 2);
-		rawsize = data->getDecompressedSize();
-		luax_catchexcept(L, [&](){ rawbytes = decompress(data, rawsize); });
+
+		if (!lua_isnoneornil(L, 3))
+		{
+			lua_Integer offset = luaL_checkinteger(L, 3);
+			lua_Integer size = luaL_checkinteger(L, 4);
+
+			if (offset < 0 || size < 0)
+				return luaL_error(L, "Offset and size must not be negative.");
+
+			rawsize = (size_t) size;
+			luax_catchexcept(L, [&](){ rawbytes = decompressRange(data->getFormat(), (const char *) data->getData(), data->getSize(), (size_t) offset, rawsize); });
+		}
+		else
+		{
+			rawsize = data->getDecompressedSize();
+			luax_catchexcept(L, [&](){ rawbytes = decompress(data, rawsize); });
+		}
 	}
 	else
 	{
@@ -181,7 +225,19 @@ int w_decompress(lua_State *L)
 		else
 			cbytes = luaL_checklstring(L, 3, &compressedsize);
 
-		luax_catchexcept(L, [&](){ rawbytes = decompress(format, cbytes, compressedsize, rawsize); });
+		if (!lua_isnoneornil(L, 4))
+		{
+			lua_Integer offset = luaL_checkinteger(L, 4);
+			lua_Integer size = luaL_checkinteger(L, 5);
+
+			if (offset < 0 || size < 0)
+				return luaL_error(L, "Offset and size must not be negative.");
+
+			rawsize = (size_t) size;
+			luax_catchexcept(L, [&](){ rawbytes = decompressRange(format, cbytes, compressedsize, (size_t) offset, rawsize); });
+		}
+		else
+			luax_catchexcept(L, [&](){ rawbytes = decompress(format, cbytes, compressedsize, rawsize); });
 	}
 
 	if (ctype == CONTAINER_DATA)
@@ -200,6 +256,38 @@ int w_decompress(lua_State *L)
 	return 1;
 }
 
+int w_newCompressor(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	Compressor::Format format = Compressor::FORMAT_LZ4;
+
+	if (!Compressor::getConstant(fstr, format))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+	int level = (int) luaL_optinteger(L, 2, -1);
+
+	CompressionStream *stream = nullptr;
+	luax_catchexcept(L, [&](){ stream = instance()->newCompressionStream(format, level); });
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
+int w_newDecompressor(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	Compressor::Format format = Compressor::FORMAT_LZ4;
+
+	if (!Compressor::getConstant(fstr, format))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+	DecompressionStream *stream = nullptr;
+	luax_catchexcept(L, [&](){ stream = instance()->newDecompressionStream(format); });
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
 int w_encode(lua_State *L)
 {
 	ContainerType ctype = luax_checkcontainertype(L, 1);
@@ -300,6 +388,39 @@ int w_decode(lua_State *L)
 	return 1;
 }
 
+int w_decodeInto(lua_State *L)
+{
+	Data *dst = luax_checkdata(L, 1);
+	lua_Integer offset = luaL_checkinteger(L, 2);
+
+	const char *formatstr = luaL_checkstring(L, 3);
+	EncodeFormat format;
+	if (!getConstant(formatstr, format))
+		return luax_enumerror(L, "decode format", getConstants(format), formatstr);
+
+	size_t srclen = 0;
+	const char *src = nullptr;
+
+	if (luax_istype(L, 4, Data::type))
+	{
+		Data *data = luax_totype<Data>(L, 4);
+		src = (const char *) data->getData();
+		srclen = data->getSize();
+	}
+	else
+		src = luaL_checklstring(L, 4, &srclen);
+
+	if (offset < 0 || (size_t) offset > dst->getSize())
+		return luaL_error(L, "Invalid offset into the destination Data: %d", (int) offset);
+
+	char *dstbytes = (char *) dst->getData() + offset;
+	size_t dstlen = 0;
+	luax_catchexcept(L, [&](){ dstlen = decode(format, src, srclen, dstbytes, dst->getSize() - (size_t) offset); });
+
+	lua_pushinteger(L, (lua_Integer) dstlen);
+	return 1;
+}
+
 int w_hash(lua_State *L)
 {
 	const char *fstr = luaL_checkstring(L, 1);
@@ -324,46 +445,49 @@ int w_hash(lua_State *L)
 	return 1;
 }
 
-int w_pack(lua_State *L)
+int w_newHasher(lua_State *L)
 {
-	ContainerType ctype = luax_checkcontainertype(L, 1);
-	const char *fmt = luaL_checkstring(L, 2);
-	luaL_Buffer_53 b;
-	lua53_str_pack(L, fmt, 3, &b);
+	const char *fstr = luaL_checkstring(L, 1);
+	HashFunction::Function function;
+	if (!HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(function), fstr);
 
-	if (ctype == CONTAINER_DATA)
-	{
-		Data *d = nullptr;
-		luax_catchexcept(L, [&]() { d = instance()->newByteData(b.nelems); });
-		memcpy(d->getData(), b.ptr, d->getSize());
+	Hasher *hasher = nullptr;
+	luax_catchexcept(L, [&](){ hasher = instance()->newHasher(function); });
+	luax_pushtype(L, hasher);
+	hasher->release();
+	return 1;
+}
 
-		lua53_cleanupbuffer(&b);
-		luax_pushtype(L, Data::type, d);
-		d->release();
-	}
-	else
-		lua53_pushresult(&b);
+int w_pack(lua_State *L)
+{
+	ContainerType ctype = luax_checkcontainertype(L, 1);
+	return luax_pack(L, ctype, 2, 3);
+}
 
-	return 1;
+int w_packInto(lua_State *L)
+{
+	return luax_packinto(L, 1, 2, 3, 4);
 }
 
 int w_unpack(lua_State *L)
 {
-	const char *fmt = luaL_checkstring(L, 1);
+	return luax_unpack(L, 1, 2, 3);
+}
 
-	const char *data = nullptr;
-	size_t datasize = 0;
+int w_newPackFormat(lua_State *L)
+{
+	const char *fmt = luaL_checkstring(L, 1);
 
-	if (luax_istype(L, 2, Data::type))
-	{
-		Data *d = luax_checkdata(L, 2);
-		data = (const char *) d->getData();
-		datasize = d->getSize();
-	}
-	else
-		data = luaL_checklstring(L, 2, &datasize);
+	int count = lua53_str_compile(L, fmt, nullptr);
+	std::vector<lua53_PackOption> options(count);
+	lua53_str_compile(L, fmt, options.data());
 
-	return lua53_str_unpack(L, fmt, data, datasize, 2, 3);
+	PackFormat *f = nullptr;
+	luax_catchexcept(L, [&](){ f = new PackFormat(fmt, options); });
+	luax_pushtype(L, f);
+	f->release();
+	return 1;
 }
 
 // List of functions to wrap.
@@ -373,12 +497,18 @@ static const luaL_Reg functions[] =
 	{ "newByteData", w_newByteData },
 	{ "compress", w_compress },
 	{ "decompress", w_decompress },
+	{ "newCompressor", w_newCompressor },
+	{ "newDecompressor", w_newDecompressor },
 	{ "encode", w_encode },
 	{ "decode", w_decode },
+	{ "decodeInto", w_decodeInto },
 	{ "hash", w_hash },
+	{ "newHasher", w_newHasher },
 
 	{ "pack", w_pack },
+	{ "packInto", w_packInto },
 	{ "unpack", w_unpack },
+	{ "newPackFormat", w_newPackFormat },
 	{ "getPackedSize", lua53_str_packsize },
 
 	{ 0, 0 }
@@ -390,6 +520,10 @@ static const lua_CFunction types[] =
 	luaopen_bytedata,
 	luaopen_dataview,
 	luaopen_compresseddata,
+	luaopen_compressionstream,
+	luaopen_decompressionstream,
+	luaopen_hasher,
+	luaopen_packformat,
 	nullptr
 };
 
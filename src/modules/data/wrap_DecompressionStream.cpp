@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_DecompressionStream.h"
+#include "wrap_Data.h"
+
+namespace love
+{
+namespace data
+{
+
+DecompressionStream *luax_checkdecompressionstream(lua_State *L, int idx)
+{
+	return luax_checktype<DecompressionStream>(L, idx);
+}
+
+int w_DecompressionStream_update(lua_State *L)
+{
+	DecompressionStream *t = luax_checkdecompressionstream(L, 1);
+
+	size_t size = 0;
+	const char *data = nullptr;
+
+	// No data continues output held back by a previous limit.
+	if (lua_isnoneornil(L, 2))
+		data = "";
+	else if (lua_isstring(L, 2))
+		data = luaL_checklstring(L, 2, &size);
+	else
+	{
+		Data *d = luax_checktype<Data>(L, 2);
+		size = d->getSize();
+		data = (const char *) d->getData();
+	}
+
+	size_t maxsize = std::numeric_limits<size_t>::max();
+	if (!lua_isnoneornil(L, 3))
+	{
+		lua_Number n = luaL_checknumber(L, 3);
+		if (n < 0)
+			return luaL_argerror(L, 3, "maximum output size cannot be negative");
+		if (n < (lua_Number) maxsize)
+			maxsize = (size_t) n;
+	}
+
+	std::vector<char> out;
+	luax_catchexcept(L, [&](){ t->update(data, size, out, maxsize); });
+
+	if (out.empty())
+		lua_pushliteral(L, "");
+	else
+		lua_pushlstring(L, out.data(), out.size());
+
+	luax_pushboolean(L, t->hasPendingOutput());
+	return 2;
+}
+
+int w_DecompressionStream_finish(lua_State *L)
+{
+	DecompressionStream *t = luax_checkdecompressionstream(L, 1);
+	luax_catchexcept(L, [&](){ t->finish(); });
+	return 0;
+}
+
+int w_DecompressionStream_isComplete(lua_State *L)
+{
+	DecompressionStream *t = luax_checkdecompressionstream(L, 1);
+	luax_pushboolean(L, t->isComplete());
+	return 1;
+}
+
+int w_DecompressionStream_isFinished(lua_State *L)
+{
+	DecompressionStream *t = luax_checkdecompressionstream(L, 1);
+	luax_pushboolean(L, t->isFinished());
+	return 1;
+}
+
+int w_DecompressionStream_getFormat(lua_State *L)
+{
+	DecompressionStream *t = luax_checkdecompressionstream(L, 1);
+
+	const char *fname = nullptr;
+	if (!Compressor::getConstant(t->getFormat(), fname))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(Compressor::FORMAT_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+int w_DecompressionStream_getSizes(lua_State *L)
+{
+	DecompressionStream *t = luax_checkdecompressionstream(L, 1);
+	lua_pushnumber(L, (lua_Number) t->getInputSize());
+	lua_pushnumber(L, (lua_Number) t->getOutputSize());
+	return 2;
+}
+
+static const luaL_Reg w_DecompressionStream_functions[] =
+{
+	{ "update", w_DecompressionStream_update },
+	{ "finish", w_DecompressionStream_finish },
+	{ "isComplete", w_DecompressionStream_isComplete },
+	{ "isFinished", w_DecompressionStream_isFinished },
+	{ "getFormat", w_DecompressionStream_getFormat },
+	{ "getSizes", w_DecompressionStream_getSizes },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_decompressionstream(lua_State *L)
+{
+	return luax_register_type(L, &DecompressionStream::type, w_DecompressionStream_functions, nullptr);
+}
+
+} // data
+} // love
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_PackFormat.h"
+#include "wrap_Data.h"
+#include "wrap_DataModule.h"
+
+// C
+#include <string.h>
+
+namespace love
+{
+namespace data
+{
+
+#define instance() (Module::getInstance<DataModule>(Module::M_DATA))
+
+PackFormat *luax_checkpackformat(lua_State *L, int idx)
+{
+	return luax_checktype<PackFormat>(L, idx);
+}
+
+int luax_pack(lua_State *L, ContainerType ctype, int fmtidx, int startidx)
+{
+	luaL_Buffer_53 b;
+
+	if (luax_istype(L, fmtidx, PackFormat::type))
+	{
+		PackFormat *f = luax_totype<PackFormat>(L, fmtidx);
+		lua53_str_pack_compiled(L, f->getOptions(), f->getOptionCount(), startidx, &b);
+	}
+	else
+		lua53_str_pack(L, luaL_checkstring(L, fmtidx), startidx, &b);
+
+	if (ctype == CONTAINER_DATA)
+	{
+		Data *d = nullptr;
+		luax_catchexcept(L, [&]() { d = instance()->newByteData(b.nelems); });
+		memcpy(d->getData(), b.ptr, d->getSize());
+
+		lua53_cleanupbuffer(&b);
+		luax_pushtype(L, Data::type, d);
+		d->release();
+	}
+	else
+		lua53_pushresult(&b);
+
+	return 1;
+}
+
+int luax_packinto(lua_State *L, int dstidx, int offsetidx, int fmtidx, int startidx)
+{
+	Data *dst = luax_checkdata(L, dstidx);
+	lua_Integer offset = luaL_checkinteger(L, offsetidx);
+
+	if (offset < 0 || (size_t) offset > dst->getSize())
+		return luaL_error(L, "Invalid offset into the destination Data: %d", (int) offset);
+
+	char *bytes = (char *) dst->getData() + offset;
+	size_t space = dst->getSize() - (size_t) offset;
+	size_t size = 0;
+
+	if (luax_istype(L, fmtidx, PackFormat::type))
+	{
+		PackFormat *f = luax_totype<PackFormat>(L, fmtidx);
+		size = lua53_str_packinto_compiled(L, f->getOptions(), f->getOptionCount(), startidx, bytes, space, dstidx);
+	}
+	else
+		size = lua53_str_packinto(L, luaL_checkstring(L, fmtidx), startidx, bytes, space, dstidx);
+
+	lua_pushinteger(L, (lua_Integer) size);
+	return 1;
+}
+
+int luax_unpack(lua_State *L, int fmtidx, int dataidx, int posidx)
+{
+	const char *data = nullptr;
+	size_t datasize = 0;
+
+	if (luax_istype(L, dataidx, Data::type))
+	{
+		Data *d = luax_checkdata(L, dataidx);
+		data = (const char *) d->getData();
+		datasize = d->getSize();
+	}
+	else
+		data = luaL_checklstring(L, dataidx, &datasize);
+
+	if (luax_istype(L, fmtidx, PackFormat::type))
+	{
+		PackFormat *f = luax_totype<PackFormat>(L, fmtidx);
+		return lua53_str_unpack_compiled(L, f->getOptions(), f->getOptionCount(), data, datasize, dataidx, posidx);
+	}
+
+	return lua53_str_unpack(L, luaL_checkstring(L, fmtidx), data, datasize, dataidx, posidx);
+}
+
+int w_PackFormat_getFormat(lua_State *L)
+{
+	PackFormat *t = luax_checkpackformat(L, 1);
+	luax_pushstring(L, t->getFormat());
+	return 1;
+}
+
+int w_PackFormat_getSize(lua_State *L)
+{
+	PackFormat *t = luax_checkpackformat(L, 1);
+
+	size_t size = 0;
+	if (t->getSize(size))
+		lua_pushinteger(L, (lua_Integer) size);
+	else
+		lua_pushnil(L);
+
+	return 1;
+}
+
+int w_PackFormat_pack(lua_State *L)
+{
+	luax_checkpackformat(L, 1);
+	ContainerType ctype = luax_checkcontainertype(L, 2);
+	return luax_pack(L, ctype, 1, 3);
+}
+
+int w_PackFormat_packInto(lua_State *L)
+{
+	luax_checkpackformat(L, 1);
+	return luax_packinto(L, 2, 3, 1, 4);
+}
+
+int w_PackFormat_unpack(lua_State *L)
+{
+	luax_checkpackformat(L, 1);
+	return luax_unpack(L, 1, 2, 3);
+}
+
+static const luaL_Reg w_PackFormat_functions[] =
+{
+	{ "getFormat", w_PackFormat_getFormat },
+	{ "getSize", w_PackFormat_getSize },
+	{ "pack", w_PackFormat_pack },
+	{ "packInto", w_PackFormat_packInto },
+	{ "unpack", w_PackFormat_unpack },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_packformat(lua_State *L)
+{
+	return luax_register_type(L, &PackFormat::type, w_PackFormat_functions, nullptr);
+}
+
+} // data
+} // love
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/runtime.h"
+#include "DataModule.h"
+#include "PackFormat.h"
+
+namespace love
+{
+namespace data
+{
+
+PackFormat *luax_checkpackformat(lua_State *L, int idx);
+
+/**
+ * Shared by love.data.pack/packInto/unpack and the PackFormat methods. The
+ * format at fmtidx is either a format string or a PackFormat.
+ **/
+int luax_pack(lua_State *L, ContainerType ctype, int fmtidx, int startidx);
+int luax_packinto(lua_State *L, int dstidx, int offsetidx, int fmtidx, int startidx);
+int luax_unpack(lua_State *L, int fmtidx, int dataidx, int posidx);
+
+extern "C" int luaopen_packformat(lua_State *L);
+
+} // data
+} // love
@@ -20,10 +20,23 @@
 
 #include "FileData.h"
 
+#include "common/config.h"
+
 // C++
 #include <iostream>
 #include <limits>
 
+#if defined(LOVE_WINDOWS)
+#include <windows.h>
+#include "common/utf8.h"
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace love
 {
 namespace filesystem
@@ -33,8 +46,8 @@ love::Type FileData::type("FileData", &Data::type);
 
 FileData::FileData(uint64 size, const std::string &filename)
 	: data(nullptr)
+	, mapped(false)
 	, size((size_t) size)
-	, filename(filename)
 {
 	try
 	{
@@ -45,19 +58,20 @@ FileData::FileData(uint64 size, const std::string &filename)
 		throw love::Exception("Out of memory.");
 	}
 
-	size_t dotpos = filename.rfind('.');
+	setFilename(filename);
+}
 
-	if (dotpos != std::string::npos)
-	{
-		extension = filename.substr(dotpos + 1);
-		name = filename.substr(0, dotpos);
-	}
-	else
-		name = filename;
+FileData::FileData(const std::string &filename)
+	: data(nullptr)
+	, mapped(false)
+	, size(0)
+{
+	setFilename(filename);
 }
 
 FileData::FileData(const FileData &c)
 	: data(nullptr)
+	, mapped(false)
 	, size(c.size)
 	, filename(c.filename)
 	, extension(c.extension)
@@ -76,7 +90,85 @@ FileData::FileData(const FileData &c)
 
 FileData::~FileData()
 {
-	delete [] data;
+	if (!mapped)
+		delete [] data;
+#if defined(LOVE_WINDOWS)
+	else
+		UnmapViewOfFile(data);
+#else
+	else
+		munmap(data, (size_t) size);
+#endif
+}
+
+FileData *FileData::createMapped(const std::string &realpath, const std::string &filename)
+{
+	// Empty files can't be mapped, and neither can files which don't fit in
+	// the address space.
+	void *view = nullptr;
+	uint64 filesize = 0;
+
+#if defined(LOVE_WINDOWS)
+
+	std::wstring wpath = to_widestr(realpath);
+
+	HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER li = {};
+	if (!GetFileSizeEx(file, &li) || li.QuadPart <= 0 || (uint64) li.QuadPart > std::numeric_limits<size_t>::max())
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	filesize = (uint64) li.QuadPart;
+
+	// The view keeps the file and mapping objects alive after their handles
+	// are closed.
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+
+	if (mapping == nullptr)
+		return nullptr;
+
+	view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+
+	if (view == nullptr)
+		return nullptr;
+
+#else
+
+	int fd = open(realpath.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat buf;
+	if (fstat(fd, &buf) != 0 || !S_ISREG(buf.st_mode) || buf.st_size <= 0 || (uint64) buf.st_size > std::numeric_limits<size_t>::max())
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	filesize = (uint64) buf.st_size;
+
+	// Private writable pages, so code which modifies a Data in place only
+	// changes its own copy of the page.
+	view = mmap(nullptr, (size_t) filesize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (view == MAP_FAILED)
+		return nullptr;
+
+#endif
+
+	FileData *filedata = new FileData(filename);
+	filedata->data = (char *) view;
+	filedata->size = filesize;
+	filedata->mapped = true;
+	return filedata;
 }
 
 FileData *FileData::clone() const
@@ -110,5 +202,25 @@ const std::string &FileData::getName() const
 	return name;
 }
 
+bool FileData::isMapped() const
+{
+	return mapped;
+}
+
+void FileData::setFilename(const std::string &filename)
+{
+	this->filename = filename;
+
+	size_t dotpos = filename.rfind('.');
+
+	if (dotpos != std::string::npos)
+	{
+		extension = filename.substr(dotpos + 1);
+		name = filename.substr(0, dotpos);
+	}
+	else
+		name = filename;
+}
+
 } // filesystem
 } // love
@@ -44,6 +44,16 @@ public:
 
 	virtual ~FileData();
 
+	/**
+	 * Creates a FileData whose contents are a copy-on-write memory mapping of
+	 * a file in the real filesystem, instead of a copy on the heap. The file
+	 * must not be truncated or modified while the FileData is alive.
+	 * @param realpath The full platform-dependent path of the file.
+	 * @param filename The filename used for file type identification.
+	 * @return The new FileData, or null if the file could not be mapped.
+	 **/
+	static FileData *createMapped(const std::string &realpath, const std::string &filename);
+
 	// Implements Data.
 	FileData *clone() const;
 	void *getData() const;
@@ -53,11 +63,24 @@ public:
 	const std::string &getExtension() const;
 	const std::string &getName() const;
 
+	/**
+	 * Whether the contents are mapped from a file, rather than copied.
+	 **/
+	bool isMapped() const;
+
 private:
 
+	// Creates a FileData without any contents.
+	FileData(const std::string &filename);
+
+	void setFilename(const std::string &filename);
+
 	// The actual data.
 	char *data;
 
+	// Whether data is a memory mapping rather than a heap allocation.
+	bool mapped;
+
 	// Size of the data.
 	uint64 size;
 
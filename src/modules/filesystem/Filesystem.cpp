@@ -37,6 +37,10 @@
 #include <unistd.h>
 #endif
 
+#ifndef LOVE_WINDOWS
+#include <dirent.h>
+#endif
+
 namespace love
 {
 namespace filesystem
@@ -90,6 +94,53 @@ bool Filesystem::isRealDirectory(const std::string &path) const
 #endif
 }
 
+bool Filesystem::isRealPath(const std::string &path) const
+{
+#ifdef LOVE_WINDOWS
+	std::wstring wpath = to_widestr(path);
+	return GetFileAttributesW(wpath.c_str()) != INVALID_FILE_ATTRIBUTES;
+#else
+	struct stat buf;
+	return lstat(path.c_str(), &buf) == 0;
+#endif
+}
+
+bool Filesystem::getRealDirectoryItems(const std::string &path, std::vector<std::string> &items) const
+{
+#ifdef LOVE_WINDOWS
+	std::wstring wpath = to_widestr(path + "\\*");
+
+	WIN32_FIND_DATAW data;
+	HANDLE find = FindFirstFileW(wpath.c_str(), &data);
+	if (find == INVALID_HANDLE_VALUE)
+		return false;
+
+	do
+	{
+		std::string name = to_utf8(data.cFileName);
+		if (name != "." && name != "..")
+			items.push_back(name);
+	} while (FindNextFileW(find, &data));
+
+	FindClose(find);
+	return true;
+#else
+	DIR *dir = opendir(path.c_str());
+	if (dir == nullptr)
+		return false;
+
+	while (struct dirent *entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		if (name != "." && name != "..")
+			items.push_back(name);
+	}
+
+	closedir(dir);
+	return true;
+#endif
+}
+
 std::string Filesystem::getExecutablePath() const
 {
 #if defined(LOVE_MACOSX)
@@ -28,6 +28,8 @@
 #include "common/StringMap.h"
 #include "FileData.h"
 #include "File.h"
+#include "ReadRequest.h"
+#include "HashRequest.h"
 
 // C++
 #include <string>
@@ -79,6 +81,20 @@ public:
 		FileType type;
 	};
 
+	// Counters and timings for require calls handled by love.filesystem.
+	struct RequireStats
+	{
+		int64 requires;
+		int64 found;
+		int64 cacheHits;
+		int64 cacheMisses;
+		int64 cacheWrites;
+		int64 indexBuilds;
+		double indexTime;
+		double resolveTime;
+		double loadTime;
+	};
+
 	static love::Type type;
 
 	Filesystem();
@@ -211,6 +227,33 @@ public:
 	 **/
 	virtual FileData *read(const char *filename, int64 size = File::ALL) const = 0;
 
+	/**
+	 * Reads a whole file, memory mapping it instead of copying it when it is
+	 * in a real directory other than the save directory. Falls back to read()
+	 * for files in archives or the save directory. A mapped file must not be
+	 * modified while the FileData is alive.
+	 * @param filename The name of the file to read from.
+	 **/
+	virtual FileData *readMapped(const char *filename) const = 0;
+
+	/**
+	 * Starts reading part of a file on a background I/O thread.
+	 * @param filename The file to read.
+	 * @param offset The position in the file to start reading at.
+	 * @param size The number of bytes to read, or File::ALL.
+	 * @return A new request which can be polled for the result.
+	 **/
+	virtual ReadRequest *readAsync(const char *filename, int64 offset, int64 size) = 0;
+
+	/**
+	 * Starts hashing a whole file on a background thread. The file is read in
+	 * chunks, so it never needs to fit in memory.
+	 * @param function The hash function to use.
+	 * @param filename The file to hash.
+	 * @return A new request which can be polled for the result.
+	 **/
+	virtual HashRequest *hashAsync(data::HashFunction::Function function, const char *filename) = 0;
+
 	/**
 	 * Write data to a file.
 	 * @param filename The name of the file to write to.
@@ -248,6 +291,31 @@ public:
 	virtual std::vector<std::string> &getRequirePath() = 0;
 	virtual std::vector<std::string> &getCRequirePath() = 0;
 
+	/**
+	 * Finds the first of the given paths which exists and isn't a directory.
+	 * The file index is used where possible, so this is much cheaper than
+	 * calling getInfo for each path.
+	 * @return The index of the path which was found, or -1 if none exist.
+	 **/
+	virtual int findFirstFile(const std::vector<std::string> &paths) = 0;
+
+	/**
+	 * Sets whether require stores compiled bytecode of loaded modules in the
+	 * save directory, and uses it instead of the source when it's unchanged.
+	 **/
+	virtual void setRequireCacheEnabled(bool enable) = 0;
+	virtual bool isRequireCacheEnabled() const = 0;
+
+	/**
+	 * Gets the accumulated require statistics.
+	 **/
+	virtual RequireStats getRequireStats() const = 0;
+
+	/**
+	 * Adds the given counters and timings to the require statistics.
+	 **/
+	virtual void addRequireStats(const RequireStats &stats) = 0;
+
 	/**
 	 * Allows a full (OS-dependent) path to be used with Filesystem::mount.
 	 **/
@@ -258,6 +326,18 @@ public:
 	 **/
 	virtual bool isRealDirectory(const std::string &path) const;
 
+	/**
+	 * Gets whether anything exists at the given full (OS-dependent) path,
+	 * without following symlinks.
+	 **/
+	virtual bool isRealPath(const std::string &path) const;
+
+	/**
+	 * Gets the names of the items in a directory given by its full
+	 * (OS-dependent) path. Returns false if it can't be read.
+	 **/
+	virtual bool getRealDirectoryItems(const std::string &path, std::vector<std::string> &items) const;
+
 	/**
 	 * Gets the full platform-dependent path to the executable.
 	 **/
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "HashRequest.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+love::Type HashRequest::type("HashRequest", &Object::type);
+
+HashRequest::HashRequest(const std::string &filename, data::HashFunction::Function function)
+	: filename(filename)
+	, function(function)
+	, status(STATUS_PENDING)
+	, processed(0)
+	, total(-1)
+{
+}
+
+HashRequest::~HashRequest()
+{
+}
+
+const std::string &HashRequest::getFilename() const
+{
+	return filename;
+}
+
+data::HashFunction::Function HashRequest::getFunction() const
+{
+	return function;
+}
+
+HashRequest::Status HashRequest::getStatus() const
+{
+	love::thread::Lock lock(mutex);
+	return status;
+}
+
+bool HashRequest::isComplete() const
+{
+	return getStatus() != STATUS_PENDING;
+}
+
+std::string HashRequest::getHash() const
+{
+	love::thread::Lock lock(mutex);
+	return hash;
+}
+
+std::string HashRequest::getError() const
+{
+	love::thread::Lock lock(mutex);
+	return error;
+}
+
+void HashRequest::getProgress(int64 &processed, int64 &total) const
+{
+	love::thread::Lock lock(mutex);
+	processed = this->processed;
+	total = this->total;
+}
+
+bool HashRequest::cancel()
+{
+	love::thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return false;
+
+	status = STATUS_CANCELLED;
+	error = "The hash request was cancelled.";
+	cond->broadcast();
+
+	return true;
+}
+
+void HashRequest::wait()
+{
+	love::thread::Lock lock(mutex);
+
+	while (status == STATUS_PENDING)
+		cond->wait(mutex);
+}
+
+void HashRequest::setProgress(int64 processed, int64 total)
+{
+	love::thread::Lock lock(mutex);
+	this->processed = processed;
+	this->total = total;
+}
+
+void HashRequest::complete(const data::HashFunction::Value &value)
+{
+	love::thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return;
+
+	hash.assign(value.data, value.size);
+	status = STATUS_COMPLETE;
+	cond->broadcast();
+}
+
+void HashRequest::fail(const std::string &error)
+{
+	love::thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return;
+
+	this->error = error;
+	status = STATUS_FAILED;
+	cond->broadcast();
+}
+
+} // filesystem
+} // love
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_HASH_REQUEST_H
+#define LOVE_FILESYSTEM_HASH_REQUEST_H
+
+// LOVE
+#include "common/Object.h"
+#include "common/int.h"
+#include "data/HashFunction.h"
+#include "thread/threads.h"
+
+// STD
+#include <string>
+
+namespace love
+{
+namespace filesystem
+{
+
+/**
+ * Hashing of a whole file, which happens in chunks on one of the filesystem's
+ * background threads. The result can be polled for from any thread.
+ **/
+class HashRequest : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Status
+	{
+		STATUS_PENDING,
+		STATUS_COMPLETE,
+		STATUS_FAILED,
+		STATUS_CANCELLED,
+	};
+
+	HashRequest(const std::string &filename, data::HashFunction::Function function);
+	virtual ~HashRequest();
+
+	const std::string &getFilename() const;
+	data::HashFunction::Function getFunction() const;
+
+	Status getStatus() const;
+
+	/**
+	 * Gets whether the request has finished, whether or not it succeeded.
+	 **/
+	bool isComplete() const;
+
+	/**
+	 * Gets the hash of the file as raw bytes, or an empty string if the
+	 * request hasn't finished successfully.
+	 **/
+	std::string getHash() const;
+
+	/**
+	 * Gets the reason a failed request failed.
+	 **/
+	std::string getError() const;
+
+	/**
+	 * Gets the number of bytes hashed so far, and the size of the file (or -1
+	 * if the file hasn't been opened yet.)
+	 **/
+	void getProgress(int64 &processed, int64 &total) const;
+
+	/**
+	 * Cancels the request if it hasn't finished yet. A file which is partway
+	 * through being hashed stops at the next chunk.
+	 * @return Whether the request was cancelled.
+	 **/
+	bool cancel();
+
+	/**
+	 * Blocks until the request has finished.
+	 **/
+	void wait();
+
+	// Called by the hashing thread.
+	void setProgress(int64 processed, int64 total);
+	void complete(const data::HashFunction::Value &value);
+	void fail(const std::string &error);
+
+private:
+
+	std::string filename;
+	data::HashFunction::Function function;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+	Status status;
+	std::string hash;
+	std::string error;
+
+	int64 processed;
+	int64 total;
+
+}; // HashRequest
+
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_HASH_REQUEST_H
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ReadRequest.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+love::Type ReadRequest::type("ReadRequest", &Object::type);
+
+ReadRequest::ReadRequest(const std::string &filename, int64 offset, int64 size)
+	: filename(filename)
+	, offset(offset)
+	, size(size)
+	, status(STATUS_PENDING)
+{
+}
+
+ReadRequest::~ReadRequest()
+{
+}
+
+const std::string &ReadRequest::getFilename() const
+{
+	return filename;
+}
+
+int64 ReadRequest::getOffset() const
+{
+	return offset;
+}
+
+int64 ReadRequest::getSize() const
+{
+	return size;
+}
+
+ReadRequest::Status ReadRequest::getStatus() const
+{
+	love::thread::Lock lock(mutex);
+	return status;
+}
+
+bool ReadRequest::isComplete() const
+{
+	return getStatus() != STATUS_PENDING;
+}
+
+FileData *ReadRequest::getData() const
+{
+	love::thread::Lock lock(mutex);
+	return data.get();
+}
+
+std::string ReadRequest::getError() const
+{
+	love::thread::Lock lock(mutex);
+	return error;
+}
+
+bool ReadRequest::cancel()
+{
+	love::thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return false;
+
+	status = STATUS_CANCELLED;
+	error = "The read request was cancelled.";
+	cond->broadcast();
+
+	return true;
+}
+
+void ReadRequest::wait()
+{
+	love::thread::Lock lock(mutex);
+
+	while (status == STATUS_PENDING)
+		cond->wait(mutex);
+}
+
+void ReadRequest::complete(FileData *data)
+{
+	love::thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return;
+
+	this->data.set(data);
+	status = STATUS_COMPLETE;
+	cond->broadcast();
+}
+
+void ReadRequest::fail(const std::string &error)
+{
+	love::thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return;
+
+	this->error = error;
+	status = STATUS_FAILED;
+	cond->broadcast();
+}
+
+} // filesystem
+} // love
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_READ_REQUEST_H
+#define LOVE_FILESYSTEM_READ_REQUEST_H
+
+// LOVE
+#include "common/Object.h"
+#include "common/int.h"
+#include "thread/threads.h"
+#include "FileData.h"
+
+// STD
+#include <string>
+
+namespace love
+{
+namespace filesystem
+{
+
+/**
+ * A file read which happens on one of the filesystem's I/O threads. The
+ * result can be polled for from any thread.
+ **/
+class ReadRequest : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Status
+	{
+		STATUS_PENDING,
+		STATUS_COMPLETE,
+		STATUS_FAILED,
+		STATUS_CANCELLED,
+	};
+
+	/**
+	 * @param filename The file to read.
+	 * @param offset The position in the file to start reading at.
+	 * @param size The number of bytes to read, or File::ALL to read to the
+	 * end of the file.
+	 **/
+	ReadRequest(const std::string &filename, int64 offset, int64 size);
+	virtual ~ReadRequest();
+
+	const std::string &getFilename() const;
+	int64 getOffset() const;
+	int64 getSize() const;
+
+	Status getStatus() const;
+
+	/**
+	 * Gets whether the request has finished, whether or not it succeeded.
+	 **/
+	bool isComplete() const;
+
+	/**
+	 * Gets the data which was read, or null if the request hasn't finished
+	 * successfully. Reading from past the end of the file gives empty data.
+	 **/
+	FileData *getData() const;
+
+	/**
+	 * Gets the reason a failed request failed.
+	 **/
+	std::string getError() const;
+
+	/**
+	 * Cancels the request if it hasn't finished yet.
+	 * @return Whether the request was cancelled.
+	 **/
+	bool cancel();
+
+	/**
+	 * Blocks until the request has finished.
+	 **/
+	void wait();
+
+	// Called by the I/O threads.
+	void complete(FileData *data);
+	void fail(const std::string &error);
+
+private:
+
+	std::string filename;
+	int64 offset;
+	int64 size;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+	Status status;
+	StrongRef<FileData> data;
+	std::string error;
+
+}; // ReadRequest
+
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_READ_REQUEST_H
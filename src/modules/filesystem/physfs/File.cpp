@@ -102,6 +102,13 @@ bool File::open(Mode mode)
 
 	this->mode = mode;
 
+	if (mode == MODE_APPEND || mode == MODE_WRITE)
+	{
+		auto fs = Module::getInstance<Filesystem>(Module::M_FILESYSTEM);
+		if (fs != nullptr)
+			fs->addIndexedFile(filename.c_str());
+	}
+
 	if (file != nullptr && !setBuffer(bufferMode, bufferSize))
 	{
 		// Revert to buffer defaults if we don't successfully set the buffer.
@@ -0,0 +1,437 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "FileIndex.h"
+#include "timer/Timer.h"
+
+// PhysFS
+#include "libraries/physfs/physfs.h"
+
+// STD
+#include <algorithm>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+static Filesystem::FileType getFileType(PHYSFS_FileType type)
+{
+	if (type == PHYSFS_FILETYPE_REGULAR)
+		return Filesystem::FILETYPE_FILE;
+	else if (type == PHYSFS_FILETYPE_DIRECTORY)
+		return Filesystem::FILETYPE_DIRECTORY;
+	else if (type == PHYSFS_FILETYPE_SYMLINK)
+		return Filesystem::FILETYPE_SYMLINK;
+	else
+		return Filesystem::FILETYPE_OTHER;
+}
+
+FileIndex::FileIndex(const love::filesystem::Filesystem *filesystem)
+	: filesystem(filesystem)
+	, valid(false)
+	, indexable(false)
+	, saveDirectoryMounted(false)
+	, buildCount(0)
+	, buildTime(0.0)
+{
+}
+
+FileIndex::~FileIndex()
+{
+}
+
+FileIndex::Result FileIndex::getInfo(const char *path, Filesystem::Info &info)
+{
+	love::thread::Lock lock(mutex);
+
+	if (!valid)
+		build();
+
+	if (!indexable)
+		return RESULT_UNKNOWN;
+
+	std::string key;
+	if (!getKey(path, key))
+		return RESULT_UNKNOWN;
+
+	auto it = entries.find(key);
+	if (it == entries.end())
+		return getMissingResult(key);
+
+	if (it->second.dynamic)
+		return RESULT_UNKNOWN;
+
+	info = it->second.info;
+	return RESULT_FOUND;
+}
+
+bool FileIndex::getDirectoryItems(const char *path, std::vector<std::string> &items)
+{
+	love::thread::Lock lock(mutex);
+
+	if (!valid)
+		build();
+
+	if (!indexable)
+		return false;
+
+	std::string key;
+	if (!getKey(path, key))
+		return false;
+
+	auto it = entries.find(key);
+	if (it == entries.end())
+		return getMissingResult(key) == RESULT_MISSING;
+
+	const Entry &entry = it->second;
+
+	// PhysFS lists nothing for files.
+	if (entry.info.type == Filesystem::FILETYPE_DIRECTORY && entry.explored)
+	{
+		// Another program could have added or removed items in the save
+		// directory.
+		if (saveDirectoryMounted && !matchesSaveDirectory(key, entry))
+			return false;
+
+		items.insert(items.end(), entry.children.begin(), entry.children.end());
+	}
+	else if (entry.info.type == Filesystem::FILETYPE_DIRECTORY || entry.info.type == Filesystem::FILETYPE_SYMLINK)
+		return false;
+
+	return true;
+}
+
+void FileIndex::add(const char *path, Filesystem::FileType type)
+{
+	std::string key;
+	if (!getKey(path, key) || key.empty())
+		return;
+
+	love::thread::Lock lock(mutex);
+
+	if (!valid || !indexable)
+		return;
+
+	// Writing a file creates any missing parent directories.
+	std::string parent;
+	size_t pos = key.find('/');
+	while (pos != std::string::npos)
+	{
+		std::string dir = key.substr(0, pos);
+		auto it = entries.find(dir);
+
+		if (it == entries.end())
+		{
+			Entry &entry = entries[dir];
+			entry.info.size = -1;
+			entry.info.modtime = -1;
+			entry.info.type = Filesystem::FILETYPE_DIRECTORY;
+			entry.dynamic = true;
+			entry.saved = true;
+			entry.explored = true;
+
+			addChild(parent, dir.substr(parent.empty() ? 0 : parent.size() + 1));
+		}
+		else if (it->second.info.type != Filesystem::FILETYPE_DIRECTORY || !it->second.explored)
+		{
+			// Lookups beneath this go through PhysFS anyway.
+			return;
+		}
+
+		parent = dir;
+		pos = key.find('/', pos + 1);
+	}
+
+	auto it = entries.find(key);
+	if (it == entries.end())
+	{
+		Entry &entry = entries[key];
+		entry.info.size = -1;
+		entry.info.modtime = -1;
+		entry.info.type = type;
+		entry.dynamic = true;
+		entry.saved = true;
+		entry.explored = true;
+
+		addChild(parent, key.substr(parent.empty() ? 0 : parent.size() + 1));
+	}
+	else
+	{
+		it->second.dynamic = true;
+		it->second.saved = true;
+	}
+
+	// Adding an item changes its directory's modification time.
+	entries[parent].dynamic = true;
+}
+
+void FileIndex::invalidate()
+{
+	love::thread::Lock lock(mutex);
+	valid = false;
+	entries.clear();
+}
+
+void FileIndex::setSaveDirectory(const std::string &path)
+{
+	love::thread::Lock lock(mutex);
+	saveDirectory = path;
+	valid = false;
+	entries.clear();
+}
+
+int FileIndex::getBuildCount() const
+{
+	love::thread::Lock lock(mutex);
+	return buildCount;
+}
+
+double FileIndex::getBuildTime() const
+{
+	love::thread::Lock lock(mutex);
+	return buildTime;
+}
+
+void FileIndex::build()
+{
+	double start = love::timer::Timer::getTime();
+
+	entries.clear();
+
+	indexable = PHYSFS_isInit() && isIndexable();
+
+	if (indexable)
+	{
+		Entry &root = entries[""];
+		root.info.size = -1;
+		root.info.modtime = -1;
+		root.info.type = Filesystem::FILETYPE_DIRECTORY;
+		root.dynamic = false;
+		root.saved = false;
+		root.explored = true;
+
+		PHYSFS_Stat stat = {};
+		if (PHYSFS_stat("", &stat))
+		{
+			root.info.size = (int64) stat.filesize;
+			root.info.modtime = (int64) stat.modtime;
+		}
+
+		addDirectory("", root, 0);
+	}
+
+	valid = true;
+	buildCount++;
+	buildTime += love::timer::Timer::getTime() - start;
+}
+
+bool FileIndex::isIndexable()
+{
+	saveDirectoryMounted = false;
+
+	char **searchpath = PHYSFS_getSearchPath();
+	if (searchpath == nullptr)
+		return false;
+
+	bool archives = true;
+
+	// Anything could change the contents of a real directory behind our back.
+	for (char **i = searchpath; *i != nullptr; i++)
+	{
+		if (!saveDirectory.empty() && saveDirectory == *i)
+			saveDirectoryMounted = true;
+		else if (filesystem->isRealDirectory(*i))
+		{
+			archives = false;
+			break;
+		}
+	}
+
+	PHYSFS_freeList(searchpath);
+	return archives;
+}
+
+void FileIndex::addDirectory(const std::string &dir, Entry &entry, int depth)
+{
+	char **rc = PHYSFS_enumerateFiles(dir.c_str());
+
+	if (rc == nullptr)
+	{
+		entry.explored = false;
+		return;
+	}
+
+	for (char **i = rc; *i != 0; i++)
+		entry.children.push_back(*i);
+
+	PHYSFS_freeList(rc);
+
+	for (const std::string &name : entry.children)
+	{
+		std::string path = dir.empty() ? name : dir + "/" + name;
+
+		Entry child;
+		child.info.size = -1;
+		child.info.modtime = -1;
+		child.info.type = Filesystem::FILETYPE_OTHER;
+		child.dynamic = false;
+		child.saved = false;
+		child.explored = false;
+
+		PHYSFS_Stat stat = {};
+		if (PHYSFS_stat(path.c_str(), &stat))
+		{
+			child.info.size = (int64) stat.filesize;
+			child.info.modtime = (int64) stat.modtime;
+			child.info.type = getFileType(stat.filetype);
+		}
+		else
+		{
+			// Leave it to PhysFS to report on.
+			child.dynamic = true;
+		}
+
+		// Items in the save directory can change at any time.
+		if (saveDirectoryMounted)
+		{
+			const char *realdir = PHYSFS_getRealDir(path.c_str());
+			child.saved = realdir != nullptr && saveDirectory == realdir;
+			child.dynamic = child.dynamic || child.saved;
+		}
+
+		Entry &added = entries[path] = child;
+
+		// Symlinked directories aren't followed, since they can form cycles.
+		// Anything beneath them is looked up through PhysFS instead.
+		if (child.info.type == Filesystem::FILETYPE_DIRECTORY && depth < MAX_DEPTH)
+		{
+			added.explored = true;
+			addDirectory(path, added, depth + 1);
+		}
+	}
+}
+
+void FileIndex::addChild(const std::string &parent, const std::string &name)
+{
+	std::vector<std::string> &children = entries[parent].children;
+
+	auto it = std::lower_bound(children.begin(), children.end(), name);
+	if (it == children.end() || *it != name)
+		children.insert(it, name);
+}
+
+FileIndex::Result FileIndex::getMissingResult(std::string key) const
+{
+	// Another program could have created it in the save directory.
+	if (saveDirectoryMounted && filesystem->isRealPath(getSavePath(key)))
+		return RESULT_UNKNOWN;
+
+	while (!key.empty())
+	{
+		size_t pos = key.rfind('/');
+		key.resize(pos == std::string::npos ? 0 : pos);
+
+		auto it = entries.find(key);
+		if (it == entries.end())
+			continue;
+
+		const Entry &entry = it->second;
+
+		if (entry.info.type == Filesystem::FILETYPE_DIRECTORY)
+			return entry.explored ? RESULT_MISSING : RESULT_UNKNOWN;
+		else if (entry.info.type == Filesystem::FILETYPE_SYMLINK)
+			return RESULT_UNKNOWN;
+		else
+			return RESULT_MISSING;
+	}
+
+	return RESULT_MISSING;
+}
+
+bool FileIndex::matchesSaveDirectory(const std::string &key, const Entry &entry) const
+{
+	std::vector<std::string> saveditems;
+	filesystem->getRealDirectoryItems(getSavePath(key), saveditems);
+
+	// Everything in the save directory has to be known already...
+	for (const std::string &name : saveditems)
+	{
+		if (!std::binary_search(entry.children.begin(), entry.children.end(), name))
+			return false;
+	}
+
+	// ...and everything found there before has to still be there.
+	std::sort(saveditems.begin(), saveditems.end());
+
+	for (const std::string &name : entry.children)
+	{
+		auto it = entries.find(key.empty() ? name : key + "/" + name);
+		if (it != entries.end() && it->second.saved && !std::binary_search(saveditems.begin(), saveditems.end(), name))
+			return false;
+	}
+
+	return true;
+}
+
+std::string FileIndex::getSavePath(const std::string &key) const
+{
+	return key.empty() ? saveDirectory : saveDirectory + LOVE_PATH_SEPARATOR + key;
+}
+
+bool FileIndex::getKey(const char *path, std::string &key)
+{
+	key.clear();
+
+	const char *c = path;
+	while (*c != '\0')
+	{
+		while (*c == '/')
+			c++;
+
+		const char *start = c;
+		while (*c != '\0' && *c != '/')
+		{
+			if (*c == '\\' || *c == ':')
+				return false;
+			c++;
+		}
+
+		size_t len = c - start;
+		if (len == 0)
+			break;
+
+		if ((len == 1 && start[0] == '.') || (len == 2 && start[0] == '.' && start[1] == '.'))
+			return false;
+
+		if (!key.empty())
+			key += '/';
+
+		key.append(start, len);
+	}
+
+	return true;
+}
+
+} // physfs
+} // filesystem
+} // love
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_PHYSFS_FILE_INDEX_H
+#define LOVE_FILESYSTEM_PHYSFS_FILE_INDEX_H
+
+// LOVE
+#include "common/int.h"
+#include "filesystem/Filesystem.h"
+#include "thread/threads.h"
+
+// STD
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+/**
+ * An in-memory index of every path visible through PhysFS' search path, built
+ * once by walking the merged directory tree. Lookups and directory listings
+ * afterwards are a single hash probe, instead of PhysFS asking every mounted
+ * archive and directory in turn.
+ *
+ * The index only knows about changes made through love.filesystem, so it's
+ * only used while the search path consists of archives and the save
+ * directory. Otherwise every lookup is answered with RESULT_UNKNOWN and
+ * PhysFS has to be asked. Other programs can change the save directory too,
+ * so while it's mounted the index is checked against it: a miss is only
+ * reported once the path is also missing from the save directory, and a
+ * directory listing is only used if the save directory's copy of the
+ * directory has the same items the index expects. Anything found in the
+ * save directory is left to PhysFS.
+ **/
+class FileIndex
+{
+public:
+
+	enum Result
+	{
+		RESULT_FOUND,
+		RESULT_MISSING,
+		RESULT_UNKNOWN,
+	};
+
+	FileIndex(const love::filesystem::Filesystem *filesystem);
+	~FileIndex();
+
+	/**
+	 * Gets information about the given path, building the index first if
+	 * needed. Files written through love.filesystem since the index was
+	 * built give RESULT_UNKNOWN, since their size and modification time
+	 * change without the index knowing.
+	 **/
+	Result getInfo(const char *path, Filesystem::Info &info);
+
+	/**
+	 * Gets the names of the items in a directory, in the order PhysFS would
+	 * give them. Returns false if PhysFS has to be asked instead.
+	 **/
+	bool getDirectoryItems(const char *path, std::vector<std::string> &items);
+
+	/**
+	 * Records a file or directory created or modified through
+	 * love.filesystem, along with its parent directories. Does nothing if the
+	 * index hasn't been built.
+	 **/
+	void add(const char *path, Filesystem::FileType type);
+
+	/**
+	 * Discards the index. It will be rebuilt by the next lookup.
+	 **/
+	void invalidate();
+
+	/**
+	 * Sets the full path of the save directory, whose contents are checked
+	 * on every lookup which uses the index.
+	 **/
+	void setSaveDirectory(const std::string &path);
+
+	int getBuildCount() const;
+	double getBuildTime() const;
+
+private:
+
+	struct Entry
+	{
+		Filesystem::Info info;
+
+		// Whether the size and modification time may have changed since
+		// the entry was stat'd.
+		bool dynamic;
+
+		// Whether the item was in the save directory.
+		bool saved;
+
+		// Whether the children of a directory are known.
+		bool explored;
+
+		// Sorted names of the items in a directory.
+		std::vector<std::string> children;
+	};
+
+	void build();
+	bool isIndexable();
+	void addDirectory(const std::string &dir, Entry &entry, int depth);
+	void addChild(const std::string &parent, const std::string &name);
+
+	// Works out whether a path which isn't in the index is known not to
+	// exist, or is beneath a directory the index doesn't cover.
+	Result getMissingResult(std::string key) const;
+
+	// Whether the save directory's copy of a directory has exactly the
+	// items in the save directory the index expects.
+	bool matchesSaveDirectory(const std::string &key, const Entry &entry) const;
+
+	std::string getSavePath(const std::string &key) const;
+
+	// Converts a path to the form used as a key, or returns false if it has
+	// components PhysFS would reject or resolve differently.
+	static bool getKey(const char *path, std::string &key);
+
+	const love::filesystem::Filesystem *filesystem;
+
+	love::thread::MutexRef mutex;
+
+	std::unordered_map<std::string, Entry> entries;
+	bool valid;
+	bool indexable;
+
+	std::string saveDirectory;
+	bool saveDirectoryMounted;
+
+	int buildCount;
+	double buildTime;
+
+	static const int MAX_DEPTH = 64;
+
+}; // FileIndex
+
+} // physfs
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_PHYSFS_FILE_INDEX_H
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_PHYSFS_FILE_QUEUE_H
+#define LOVE_FILESYSTEM_PHYSFS_FILE_QUEUE_H
+
+// LOVE
+#include "common/Exception.h"
+#include "thread/threads.h"
+
+// STD
+#include <functional>
+#include <list>
+#include <vector>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+/**
+ * A set of background threads which take jobs from a queue in the order they
+ * were added. ReadQueue and HashQueue only supply what to do with a job.
+ *
+ * Jobs which are still queued when the FileQueue is destroyed are passed to
+ * the cancel callback instead of being processed. A FileQueue should be
+ * declared after anything its callbacks use, so its threads are stopped
+ * first.
+ **/
+template <typename Job>
+class FileQueue
+{
+public:
+
+	typedef std::function<void(Job &job)> Callback;
+
+	FileQueue(const char *threadName, int threadCount, const Callback &process, const Callback &cancel)
+		: process(process)
+		, cancel(cancel)
+		, stopping(false)
+	{
+		for (int i = 0; i < threadCount; i++)
+		{
+			Worker *worker = new Worker(this, threadName);
+			if (worker->start())
+				workers.push_back(worker);
+			else
+				worker->release();
+		}
+
+		if (workers.empty())
+			throw love::Exception("Could not start any %s threads.", threadName);
+	}
+
+	~FileQueue()
+	{
+		{
+			love::thread::Lock lock(mutex);
+			stopping = true;
+			cond->broadcast();
+		}
+
+		for (Worker *worker : workers)
+		{
+			worker->wait();
+			worker->release();
+		}
+
+		for (Job &job : queued)
+			cancel(job);
+	}
+
+	void push(const Job &job)
+	{
+		love::thread::Lock lock(mutex);
+		queued.push_back(job);
+		cond->signal();
+	}
+
+	/**
+	 * Gets whether the queue is being destroyed. Long jobs should check this
+	 * regularly, and give up if it's true.
+	 **/
+	bool isStopping() const
+	{
+		love::thread::Lock lock(mutex);
+		return stopping;
+	}
+
+	int getThreadCount() const
+	{
+		return (int) workers.size();
+	}
+
+private:
+
+	class Worker : public love::thread::Threadable
+	{
+	public:
+
+		Worker(FileQueue *queue, const char *name)
+			: queue(queue)
+		{
+			threadName = name;
+		}
+
+		void threadFunction() override
+		{
+			queue->workerLoop();
+		}
+
+	private:
+
+		FileQueue *queue;
+	};
+
+	void workerLoop()
+	{
+		while (true)
+		{
+			Job job;
+
+			{
+				love::thread::Lock lock(mutex);
+
+				while (!stopping && queued.empty())
+					cond->wait(mutex);
+
+				if (stopping)
+					return;
+
+				job = queued.front();
+				queued.pop_front();
+			}
+
+			process(job);
+		}
+	}
+
+	Callback process;
+	Callback cancel;
+
+	std::vector<Worker *> workers;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+	std::list<Job> queued;
+
+	bool stopping;
+
+}; // FileQueue
+
+} // physfs
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_PHYSFS_FILE_QUEUE_H
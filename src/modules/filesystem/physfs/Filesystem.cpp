@@ -101,6 +101,11 @@ namespace physfs
 Filesystem::Filesystem()
 	: fused(false)
 	, fusedSet(false)
+	, index(this)
+	, requireCacheEnabled(false)
+	, requireStats()
+	, readQueue(nullptr)
+	, hashQueue(nullptr)
 {
 	requirePath = {"?.lua", "?/init.lua"};
 	cRequirePath = {"??"};
@@ -108,6 +113,10 @@ Filesystem::Filesystem()
 
 Filesystem::~Filesystem()
 {
+	// The I/O threads use PhysFS, so they must finish first.
+	delete readQueue;
+	delete hashQueue;
+
 #ifdef LOVE_ANDROID
 	love::android::deinitializeVirtualArchive();
 #endif
@@ -205,6 +214,8 @@ bool Filesystem::setIdentity(const char *ident, bool appendToPath)
 	// already called at least once before.
 	PHYSFS_setWriteDir(nullptr);
 
+	index.setSaveDirectory(save_path_full);
+
 	return true;
 }
 
@@ -286,6 +297,8 @@ bool Filesystem::setSource(const char *source)
 		return false;
 #endif
 
+	index.invalidate();
+
 	// Save the game source.
 	game_source = new_search_path;
 
@@ -332,7 +345,9 @@ bool Filesystem::setupWriteDirectory()
 		return false;
 
 	// Create the save folder. (We're now "at" either '/' or the user's home).
-	if (!createDirectory(temp_createdir.c_str()))
+	// This isn't in the search path, so it bypasses createDirectory's update
+	// of the file index.
+	if (!PHYSFS_mkdir(temp_createdir.c_str()))
 	{
 		// Clear the write directory in case of error.
 		PHYSFS_setWriteDir(nullptr);
@@ -350,6 +365,8 @@ bool Filesystem::setupWriteDirectory()
 		return false;
 	}
 
+	index.invalidate();
+
 	return true;
 }
 
@@ -396,7 +413,11 @@ bool Filesystem::mount(const char *archive, const char *mountpoint, bool appendT
 	if (realPath.length() == 0)
 		return false;
 
-	return PHYSFS_mount(realPath.c_str(), mountpoint, appendToPath) != 0;
+	if (!PHYSFS_mount(realPath.c_str(), mountpoint, appendToPath))
+		return false;
+
+	index.invalidate();
+	return true;
 }
 
 bool Filesystem::mount(Data *data, const char *archivename, const char *mountpoint, bool appendToPath)
@@ -407,6 +428,7 @@ bool Filesystem::mount(Data *data, const char *archivename, const char *mountpoi
 	if (PHYSFS_mountMemory(data->getData(), data->getSize(), nullptr, archivename, mountpoint, appendToPath) != 0)
 	{
 		mountedData[archivename] = data;
+		index.invalidate();
 		return true;
 	}
 
@@ -423,6 +445,7 @@ bool Filesystem::unmount(const char *archive)
 	if (datait != mountedData.end() && PHYSFS_unmount(archive) != 0)
 	{
 		mountedData.erase(datait);
+		index.invalidate();
 		return true;
 	}
 
@@ -459,7 +482,11 @@ bool Filesystem::unmount(const char *archive)
 	if (!mountPoint)
 		return false;
 
-	return PHYSFS_unmount(realPath.c_str()) != 0;
+	if (!PHYSFS_unmount(realPath.c_str()))
+		return false;
+
+	index.invalidate();
+	return true;
 }
 
 bool Filesystem::unmount(Data *data)
@@ -595,6 +622,10 @@ bool Filesystem::getInfo(const char *filepath, Info &info) const
 	if (!PHYSFS_isInit())
 		return false;
 
+	FileIndex::Result result = index.getInfo(filepath, info);
+	if (result != FileIndex::RESULT_UNKNOWN)
+		return result == FileIndex::RESULT_FOUND;
+
 	PHYSFS_Stat stat = {};
 	if (!PHYSFS_stat(filepath, &stat))
 		return false;
@@ -625,6 +656,7 @@ bool Filesystem::createDirectory(const char *dir)
 	if (!PHYSFS_mkdir(dir))
 		return false;
 
+	index.add(dir, FILETYPE_DIRECTORY);
 	return true;
 }
 
@@ -639,6 +671,9 @@ bool Filesystem::remove(const char *file)
 	if (!PHYSFS_delete(file))
 		return false;
 
+	// The removed file may have been hiding one with the same path in another
+	// part of the search path.
+	index.invalidate();
 	return true;
 }
 
@@ -652,6 +687,102 @@ FileData *Filesystem::read(const char *filename, int64 size) const
 	return file.read(size);
 }
 
+FileData *Filesystem::readMapped(const char *filename) const
+{
+	if (!PHYSFS_isInit())
+		throw love::Exception("PhysFS is not initialized.");
+
+	const char *realdir = PHYSFS_getRealDir(filename);
+
+	// Files inside archives (including a fused game) can't be mapped. Neither
+	// can files in the save directory: love.filesystem.write can truncate
+	// them, and accessing the truncated part of a mapping crashes.
+	if (realdir != nullptr && isRealDirectory(realdir) && !isInSaveDirectory(realdir))
+	{
+		std::string path = filename;
+		while (!path.empty() && path[0] == '/')
+			path.erase(0, 1);
+
+		// Paths inside a directory mounted somewhere other than the root are
+		// relative to the mount point.
+		const char *mountpoint = PHYSFS_getMountPoint(realdir);
+		std::string prefix = mountpoint != nullptr ? mountpoint : "";
+		while (!prefix.empty() && prefix[0] == '/')
+			prefix.erase(0, 1);
+
+		if (path.compare(0, prefix.size(), prefix) == 0)
+		{
+			std::string realpath = std::string(realdir) + LOVE_PATH_SEPARATOR + path.substr(prefix.size());
+
+			FileData *data = FileData::createMapped(realpath, filename);
+			if (data != nullptr)
+				return data;
+		}
+	}
+
+	return read(filename);
+}
+
+bool Filesystem::isInSaveDirectory(const std::string &realdir) const
+{
+	const char *writedir = PHYSFS_getWriteDir();
+
+	for (const std::string &dir : {std::string(writedir != nullptr ? writedir : ""), save_path_full})
+	{
+		if (!dir.empty() && realdir.compare(0, dir.size(), dir) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+ReadRequest *Filesystem::readAsync(const char *filename, int64 offset, int64 size)
+{
+	if (!PHYSFS_isInit())
+		throw love::Exception("PhysFS is not initialized.");
+
+	if (offset < 0)
+		throw love::Exception("Invalid read offset.");
+
+	if (size < 0 && size != File::ALL)
+		throw love::Exception("Invalid read size.");
+
+	{
+		love::thread::Lock lock(readQueueMutex);
+
+		// Reads are mostly waiting on storage, so a few threads are enough to
+		// keep several requests in flight.
+		if (readQueue == nullptr)
+			readQueue = new ReadQueue(std::max(1, std::min(love::thread::getProcessorCount() / 2, 4)));
+	}
+
+	ReadRequest *request = new ReadRequest(filename, offset, size);
+	readQueue->add(request);
+
+	return request;
+}
+
+HashRequest *Filesystem::hashAsync(data::HashFunction::Function function, const char *filename)
+{
+	if (!PHYSFS_isInit())
+		throw love::Exception("PhysFS is not initialized.");
+
+	if (data::HashFunction::getHashFunction(function) == nullptr)
+		throw love::Exception("Invalid hash function.");
+
+	{
+		love::thread::Lock lock(hashQueueMutex);
+
+		if (hashQueue == nullptr)
+			hashQueue = new HashQueue();
+	}
+
+	HashRequest *request = new HashRequest(filename, function);
+	hashQueue->add(request);
+
+	return request;
+}
+
 void Filesystem::write(const char *filename, const void *data, int64 size) const
 {
 	File file(filename);
@@ -679,6 +810,9 @@ void Filesystem::getDirectoryItems(const char *dir, std::vector<std::string> &it
 	if (!PHYSFS_isInit())
 		return;
 
+	if (index.getDirectoryItems(dir, items))
+		return;
+
 	char **rc = PHYSFS_enumerateFiles(dir);
 
 	if (rc == nullptr)
@@ -696,6 +830,7 @@ void Filesystem::setSymlinksEnabled(bool enable)
 		return;
 
 	PHYSFS_permitSymbolicLinks(enable ? 1 : 0);
+	index.invalidate();
 }
 
 bool Filesystem::areSymlinksEnabled() const
@@ -716,6 +851,57 @@ std::vector<std::string> &Filesystem::getCRequirePath()
 	return cRequirePath;
 }
 
+int Filesystem::findFirstFile(const std::vector<std::string> &paths)
+{
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		Info info = {};
+		if (getInfo(paths[i].c_str(), info) && info.type != FILETYPE_DIRECTORY)
+			return (int) i;
+	}
+
+	return -1;
+}
+
+void Filesystem::setRequireCacheEnabled(bool enable)
+{
+	requireCacheEnabled = enable;
+}
+
+bool Filesystem::isRequireCacheEnabled() const
+{
+	return requireCacheEnabled;
+}
+
+Filesystem::RequireStats Filesystem::getRequireStats() const
+{
+	love::thread::Lock lock(requireStatsMutex);
+
+	RequireStats stats = requireStats;
+	stats.indexBuilds = index.getBuildCount();
+	stats.indexTime = index.getBuildTime();
+
+	return stats;
+}
+
+void Filesystem::addRequireStats(const RequireStats &stats)
+{
+	love::thread::Lock lock(requireStatsMutex);
+
+	requireStats.requires += stats.requires;
+	requireStats.found += stats.found;
+	requireStats.cacheHits += stats.cacheHits;
+	requireStats.cacheMisses += stats.cacheMisses;
+	requireStats.cacheWrites += stats.cacheWrites;
+	requireStats.resolveTime += stats.resolveTime;
+	requireStats.loadTime += stats.loadTime;
+}
+
+void Filesystem::addIndexedFile(const char *filename)
+{
+	index.add(filename, FILETYPE_FILE);
+}
+
 void Filesystem::allowMountingForPath(const std::string &path)
 {
 	if (std::find(allowedMountPaths.begin(), allowedMountPaths.end(), path) == allowedMountPaths.end())
@@ -28,6 +28,9 @@
 
 // LOVE
 #include "filesystem/Filesystem.h"
+#include "FileIndex.h"
+#include "ReadQueue.h"
+#include "HashQueue.h"
 
 namespace love
 {
@@ -83,6 +86,9 @@ public:
 	bool remove(const char *file) override;
 
 	FileData *read(const char *filename, int64 size = File::ALL) const override;
+	FileData *readMapped(const char *filename) const override;
+	ReadRequest *readAsync(const char *filename, int64 offset, int64 size) override;
+	HashRequest *hashAsync(data::HashFunction::Function function, const char *filename) override;
 	void write(const char *filename, const void *data, int64 size) const override;
 	void append(const char *filename, const void *data, int64 size) const override;
 
@@ -94,10 +100,24 @@ public:
 	std::vector<std::string> &getRequirePath() override;
 	std::vector<std::string> &getCRequirePath() override;
 
+	int findFirstFile(const std::vector<std::string> &paths) override;
+
+	void setRequireCacheEnabled(bool enable) override;
+	bool isRequireCacheEnabled() const override;
+
+	RequireStats getRequireStats() const override;
+	void addRequireStats(const RequireStats &stats) override;
+
+	// Records a file opened for writing in the file index.
+	void addIndexedFile(const char *filename);
+
 	void allowMountingForPath(const std::string &path) override;
 
 private:
 
+	// Whether a real directory is, or is inside, the save directory.
+	bool isInSaveDirectory(const std::string &realdir) const;
+
 	// Contains the current working directory (UTF8).
 	std::string cwd;
 
@@ -129,6 +149,23 @@ private:
 
 	std::map<std::string, StrongRef<Data>> mountedData;
 
+	// Every path in the search path, for lookups which don't need PhysFS.
+	// Lookups may build it, so it's modified by const methods.
+	mutable FileIndex index;
+
+	bool requireCacheEnabled;
+
+	love::thread::MutexRef requireStatsMutex;
+	RequireStats requireStats;
+
+	// Started by the first readAsync call.
+	ReadQueue *readQueue;
+	love::thread::MutexRef readQueueMutex;
+
+	// Started by the first hashAsync call.
+	HashQueue *hashQueue;
+	love::thread::MutexRef hashQueueMutex;
+
 }; // Filesystem
 
 } // physfs
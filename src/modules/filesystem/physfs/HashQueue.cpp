@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "HashQueue.h"
+#include "File.h"
+#include "data/Hasher.h"
+
+// STD
+#include <vector>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+HashQueue::HashQueue()
+	: queue("HashQueue", 1,
+	        [this](StrongRef<HashRequest> &request) { if (!request->isComplete()) process(request); },
+	        [](StrongRef<HashRequest> &request) { request->cancel(); })
+{
+}
+
+HashQueue::~HashQueue()
+{
+}
+
+void HashQueue::add(HashRequest *request)
+{
+	queue.push(request);
+}
+
+void HashQueue::process(HashRequest *request)
+{
+	try
+	{
+		data::Hasher hasher(request->getFunction());
+
+		File file(request->getFilename());
+		file.open(File::MODE_READ);
+
+		int64 total = file.getSize();
+		int64 processed = 0;
+
+		request->setProgress(processed, total);
+
+		std::vector<char> buffer((size_t) CHUNK_SIZE);
+
+		while (true)
+		{
+			// Cancelled requests and shutdown stop the hash between chunks.
+			if (request->isComplete())
+				return;
+
+			if (queue.isStopping())
+			{
+				request->cancel();
+				return;
+			}
+
+			int64 read = file.read(&buffer[0], CHUNK_SIZE);
+			if (read < 0)
+				throw love::Exception("Could not read from file %s.", request->getFilename().c_str());
+			if (read == 0)
+				break;
+
+			hasher.update(&buffer[0], (uint64) read);
+
+			processed += read;
+			request->setProgress(processed, total);
+		}
+
+		data::HashFunction::Value value;
+		hasher.finish(value);
+
+		request->complete(value);
+	}
+	catch (love::Exception &e)
+	{
+		request->fail(e.what());
+	}
+}
+
+} // physfs
+} // filesystem
+} // love
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_PHYSFS_HASH_QUEUE_H
+#define LOVE_FILESYSTEM_PHYSFS_HASH_QUEUE_H
+
+// LOVE
+#include "filesystem/HashRequest.h"
+#include "FileQueue.h"
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+/**
+ * A background thread which hashes files for HashRequests, one at a time and
+ * in the order they were added. Files are read in fixed-size chunks, so memory
+ * use doesn't depend on the size of the file.
+ **/
+class HashQueue
+{
+public:
+
+	HashQueue();
+	~HashQueue();
+
+	void add(HashRequest *request);
+
+private:
+
+	// The amount of a file which is read and hashed at a time.
+	static const int64 CHUNK_SIZE = 1024 * 1024;
+
+	void process(HashRequest *request);
+
+	FileQueue<StrongRef<HashRequest>> queue;
+
+}; // HashQueue
+
+} // physfs
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_PHYSFS_HASH_QUEUE_H
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ReadQueue.h"
+#include "File.h"
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+ReadQueue::ReadQueue(int threadCount)
+	: queue("ReadQueue", threadCount,
+	        [this](Job *&job) { process(job); },
+	        [this](Job *&job) { cancel(job); })
+{
+}
+
+ReadQueue::~ReadQueue()
+{
+}
+
+void ReadQueue::add(ReadRequest *request)
+{
+	love::thread::Lock lock(mutex);
+
+	auto it = jobs.find(request->getFilename());
+	if (it != jobs.end())
+	{
+		it->second->requests.push_back(request);
+		return;
+	}
+
+	Job *job = new Job();
+	job->filename = request->getFilename();
+	job->requests.push_back(request);
+
+	jobs[job->filename] = job;
+	queue.push(job);
+}
+
+int ReadQueue::getThreadCount() const
+{
+	return queue.getThreadCount();
+}
+
+void ReadQueue::cancel(Job *job)
+{
+	// Requests which never started are left pending, so anything waiting on
+	// them is released as cancelled instead.
+	{
+		love::thread::Lock lock(mutex);
+		jobs.erase(job->filename);
+	}
+
+	for (const auto &request : job->requests)
+		request->cancel();
+
+	delete job;
+}
+
+void ReadQueue::process(Job *job)
+{
+	File file(job->filename);
+	std::string openerror;
+
+	try
+	{
+		file.open(File::MODE_READ);
+	}
+	catch (love::Exception &e)
+	{
+		openerror = e.what();
+	}
+
+	while (true)
+	{
+		std::vector<StrongRef<ReadRequest>> group;
+
+		{
+			love::thread::Lock lock(mutex);
+
+			// The job is only removed once it's out of requests, so later
+			// requests for this file can keep joining it until then.
+			if (job->requests.empty() || queue.isStopping())
+			{
+				for (const auto &request : job->requests)
+					request->cancel();
+
+				jobs.erase(job->filename);
+				break;
+			}
+
+			// Take every request for the same range as the first one.
+			int64 offset = job->requests[0]->getOffset();
+			int64 size = job->requests[0]->getSize();
+
+			auto &requests = job->requests;
+			for (size_t i = 0; i < requests.size(); )
+			{
+				if (requests[i]->getOffset() == offset && requests[i]->getSize() == size)
+				{
+					group.push_back(requests[i]);
+					requests.erase(requests.begin() + i);
+				}
+				else
+					i++;
+			}
+		}
+
+		bool wanted = false;
+		for (const auto &request : group)
+			wanted = wanted || !request->isComplete();
+
+		if (!wanted)
+			continue;
+
+		if (!openerror.empty())
+		{
+			for (const auto &request : group)
+				request->fail(openerror);
+			continue;
+		}
+
+		const ReadRequest *first = group[0];
+
+		try
+		{
+			StrongRef<FileData> data;
+
+			// Some archives can't seek past the end of a file, so reads which
+			// start there give empty data without seeking.
+			int64 filesize = file.getSize();
+			if (filesize >= 0 && first->getOffset() >= filesize)
+				data.set(new FileData(0, job->filename), Acquire::NORETAIN);
+			else
+			{
+				if (!file.seek((uint64) first->getOffset()))
+					throw love::Exception("Could not seek to position %lld in file %s.", (long long) first->getOffset(), job->filename.c_str());
+
+				data.set(file.read(first->getSize()), Acquire::NORETAIN);
+			}
+
+			// FileData is mutable, so every request gets its own copy.
+			group[0]->complete(data);
+			for (size_t i = 1; i < group.size(); i++)
+			{
+				StrongRef<FileData> copy(data->clone(), Acquire::NORETAIN);
+				group[i]->complete(copy);
+			}
+		}
+		catch (love::Exception &e)
+		{
+			for (const auto &request : group)
+				request->fail(e.what());
+		}
+	}
+
+	delete job;
+}
+
+} // physfs
+} // filesystem
+} // love
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_PHYSFS_READ_QUEUE_H
+#define LOVE_FILESYSTEM_PHYSFS_READ_QUEUE_H
+
+// LOVE
+#include "filesystem/ReadRequest.h"
+#include "thread/threads.h"
+#include "FileQueue.h"
+
+// STD
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+/**
+ * A set of I/O threads which serve ReadRequests. Every thread opens its own
+ * PhysFS handles, so nothing is shared with File objects used elsewhere.
+ *
+ * Requests for a file which is already queued or being read are added to the
+ * same job, so the file is only opened once, and requests for the same part
+ * of a file share a single read (but get separate copies of the data.)
+ **/
+class ReadQueue
+{
+public:
+
+	ReadQueue(int threadCount);
+	~ReadQueue();
+
+	void add(ReadRequest *request);
+
+	int getThreadCount() const;
+
+private:
+
+	struct Job
+	{
+		std::string filename;
+		std::vector<StrongRef<ReadRequest>> requests;
+	};
+
+	void process(Job *job);
+	void cancel(Job *job);
+
+	love::thread::MutexRef mutex;
+
+	// Queued and in-progress jobs, by filename.
+	std::unordered_map<std::string, Job *> jobs;
+
+	// Declared last, so the threads stop before anything they use is gone.
+	FileQueue<Job *> queue;
+
+}; // ReadQueue
+
+} // physfs
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_PHYSFS_READ_QUEUE_H
@@ -24,10 +24,16 @@
 #include "wrap_File.h"
 #include "wrap_DroppedFile.h"
 #include "wrap_FileData.h"
+#include "wrap_ReadRequest.h"
+#include "wrap_HashRequest.h"
 #include "data/wrap_Data.h"
 #include "data/wrap_DataModule.h"
 
 #include "physfs/Filesystem.h"
+#include "timer/Timer.h"
+
+// xxHash
+#include "libraries/xxHash/xxhash.h"
 
 // SDL
 #include <SDL_loadso.h>
@@ -37,6 +43,8 @@
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 namespace love
 {
@@ -338,6 +346,56 @@ int w_newFileData(lua_State *L)
 	return 1;
 }
 
+int w_newMappedFileData(lua_State *L)
+{
+	const char *filename = luaL_checkstring(L, 1);
+
+	FileData *data = nullptr;
+	try
+	{
+		data = instance()->readMapped(filename);
+	}
+	catch (love::Exception &e)
+	{
+		return luax_ioError(L, "%s", e.what());
+	}
+
+	luax_pushtype(L, data);
+	data->release();
+	return 1;
+}
+
+int w_readAsync(lua_State *L)
+{
+	const char *filename = luaL_checkstring(L, 1);
+	int64 offset = (int64) luaL_optnumber(L, 2, 0);
+	int64 size = (int64) luaL_optnumber(L, 3, (lua_Number) File::ALL);
+
+	ReadRequest *request = nullptr;
+	luax_catchexcept(L, [&](){ request = instance()->readAsync(filename, offset, size); });
+
+	luax_pushtype(L, request);
+	request->release();
+	return 1;
+}
+
+int w_hashAsync(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	data::HashFunction::Function function;
+	if (!data::HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", data::HashFunction::getConstants(function), fstr);
+
+	const char *filename = luaL_checkstring(L, 2);
+
+	HashRequest *request = nullptr;
+	luax_catchexcept(L, [&](){ request = instance()->hashAsync(function, filename); });
+
+	luax_pushtype(L, request);
+	request->release();
+	return 1;
+}
+
 int w_getWorkingDirectory(lua_State *L)
 {
 	lua_pushstring(L, instance()->getWorkingDirectory());
@@ -720,6 +778,157 @@ static void replaceAll(std::string &str, const std::string &substr, const std::s
 		str.replace(locations[i], sublen, replacement);
 }
 
+// Folder in the save directory which holds compiled modules for require.
+static const char *REQUIRE_CACHE_DIRECTORY = ".requirecache";
+
+struct RequireCacheHeader
+{
+	char magic[4];
+	uint32 reserved;
+	uint64 sourceHash;
+	uint64 sourceSize;
+};
+
+static const char REQUIRE_CACHE_MAGIC[4] = {'L', 'R', 'C', '1'};
+
+static int bytecodeWriter(lua_State *, const void *p, size_t size, void *ud)
+{
+	((std::string *) ud)->append((const char *) p, size);
+	return 0;
+}
+
+static int dumpFunction(lua_State *L, std::string &out)
+{
+#if LUA_VERSION_NUM >= 503
+	return lua_dump(L, bytecodeWriter, &out, 0);
+#else
+	return lua_dump(L, bytecodeWriter, &out);
+#endif
+}
+
+// Hashes the bytecode of an empty chunk, which identifies the VM's bytecode
+// format. Cached modules compiled by a different VM won't match.
+static uint64 computeBytecodeSeed(lua_State *L)
+{
+	uint64 seed = 0;
+
+	if (luaL_loadbuffer(L, "", 0, "=") == 0)
+	{
+		std::string bytecode;
+		dumpFunction(L, bytecode);
+		seed = XXH64(bytecode.data(), bytecode.size(), 0);
+	}
+
+	lua_pop(L, 1);
+	return seed;
+}
+
+static std::string getRequireCacheFilename(const std::string &chunkname)
+{
+	char name[32];
+	unsigned long long hash = XXH64(chunkname.data(), chunkname.size(), 0);
+	snprintf(name, sizeof(name), "%016llx.luac", hash);
+
+	return std::string(REQUIRE_CACHE_DIRECTORY) + "/" + name;
+}
+
+static bool loadCachedBytecode(lua_State *L, Filesystem *inst, const std::string &cachename, const std::string &chunkname, uint64 hash, uint64 size)
+{
+	Filesystem::Info info = {};
+	if (!inst->getInfo(cachename.c_str(), info) || info.type != Filesystem::FILETYPE_FILE)
+		return false;
+
+	StrongRef<FileData> cached;
+	try
+	{
+		cached.set(inst->read(cachename.c_str()), Acquire::NORETAIN);
+	}
+	catch (love::Exception &)
+	{
+		return false;
+	}
+
+	RequireCacheHeader header;
+	if (cached->getSize() <= sizeof(RequireCacheHeader))
+		return false;
+
+	const char *bytes = (const char *) cached->getData();
+	memcpy(&header, bytes, sizeof(RequireCacheHeader));
+
+	if (memcmp(header.magic, REQUIRE_CACHE_MAGIC, 4) != 0 || header.sourceHash != hash || header.sourceSize != size)
+		return false;
+
+	size_t bytecodesize = cached->getSize() - sizeof(RequireCacheHeader);
+	if (luaL_loadbuffer(L, bytes + sizeof(RequireCacheHeader), bytecodesize, chunkname.c_str()) != 0)
+	{
+		lua_pop(L, 1);
+		return false;
+	}
+
+	return true;
+}
+
+// Expects the compiled chunk on the top of the stack.
+static bool writeCachedBytecode(lua_State *L, Filesystem *inst, const std::string &cachename, uint64 hash, uint64 size)
+{
+	RequireCacheHeader header = {};
+	memcpy(header.magic, REQUIRE_CACHE_MAGIC, 4);
+	header.sourceHash = hash;
+	header.sourceSize = size;
+
+	std::string bytes((const char *) &header, sizeof(RequireCacheHeader));
+	if (dumpFunction(L, bytes) != 0)
+		return false;
+
+	try
+	{
+		if (!inst->createDirectory(REQUIRE_CACHE_DIRECTORY))
+			return false;
+
+		inst->write(cachename.c_str(), bytes.data(), (int64) bytes.size());
+	}
+	catch (love::Exception &)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// Compiles a module's source, or loads its bytecode from the require cache
+// if that was compiled from identical source.
+static int loadRequireFile(lua_State *L, Filesystem *inst, FileData *data, const std::string &filename, Filesystem::RequireStats &stats)
+{
+	std::string chunkname = "@" + filename;
+	const char *source = (const char *) data->getData();
+	uint64 size = (uint64) data->getSize();
+
+	const char *savedir = inst->getSaveDirectory();
+	if (!inst->isRequireCacheEnabled() || savedir == nullptr || savedir[0] == '\0')
+		return luaL_loadbuffer(L, source, (size_t) size, chunkname.c_str());
+
+	// The chunk name is embedded in the bytecode, so it's part of the key.
+	static const uint64 seed = computeBytecodeSeed(L);
+	uint64 hash = XXH64(source, (size_t) size, seed ^ XXH64(chunkname.data(), chunkname.size(), 0));
+
+	std::string cachename = getRequireCacheFilename(chunkname);
+
+	if (loadCachedBytecode(L, inst, cachename, chunkname, hash, size))
+	{
+		stats.cacheHits++;
+		return 0;
+	}
+
+	stats.cacheMisses++;
+
+	int status = luaL_loadbuffer(L, source, (size_t) size, chunkname.c_str());
+
+	if (status == 0 && writeCachedBytecode(L, inst, cachename, hash, size))
+		stats.cacheWrites++;
+
+	return status;
+}
+
 int loader(lua_State *L)
 {
 	std::string modulename = luax_checkstring(L, 1);
@@ -731,22 +940,109 @@ int loader(lua_State *L)
 	}
 
 	auto *inst = instance();
+
+	Filesystem::RequireStats stats = {};
+	stats.requires = 1;
+
+	double start = love::timer::Timer::getTime();
+
+	std::vector<std::string> paths;
 	for (std::string element : inst->getRequirePath())
 	{
 		replaceAll(element, "?", modulename);
+		paths.push_back(element);
+	}
 
-		Filesystem::Info info = {};
-		if (inst->getInfo(element.c_str(), info) && info.type != Filesystem::FILETYPE_DIRECTORY)
-		{
-			lua_pop(L, 1);
-			lua_pushstring(L, element.c_str());
-			return w_load(L);
-		}
+	int found = inst->findFirstFile(paths);
+
+	double resolved = love::timer::Timer::getTime();
+	stats.resolveTime = resolved - start;
+
+	if (found < 0)
+	{
+		inst->addRequireStats(stats);
+
+		std::string errstr = "\n\tno '%s' in LOVE game directories.";
+
+		lua_pushfstring(L, errstr.c_str(), modulename.c_str());
+		return 1;
+	}
+
+	const std::string &filename = paths[found];
+	stats.found = 1;
+
+	StrongRef<FileData> data;
+	try
+	{
+		data.set(inst->read(filename.c_str()), Acquire::NORETAIN);
+	}
+	catch (love::Exception &e)
+	{
+		inst->addRequireStats(stats);
+		return luax_ioError(L, "%s", e.what());
 	}
 
-	std::string errstr = "\n\tno '%s' in LOVE game directories.";
+	int status = loadRequireFile(L, inst, data, filename, stats);
+
+	stats.loadTime = love::timer::Timer::getTime() - resolved;
+	inst->addRequireStats(stats);
+
+	switch (status)
+	{
+	case LUA_ERRMEM:
+		return luaL_error(L, "Memory allocation error: %s\n", lua_tostring(L, -1));
+	case LUA_ERRSYNTAX:
+		return luaL_error(L, "Syntax error: %s\n", lua_tostring(L, -1));
+	default: // success
+		return 1;
+	}
+}
+
+int w_setRequireCacheEnabled(lua_State *L)
+{
+	instance()->setRequireCacheEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isRequireCacheEnabled(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isRequireCacheEnabled());
+	return 1;
+}
+
+int w_getRequireStats(lua_State *L)
+{
+	Filesystem::RequireStats stats = instance()->getRequireStats();
+
+	lua_createtable(L, 0, 9);
+
+	lua_pushnumber(L, (lua_Number) stats.requires);
+	lua_setfield(L, -2, "requires");
+
+	lua_pushnumber(L, (lua_Number) stats.found);
+	lua_setfield(L, -2, "found");
+
+	lua_pushnumber(L, (lua_Number) stats.cacheHits);
+	lua_setfield(L, -2, "cachehits");
+
+	lua_pushnumber(L, (lua_Number) stats.cacheMisses);
+	lua_setfield(L, -2, "cachemisses");
+
+	lua_pushnumber(L, (lua_Number) stats.cacheWrites);
+	lua_setfield(L, -2, "cachewrites");
+
+	lua_pushnumber(L, (lua_Number) stats.indexBuilds);
+	lua_setfield(L, -2, "indexbuilds");
+
+	lua_pushnumber(L, stats.indexTime);
+	lua_setfield(L, -2, "indextime");
+
+	lua_pushnumber(L, stats.resolveTime);
+	lua_setfield(L, -2, "resolvetime");
+
+	lua_pushnumber(L, stats.loadTime);
+	lua_setfield(L, -2, "loadtime");
 
-	lua_pushfstring(L, errstr.c_str(), modulename.c_str());
 	return 1;
 }
 
@@ -946,10 +1242,16 @@ static const luaL_Reg functions[] =
 	{ "setSymlinksEnabled", w_setSymlinksEnabled },
 	{ "areSymlinksEnabled", w_areSymlinksEnabled },
 	{ "newFileData", w_newFileData },
+	{ "newMappedFileData", w_newMappedFileData },
+	{ "readAsync", w_readAsync },
+	{ "hashAsync", w_hashAsync },
 	{ "getRequirePath", w_getRequirePath },
 	{ "setRequirePath", w_setRequirePath },
 	{ "getCRequirePath", w_getCRequirePath },
 	{ "setCRequirePath", w_setCRequirePath },
+	{ "setRequireCacheEnabled", w_setRequireCacheEnabled },
+	{ "isRequireCacheEnabled", w_isRequireCacheEnabled },
+	{ "getRequireStats", w_getRequireStats },
 
 	// Deprecated.
 	{ "exists", w_exists },
@@ -967,6 +1269,8 @@ static const lua_CFunction types[] =
 	luaopen_file,
 	luaopen_droppedfile,
 	luaopen_filedata,
+	luaopen_readrequest,
+	luaopen_hashrequest,
 	0
 };
 
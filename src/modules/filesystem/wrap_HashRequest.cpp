@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_HashRequest.h"
+#include "wrap_File.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+HashRequest *luax_checkhashrequest(lua_State *L, int idx)
+{
+	return luax_checktype<HashRequest>(L, idx);
+}
+
+int w_HashRequest_getFilename(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+	lua_pushstring(L, t->getFilename().c_str());
+	return 1;
+}
+
+int w_HashRequest_getFunction(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+
+	const char *fname = nullptr;
+	if (!data::HashFunction::getConstant(t->getFunction(), fname))
+		return luax_enumerror(L, "hash function", data::HashFunction::getConstants(data::HashFunction::FUNCTION_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+int w_HashRequest_isComplete(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+	luax_pushboolean(L, t->isComplete());
+	return 1;
+}
+
+int w_HashRequest_getHash(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+
+	switch (t->getStatus())
+	{
+	case HashRequest::STATUS_PENDING:
+		lua_pushnil(L);
+		return 1;
+	case HashRequest::STATUS_COMPLETE:
+	{
+		std::string hash = t->getHash();
+		lua_pushlstring(L, hash.data(), hash.size());
+		return 1;
+	}
+	default:
+		return luax_ioError(L, "%s", t->getError().c_str());
+	}
+}
+
+int w_HashRequest_getProgress(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+
+	int64 processed = 0;
+	int64 total = 0;
+	t->getProgress(processed, total);
+
+	lua_pushnumber(L, (lua_Number) processed);
+
+	if (total >= 0)
+		lua_pushnumber(L, (lua_Number) total);
+	else
+		lua_pushnil(L);
+
+	return 2;
+}
+
+int w_HashRequest_cancel(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+	luax_pushboolean(L, t->cancel());
+	return 1;
+}
+
+int w_HashRequest_wait(lua_State *L)
+{
+	HashRequest *t = luax_checkhashrequest(L, 1);
+	t->wait();
+	return 0;
+}
+
+static const luaL_Reg w_HashRequest_functions[] =
+{
+	{ "getFilename", w_HashRequest_getFilename },
+	{ "getFunction", w_HashRequest_getFunction },
+	{ "isComplete", w_HashRequest_isComplete },
+	{ "getHash", w_HashRequest_getHash },
+	{ "getProgress", w_HashRequest_getProgress },
+	{ "cancel", w_HashRequest_cancel },
+	{ "wait", w_HashRequest_wait },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_hashrequest(lua_State *L)
+{
+	return luax_register_type(L, &HashRequest::type, w_HashRequest_functions, nullptr);
+}
+
+} // filesystem
+} // love
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_ReadRequest.h"
+#include "wrap_File.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+ReadRequest *luax_checkreadrequest(lua_State *L, int idx)
+{
+	return luax_checktype<ReadRequest>(L, idx);
+}
+
+int w_ReadRequest_getFilename(lua_State *L)
+{
+	ReadRequest *t = luax_checkreadrequest(L, 1);
+	lua_pushstring(L, t->getFilename().c_str());
+	return 1;
+}
+
+int w_ReadRequest_isComplete(lua_State *L)
+{
+	ReadRequest *t = luax_checkreadrequest(L, 1);
+	luax_pushboolean(L, t->isComplete());
+	return 1;
+}
+
+int w_ReadRequest_getData(lua_State *L)
+{
+	ReadRequest *t = luax_checkreadrequest(L, 1);
+
+	switch (t->getStatus())
+	{
+	case ReadRequest::STATUS_PENDING:
+		lua_pushnil(L);
+		return 1;
+	case ReadRequest::STATUS_COMPLETE:
+		luax_pushtype(L, t->getData());
+		return 1;
+	default:
+		return luax_ioError(L, "%s", t->getError().c_str());
+	}
+}
+
+int w_ReadRequest_cancel(lua_State *L)
+{
+	ReadRequest *t = luax_checkreadrequest(L, 1);
+	luax_pushboolean(L, t->cancel());
+	return 1;
+}
+
+int w_ReadRequest_wait(lua_State *L)
+{
+	ReadRequest *t = luax_checkreadrequest(L, 1);
+	t->wait();
+	return 0;
+}
+
+static const luaL_Reg w_ReadRequest_functions[] =
+{
+	{ "getFilename", w_ReadRequest_getFilename },
+	{ "isComplete", w_ReadRequest_isComplete },
+	{ "getData", w_ReadRequest_getData },
+	{ "cancel", w_ReadRequest_cancel },
+	{ "wait", w_ReadRequest_wait },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_readrequest(lua_State *L)
+{
+	return luax_register_type(L, &ReadRequest::type, w_ReadRequest_functions, nullptr);
+}
+
+} // filesystem
+} // love
@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "AABBTree.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace math
+{
+
+love::Type AABBTree::type("AABBTree", &SpatialIndex::type);
+
+AABBTree::AABBTree(float margin)
+{
+	if (margin < 0.0f)
+		throw love::Exception("The margin of an AABBTree cannot be negative.");
+
+	tree.SetAABBExtension(margin);
+}
+
+AABBTree::~AABBTree()
+{
+}
+
+float AABBTree::getMargin() const
+{
+	return tree.GetAABBExtension();
+}
+
+b2AABB AABBTree::toAABB(float x, float y, float w, float h)
+{
+	if (w < 0.0f || h < 0.0f)
+		throw love::Exception("Rectangle dimensions cannot be negative.");
+
+	b2AABB aabb;
+	aabb.lowerBound = b2Vec2(x, y);
+	aabb.upperBound = b2Vec2(x + w, y + h);
+	return aabb;
+}
+
+void AABBTree::add(int id, float x, float y, float w, float h)
+{
+	if (proxies.find(id) != proxies.end())
+		throw love::Exception("A rectangle with id %d already exists.", id);
+
+	b2AABB aabb = toAABB(x, y, w, h);
+	int32 proxy = tree.CreateProxy(aabb, nullptr);
+
+	if ((size_t) proxy >= leaves.size())
+		leaves.resize(proxy + 1);
+
+	leaves[proxy].id = id;
+	leaves[proxy].aabb = aabb;
+	proxies[id] = proxy;
+}
+
+void AABBTree::move(int id, float x, float y, float w, float h, float dx, float dy)
+{
+	auto it = proxies.find(id);
+	if (it == proxies.end())
+		throw love::Exception("No rectangle with id %d exists.", id);
+
+	b2AABB aabb = toAABB(x, y, w, h);
+	leaves[it->second].aabb = aabb;
+	tree.MoveProxy(it->second, aabb, b2Vec2(dx, dy));
+}
+
+bool AABBTree::remove(int id)
+{
+	auto it = proxies.find(id);
+	if (it == proxies.end())
+		return false;
+
+	tree.DestroyProxy(it->second);
+	proxies.erase(it);
+	return true;
+}
+
+bool AABBTree::getRect(int id, float &x, float &y, float &w, float &h) const
+{
+	auto it = proxies.find(id);
+	if (it == proxies.end())
+		return false;
+
+	const b2AABB &aabb = leaves[it->second].aabb;
+	x = aabb.lowerBound.x;
+	y = aabb.lowerBound.y;
+	w = aabb.upperBound.x - aabb.lowerBound.x;
+	h = aabb.upperBound.y - aabb.lowerBound.y;
+	return true;
+}
+
+int AABBTree::getCount() const
+{
+	return (int) proxies.size();
+}
+
+void AABBTree::clear()
+{
+	for (const auto &p : proxies)
+		tree.DestroyProxy(p.second);
+
+	proxies.clear();
+}
+
+struct AABBTree::TreeQuery
+{
+	const AABBTree *owner;
+	b2AABB aabb;
+	std::vector<int> *ids;
+
+	bool QueryCallback(int32 proxy)
+	{
+		// The tree only knows the fat bounds.
+		const Leaf &leaf = owner->leaves[proxy];
+		if (b2TestOverlap(leaf.aabb, aabb))
+			ids->push_back(leaf.id);
+		return true;
+	}
+};
+
+struct AABBTree::TreeRayCast
+{
+	const AABBTree *owner;
+	int ray;
+	std::vector<RayHit> *hits;
+
+	float32 RayCastCallback(const b2RayCastInput &input, int32 proxy)
+	{
+		const Leaf &leaf = owner->leaves[proxy];
+		b2Vec2 d = input.p2 - input.p1;
+
+		// Slab test against the exact bounds.
+		float tmin = 0.0f;
+		float tmax = input.maxFraction;
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			float p = axis == 0 ? input.p1.x : input.p1.y;
+			float v = axis == 0 ? d.x : d.y;
+			float lower = axis == 0 ? leaf.aabb.lowerBound.x : leaf.aabb.lowerBound.y;
+			float upper = axis == 0 ? leaf.aabb.upperBound.x : leaf.aabb.upperBound.y;
+
+			if (v == 0.0f)
+			{
+				if (p < lower || p > upper)
+					return input.maxFraction;
+			}
+			else
+			{
+				float t1 = (lower - p) / v;
+				float t2 = (upper - p) / v;
+				if (t1 > t2)
+					std::swap(t1, t2);
+
+				tmin = std::max(tmin, t1);
+				tmax = std::min(tmax, t2);
+				if (tmin > tmax)
+					return input.maxFraction;
+			}
+		}
+
+		RayHit hit = {(int32) ray, (int32) leaf.id, tmin};
+		hits->push_back(hit);
+
+		// Keep going, every hit is wanted.
+		return input.maxFraction;
+	}
+};
+
+void AABBTree::query(float x, float y, float w, float h, std::vector<int> &ids) const
+{
+	TreeQuery callback;
+	callback.owner = this;
+	callback.aabb.lowerBound = b2Vec2(x, y);
+	callback.aabb.upperBound = b2Vec2(x + std::max(w, 0.0f), y + std::max(h, 0.0f));
+	callback.ids = &ids;
+
+	tree.Query(&callback, callback.aabb);
+}
+
+void AABBTree::rayCast(float x1, float y1, float x2, float y2, int ray, std::vector<RayHit> &hits) const
+{
+	// Box2D can't cast rays of zero length.
+	if (x1 == x2 && y1 == y2)
+		return;
+
+	size_t first = hits.size();
+
+	TreeRayCast callback;
+	callback.owner = this;
+	callback.ray = ray;
+	callback.hits = &hits;
+
+	b2RayCastInput input;
+	input.p1 = b2Vec2(x1, y1);
+	input.p2 = b2Vec2(x2, y2);
+	input.maxFraction = 1.0f;
+
+	tree.RayCast(&callback, input);
+
+	std::stable_sort(hits.begin() + first, hits.end(), [](const RayHit &a, const RayHit &b)
+	{
+		return a.fraction < b.fraction;
+	});
+}
+
+int AABBTree::rayCastBatch(const float *rays, int rayCount, RayHit *hits, int maxHits, bool &complete) const
+{
+	int count = 0;
+	complete = true;
+
+	for (int i = 0; i < rayCount; i++)
+	{
+		const float *r = rays + i * 4;
+
+		rayHits.clear();
+		rayCast(r[0], r[1], r[2], r[3], i + 1, rayHits);
+
+		for (const RayHit &hit : rayHits)
+		{
+			if (count >= maxHits)
+			{
+				complete = false;
+				return count;
+			}
+
+			hits[count++] = hit;
+		}
+	}
+
+	return count;
+}
+
+} // math
+} // love
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "SpatialIndex.h"
+
+// Box2D
+#include <Box2D/Collision/b2DynamicTree.h>
+
+// C++
+#include <unordered_map>
+
+namespace love
+{
+namespace math
+{
+
+/**
+ * A SpatialIndex backed by Box2D's dynamic AABB tree. Good for rectangles of
+ * very different sizes, and supports ray casts.
+ **/
+class AABBTree : public SpatialIndex
+{
+public:
+
+	static love::Type type;
+
+	/**
+	 * A hit written by rayCastBatch. Hits of each ray are sorted by fraction.
+	 **/
+	struct RayHit
+	{
+		int32 ray; // Index of the ray, starting at 1.
+		int32 id;
+		float fraction;
+	};
+
+	/**
+	 * @param margin How far the stored bounds extend past each rectangle, so
+	 * small movements don't need to change the tree.
+	 **/
+	AABBTree(float margin);
+	virtual ~AABBTree();
+
+	float getMargin() const;
+
+	// Implements SpatialIndex.
+	void add(int id, float x, float y, float w, float h) override;
+	void move(int id, float x, float y, float w, float h, float dx, float dy) override;
+	bool remove(int id) override;
+	bool getRect(int id, float &x, float &y, float &w, float &h) const override;
+	int getCount() const override;
+	void clear() override;
+	void query(float x, float y, float w, float h, std::vector<int> &ids) const override;
+
+	/**
+	 * Finds the rectangles a line segment passes through, sorted by the
+	 * fraction along the segment where it enters them. Rectangles containing
+	 * the start of the segment are hit at fraction 0.
+	 * @param ray Index stored in the hits.
+	 **/
+	void rayCast(float x1, float y1, float x2, float y2, int ray, std::vector<RayHit> &hits) const;
+
+	/**
+	 * Casts many rays at once.
+	 * @param rays x1, y1, x2, y2 for each ray.
+	 * @param rayCount The number of rays.
+	 * @param hits Receives the hits of all rays.
+	 * @param maxHits The number of hits which fit in the hits array.
+	 * @param[out] complete False if some hits did not fit.
+	 * @return The number of hits written.
+	 **/
+	int rayCastBatch(const float *rays, int rayCount, RayHit *hits, int maxHits, bool &complete) const;
+
+private:
+
+	struct Leaf
+	{
+		int id;
+		b2AABB aabb;
+	};
+
+	struct TreeQuery;
+	struct TreeRayCast;
+
+	static b2AABB toAABB(float x, float y, float w, float h);
+
+	b2DynamicTree tree;
+
+	// Leaves by proxy id, and proxy ids by user id.
+	std::vector<Leaf> leaves;
+	std::unordered_map<int, int32> proxies;
+
+	// Reused by rayCastBatch.
+	mutable std::vector<RayHit> rayHits;
+
+}; // AABBTree
+
+} // math
+} // love
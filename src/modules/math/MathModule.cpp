@@ -25,6 +25,8 @@
 #include "common/StringMap.h"
 #include "BezierCurve.h"
 #include "Transform.h"
+#include "AABBTree.h"
+#include "SpatialHash.h"
 
 // STL
 #include <cmath>
@@ -231,5 +233,15 @@ Transform *Math::newTransform(float x, float y, float a, float sx, float sy, flo
 	return new Transform(x, y, a, sx, sy, ox, oy, kx, ky);
 }
 
+AABBTree *Math::newAABBTree(float margin)
+{
+	return new AABBTree(margin);
+}
+
+SpatialHash *Math::newSpatialHash(float cellSize)
+{
+	return new SpatialHash(cellSize);
+}
+
 } // math
 } // love
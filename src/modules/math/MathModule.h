@@ -43,6 +43,8 @@ namespace math
 
 class BezierCurve;
 class Transform;
+class AABBTree;
+class SpatialHash;
 
 struct Triangle
 {
@@ -114,6 +116,16 @@ public:
 	Transform *newTransform();
 	Transform *newTransform(float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
 
+	/**
+	 * Creates a new AABB tree, for finding overlapping rectangles.
+	 **/
+	AABBTree *newAABBTree(float margin);
+
+	/**
+	 * Creates a new spatial hash, for finding overlapping rectangles.
+	 **/
+	SpatialHash *newSpatialHash(float cellSize);
+
 	// Implements Module.
 	virtual ModuleType getModuleType() const
 	{
@@ -0,0 +1,469 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "NoiseFill.h"
+#include "common/config.h"
+#include "common/int.h"
+#include "common/Exception.h"
+#include "thread/threads.h"
+#include "libraries/noise1234/noise1234.h"
+#include "libraries/noise1234/simplexnoise1234.h"
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace love
+{
+namespace math
+{
+
+// Below this many samples (times octaves) a fill runs on the calling thread.
+static const int64 MIN_PARALLEL_NOISE_SAMPLES = 1 << 16;
+
+// Approximate number of samples computed by each parallel task.
+static const int NOISE_SAMPLES_PER_TASK = 1 << 14;
+
+static const int MAX_NOISE_OCTAVES = 32;
+
+namespace
+{
+
+// Four-lane float and int vectors. The SIMD noise kernels below are written
+// once against these, and match the noise library up to float rounding.
+
+#if defined(LOVE_SIMD_SSE2)
+
+struct Float4 { __m128 v; };
+struct Int4 { __m128i v; };
+
+inline Float4 splat(float f) { return {_mm_set1_ps(f)}; }
+inline Int4 splati(int32 i) { return {_mm_set1_epi32(i)}; }
+inline Float4 ramp() { return {_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)}; }
+
+inline Float4 operator + (Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator - (Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator * (Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float4 vmax(Float4 a, Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Float4 vmin(Float4 a, Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float4 vabs(Float4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+
+inline Int4 operator + (Int4 a, Int4 b) { return {_mm_add_epi32(a.v, b.v)}; }
+inline Int4 operator - (Int4 a, Int4 b) { return {_mm_sub_epi32(a.v, b.v)}; }
+inline Int4 operator & (Int4 a, Int4 b) { return {_mm_and_si128(a.v, b.v)}; }
+inline Int4 operator | (Int4 a, Int4 b) { return {_mm_or_si128(a.v, b.v)}; }
+template <int N> inline Int4 shiftLeft(Int4 a) { return {_mm_slli_epi32(a.v, N)}; }
+
+// Masks are all bits set where the comparison is true.
+inline Int4 greater(Float4 a, Float4 b) { return {_mm_castps_si128(_mm_cmpgt_ps(a.v, b.v))}; }
+inline Int4 less(Int4 a, Int4 b) { return {_mm_cmplt_epi32(a.v, b.v)}; }
+inline Int4 equal(Int4 a, Int4 b) { return {_mm_cmpeq_epi32(a.v, b.v)}; }
+
+inline Float4 select(Int4 mask, Float4 a, Float4 b)
+{
+	__m128 m = _mm_castsi128_ps(mask.v);
+	return {_mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v))};
+}
+
+// Flips the sign of the lanes which have bit 31 set in bits.
+inline Float4 flipSign(Float4 a, Int4 bits) { return {_mm_xor_ps(a.v, _mm_castsi128_ps(bits.v))}; }
+
+inline Int4 truncate(Float4 a) { return {_mm_cvttps_epi32(a.v)}; }
+inline Float4 toFloat(Int4 a) { return {_mm_cvtepi32_ps(a.v)}; }
+
+inline void store(float *dst, Float4 a) { _mm_storeu_ps(dst, a.v); }
+inline void store(int32 *dst, Int4 a) { _mm_storeu_si128((__m128i *) dst, a.v); }
+inline Int4 loadi(const int32 *src) { return {_mm_loadu_si128((const __m128i *) src)}; }
+
+#elif defined(LOVE_SIMD_NEON)
+
+struct Float4 { float32x4_t v; };
+struct Int4 { int32x4_t v; };
+
+inline Float4 splat(float f) { return {vdupq_n_f32(f)}; }
+inline Int4 splati(int32 i) { return {vdupq_n_s32(i)}; }
+inline Float4 ramp() { static const float r[4] = {0.0f, 1.0f, 2.0f, 3.0f}; return {vld1q_f32(r)}; }
+
+inline Float4 operator + (Float4 a, Float4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline Float4 operator - (Float4 a, Float4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline Float4 operator * (Float4 a, Float4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline Float4 vmax(Float4 a, Float4 b) { return {vmaxq_f32(a.v, b.v)}; }
+inline Float4 vmin(Float4 a, Float4 b) { return {vminq_f32(a.v, b.v)}; }
+inline Float4 vabs(Float4 a) { return {vabsq_f32(a.v)}; }
+
+inline Int4 operator + (Int4 a, Int4 b) { return {vaddq_s32(a.v, b.v)}; }
+inline Int4 operator - (Int4 a, Int4 b) { return {vsubq_s32(a.v, b.v)}; }
+inline Int4 operator & (Int4 a, Int4 b) { return {vandq_s32(a.v, b.v)}; }
+inline Int4 operator | (Int4 a, Int4 b) { return {vorrq_s32(a.v, b.v)}; }
+template <int N> inline Int4 shiftLeft(Int4 a) { return {vshlq_n_s32(a.v, N)}; }
+
+inline Int4 greater(Float4 a, Float4 b) { return {vreinterpretq_s32_u32(vcgtq_f32(a.v, b.v))}; }
+inline Int4 less(Int4 a, Int4 b) { return {vreinterpretq_s32_u32(vcltq_s32(a.v, b.v))}; }
+inline Int4 equal(Int4 a, Int4 b) { return {vreinterpretq_s32_u32(vceqq_s32(a.v, b.v))}; }
+
+inline Float4 select(Int4 mask, Float4 a, Float4 b) { return {vbslq_f32(vreinterpretq_u32_s32(mask.v), a.v, b.v)}; }
+
+inline Float4 flipSign(Float4 a, Int4 bits)
+{
+	return {vreinterpretq_f32_s32(veorq_s32(vreinterpretq_s32_f32(a.v), bits.v))};
+}
+
+inline Int4 truncate(Float4 a) { return {vcvtq_s32_f32(a.v)}; }
+inline Float4 toFloat(Int4 a) { return {vcvtq_f32_s32(a.v)}; }
+
+inline void store(float *dst, Float4 a) { vst1q_f32(dst, a.v); }
+inline void store(int32 *dst, Int4 a) { vst1q_s32(dst, a.v); }
+inline Int4 loadi(const int32 *src) { return {vld1q_s32(src)}; }
+
+#else
+
+struct Float4 { float v[4]; };
+
+#define LOVE_LANES(expr) for (int l = 0; l < 4; l++) { expr; }
+
+inline Float4 splat(float f) { return {{f, f, f, f}}; }
+inline Float4 ramp() { return {{0.0f, 1.0f, 2.0f, 3.0f}}; }
+
+inline Float4 operator + (Float4 a, Float4 b) { Float4 r; LOVE_LANES(r.v[l] = a.v[l] + b.v[l]); return r; }
+inline Float4 operator - (Float4 a, Float4 b) { Float4 r; LOVE_LANES(r.v[l] = a.v[l] - b.v[l]); return r; }
+inline Float4 operator * (Float4 a, Float4 b) { Float4 r; LOVE_LANES(r.v[l] = a.v[l] * b.v[l]); return r; }
+inline Float4 vmax(Float4 a, Float4 b) { Float4 r; LOVE_LANES(r.v[l] = a.v[l] > b.v[l] ? a.v[l] : b.v[l]); return r; }
+inline Float4 vmin(Float4 a, Float4 b) { Float4 r; LOVE_LANES(r.v[l] = a.v[l] < b.v[l] ? a.v[l] : b.v[l]); return r; }
+inline Float4 vabs(Float4 a) { Float4 r; LOVE_LANES(r.v[l] = std::abs(a.v[l])); return r; }
+
+inline void store(float *dst, Float4 a) { LOVE_LANES(dst[l] = a.v[l]); }
+
+#endif
+
+#if defined(LOVE_SIMD_SSE2) || defined(LOVE_SIMD_NEON)
+
+// Table lookups have no SIMD equivalent on these targets, so they're done
+// one lane at a time.
+inline Int4 lookup(Int4 index)
+{
+	const unsigned char *perm = Noise1234::perm;
+
+	int32 i[4];
+	store(i, index);
+
+	int32 r[4] = {perm[i[0]], perm[i[1]], perm[i[2]], perm[i[3]]};
+	return loadi(r);
+}
+
+// Same as FASTFLOOR in noise1234, including its result for whole numbers
+// which aren't positive.
+inline Int4 fastFloor(Float4 x)
+{
+	Int4 positive = greater(x, splat(0.0f));
+	return truncate(x) + (splati(-1) - positive);
+}
+
+inline Float4 fade(Float4 t)
+{
+	return t * t * t * (t * (t * splat(6.0f) - splat(15.0f)) + splat(10.0f));
+}
+
+inline Float4 lerp(Float4 t, Float4 a, Float4 b)
+{
+	return a + t * (b - a);
+}
+
+// SimplexNoise1234::grad(hash, x, y)
+inline Float4 grad2(Int4 hash, Float4 x, Float4 y)
+{
+	Int4 h = hash & splati(7);
+	Int4 low = less(h, splati(4));
+
+	Float4 u = select(low, x, y);
+	Float4 v = select(low, y, x) * splat(2.0f);
+
+	return flipSign(u, shiftLeft<31>(h & splati(1))) + flipSign(v, shiftLeft<30>(h & splati(2)));
+}
+
+// Noise1234::grad(hash, x, y, z)
+inline Float4 grad3(Int4 hash, Float4 x, Float4 y, Float4 z)
+{
+	Int4 h = hash & splati(15);
+	Int4 usex = equal(h, splati(12)) | equal(h, splati(14));
+
+	Float4 u = select(less(h, splati(8)), x, y);
+	Float4 v = select(less(h, splati(4)), y, select(usex, x, z));
+
+	return flipSign(u, shiftLeft<31>(h & splati(1))) + flipSign(v, shiftLeft<30>(h & splati(2)));
+}
+
+// SimplexNoise1234::noise(x, y), in [-1, 1].
+Float4 simplex2(Float4 x, Float4 y)
+{
+	const float F2 = 0.366025403f;
+	const float G2 = 0.211324865f;
+
+	// Skew the input space to find the simplex cell.
+	Float4 s = (x + y) * splat(F2);
+	Int4 i = fastFloor(x + s);
+	Int4 j = fastFloor(y + s);
+
+	Float4 t = toFloat(i + j) * splat(G2);
+	Float4 x0 = x - (toFloat(i) - t);
+	Float4 y0 = y - (toFloat(j) - t);
+
+	// Offsets of the middle corner: (1, 0) in the lower triangle, else (0, 1).
+	Int4 i1 = greater(x0, y0) & splati(1);
+	Int4 j1 = splati(1) - i1;
+
+	Float4 x1 = x0 - toFloat(i1) + splat(G2);
+	Float4 y1 = y0 - toFloat(j1) + splat(G2);
+	Float4 x2 = x0 - splat(1.0f) + splat(2.0f * G2);
+	Float4 y2 = y0 - splat(1.0f) + splat(2.0f * G2);
+
+	Int4 ii = i & splati(0xFF);
+	Int4 jj = j & splati(0xFF);
+
+	Int4 g0 = lookup(ii + lookup(jj));
+	Int4 g1 = lookup(ii + i1 + lookup(jj + j1));
+	Int4 g2 = lookup(ii + splati(1) + lookup(jj + splati(1)));
+
+	Float4 zero = splat(0.0f);
+	Float4 half = splat(0.5f);
+
+	Float4 t0 = vmax(half - x0 * x0 - y0 * y0, zero);
+	Float4 t1 = vmax(half - x1 * x1 - y1 * y1, zero);
+	Float4 t2 = vmax(half - x2 * x2 - y2 * y2, zero);
+
+	t0 = t0 * t0;
+	t1 = t1 * t1;
+	t2 = t2 * t2;
+
+	Float4 n0 = t0 * t0 * grad2(g0, x0, y0);
+	Float4 n1 = t1 * t1 * grad2(g1, x1, y1);
+	Float4 n2 = t2 * t2 * grad2(g2, x2, y2);
+
+	return splat(45.23f) * (n0 + n1 + n2);
+}
+
+// Noise1234::noise(x, y, z), in [-1, 1].
+Float4 perlin3(Float4 x, Float4 y, Float4 z)
+{
+	Int4 ix0 = fastFloor(x);
+	Int4 iy0 = fastFloor(y);
+	Int4 iz0 = fastFloor(z);
+
+	Float4 fx0 = x - toFloat(ix0);
+	Float4 fy0 = y - toFloat(iy0);
+	Float4 fz0 = z - toFloat(iz0);
+	Float4 fx1 = fx0 - splat(1.0f);
+	Float4 fy1 = fy0 - splat(1.0f);
+	Float4 fz1 = fz0 - splat(1.0f);
+
+	Int4 mask = splati(0xFF);
+	Int4 ix1 = (ix0 + splati(1)) & mask;
+	Int4 iy1 = (iy0 + splati(1)) & mask;
+	Int4 iz1 = (iz0 + splati(1)) & mask;
+	ix0 = ix0 & mask;
+	iy0 = iy0 & mask;
+	iz0 = iz0 & mask;
+
+	Float4 r = fade(fz0);
+	Float4 t = fade(fy0);
+	Float4 s = fade(fx0);
+
+	Int4 pz0 = lookup(iz0);
+	Int4 pz1 = lookup(iz1);
+	Int4 py00 = lookup(iy0 + pz0);
+	Int4 py01 = lookup(iy0 + pz1);
+	Int4 py10 = lookup(iy1 + pz0);
+	Int4 py11 = lookup(iy1 + pz1);
+
+	Float4 nxy0, nxy1, nx0, nx1;
+
+	nxy0 = grad3(lookup(ix0 + py00), fx0, fy0, fz0);
+	nxy1 = grad3(lookup(ix0 + py01), fx0, fy0, fz1);
+	nx0 = lerp(r, nxy0, nxy1);
+
+	nxy0 = grad3(lookup(ix0 + py10), fx0, fy1, fz0);
+	nxy1 = grad3(lookup(ix0 + py11), fx0, fy1, fz1);
+	nx1 = lerp(r, nxy0, nxy1);
+
+	Float4 n0 = lerp(t, nx0, nx1);
+
+	nxy0 = grad3(lookup(ix1 + py00), fx1, fy0, fz0);
+	nxy1 = grad3(lookup(ix1 + py01), fx1, fy0, fz1);
+	nx0 = lerp(r, nxy0, nxy1);
+
+	nxy0 = grad3(lookup(ix1 + py10), fx1, fy1, fz0);
+	nxy1 = grad3(lookup(ix1 + py11), fx1, fy1, fz1);
+	nx1 = lerp(r, nxy0, nxy1);
+
+	Float4 n1 = lerp(t, nx0, nx1);
+
+	return splat(0.936f) * lerp(s, n0, n1);
+}
+
+#else
+
+// Without SIMD, the noise library is called one lane at a time.
+
+Float4 simplex2(Float4 x, Float4 y)
+{
+	Float4 r;
+	LOVE_LANES(r.v[l] = SimplexNoise1234::noise(x.v[l], y.v[l]));
+	return r;
+}
+
+Float4 perlin3(Float4 x, Float4 y, Float4 z)
+{
+	Float4 r;
+	LOVE_LANES(r.v[l] = Noise1234::noise(x.v[l], y.v[l], z.v[l]));
+	return r;
+}
+
+#undef LOVE_LANES
+
+#endif
+
+struct Octave
+{
+	float frequency;
+	float amplitude;
+};
+
+// Computes one row, rounded up to a multiple of 4 samples.
+void fillRow(const NoiseFillParams &p, const std::vector<Octave> &octaves, float amplitudeScale, int y, int width, float *row)
+{
+	Float4 zero = splat(0.0f);
+	Float4 one = splat(1.0f);
+
+	Float4 sy = splat(p.y + (float) y * p.scaleY);
+	Float4 sz = splat(p.z);
+
+	for (int x = 0; x < width; x += 4)
+	{
+		Float4 sx = splat(p.x) + (splat((float) x) + ramp()) * splat(p.scaleX);
+		Float4 sum = zero;
+
+		for (const Octave &o : octaves)
+		{
+			Float4 f = splat(o.frequency);
+			Float4 n = p.dimensions == 3 ? perlin3(sx * f, sy * f, sz * f) : simplex2(sx * f, sy * f);
+
+			if (p.fractal == NOISE_FRACTAL_RIDGED)
+			{
+				n = one - vabs(n);
+				n = n * n;
+			}
+			else if (p.fractal == NOISE_FRACTAL_TURBULENCE)
+				n = vabs(n);
+
+			sum = sum + n * splat(o.amplitude);
+		}
+
+		sum = sum * splat(amplitudeScale);
+
+		// fBm is signed, so it's moved into [0, 1] like love.math.noise.
+		if (p.fractal == NOISE_FRACTAL_FBM)
+			sum = sum * splat(0.5f) + splat(0.5f);
+
+		store(row + x, vmin(vmax(sum, zero), one));
+	}
+}
+
+} // anonymous namespace
+
+void noiseFill(const NoiseFillParams &params, int width, int height, const std::function<void(int, const float *)> &rowFunc)
+{
+	if (width <= 0 || height <= 0)
+		throw love::Exception("Invalid noise fill dimensions: %d x %d.", width, height);
+
+	if (params.dimensions != 2 && params.dimensions != 3)
+		throw love::Exception("Noise fill only supports 2 or 3 dimensions.");
+
+	if (params.octaves < 1 || params.octaves > MAX_NOISE_OCTAVES)
+		throw love::Exception("The number of noise octaves must be between 1 and %d.", MAX_NOISE_OCTAVES);
+
+	std::vector<Octave> octaves(params.octaves);
+
+	float frequency = 1.0f;
+	float amplitude = 1.0f;
+	float amplitudeSum = 0.0f;
+
+	for (Octave &o : octaves)
+	{
+		o.frequency = frequency;
+		o.amplitude = amplitude;
+		amplitudeSum += std::abs(amplitude);
+		frequency *= params.lacunarity;
+		amplitude *= params.gain;
+	}
+
+	float amplitudeScale = amplitudeSum > 0.0f ? 1.0f / amplitudeSum : 0.0f;
+
+	int paddedWidth = (width + 3) & ~3;
+	int rowsPerTask = std::max(1, NOISE_SAMPLES_PER_TASK / paddedWidth);
+	int taskCount = (height + rowsPerTask - 1) / rowsPerTask;
+
+	int64 work = (int64) paddedWidth * height * params.octaves;
+	int threadCount = work >= MIN_PARALLEL_NOISE_SAMPLES ? love::thread::getProcessorCount() : 1;
+
+	love::thread::parallelFor(taskCount, threadCount, [&](int task)
+	{
+		std::vector<float> row(paddedWidth);
+
+		int endY = std::min(height, (task + 1) * rowsPerTask);
+		for (int y = task * rowsPerTask; y < endY; y++)
+		{
+			fillRow(params, octaves, amplitudeScale, y, paddedWidth, row.data());
+			rowFunc(y, row.data());
+		}
+	});
+}
+
+static StringMap<NoiseFractal, NOISE_FRACTAL_MAX_ENUM>::Entry fractalEntries[] =
+{
+	{ "fbm",        NOISE_FRACTAL_FBM        },
+	{ "ridged",     NOISE_FRACTAL_RIDGED     },
+	{ "turbulence", NOISE_FRACTAL_TURBULENCE },
+};
+
+static StringMap<NoiseFractal, NOISE_FRACTAL_MAX_ENUM> fractals(fractalEntries, sizeof(fractalEntries));
+
+bool getConstant(const char *in, NoiseFractal &out)
+{
+	return fractals.find(in, out);
+}
+
+bool getConstant(NoiseFractal in, const char *&out)
+{
+	return fractals.find(in, out);
+}
+
+std::vector<std::string> getConstants(NoiseFractal)
+{
+	return fractals.getNames();
+}
+
+} // math
+} // love
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/StringMap.h"
+
+// STL
+#include <functional>
+#include <vector>
+#include <string>
+
+namespace love
+{
+namespace math
+{
+
+enum NoiseFractal
+{
+	NOISE_FRACTAL_FBM,
+	NOISE_FRACTAL_RIDGED,
+	NOISE_FRACTAL_TURBULENCE,
+	NOISE_FRACTAL_MAX_ENUM
+};
+
+struct NoiseFillParams
+{
+	NoiseFractal fractal = NOISE_FRACTAL_FBM;
+
+	// 2 uses simplex noise and 3 uses Perlin noise, like love.math.noise.
+	int dimensions = 2;
+
+	int octaves = 1;
+
+	// Frequency and amplitude multipliers between octaves.
+	float lacunarity = 2.0f;
+	float gain = 0.5f;
+
+	// Noise coordinates of the first sample. z is only used in 3D.
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+
+	// Distance between neighbouring samples, in noise coordinates.
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+};
+
+/**
+ * Fills a width x height grid with fractal noise in the range of [0, 1].
+ *
+ * A single octave of fBm gives the same values as noise2 and noise3, up to
+ * float rounding. Rows are computed on several threads for large grids.
+ *
+ * @param rowFunc Called with the index and the samples of each row. It can
+ *        be called from several threads at once.
+ **/
+void noiseFill(const NoiseFillParams &params, int width, int height, const std::function<void(int, const float *)> &rowFunc);
+
+bool getConstant(const char *in, NoiseFractal &out);
+bool getConstant(NoiseFractal in, const char *&out);
+std::vector<std::string> getConstants(NoiseFractal);
+
+} // math
+} // love
@@ -23,6 +23,7 @@
 // C++
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 // C
 #include <cmath>
@@ -47,6 +48,60 @@ static uint64 wangHash64(uint64 key)
 	return key;
 }
 
+// The xorshift state update used by RandomGenerator::rand.
+static inline uint64 xorshift64(uint64 x)
+{
+	x ^= (x >> 12);
+	x ^= (x << 25);
+	x ^= (x >> 27);
+	return x;
+}
+
+// The xorshift update is linear over GF(2), so any number of steps is a 64x64
+// bit matrix. Column i is the state that a state with only bit i set becomes.
+struct XorshiftMatrix
+{
+	uint64 columns[64];
+
+	uint64 apply(uint64 x) const
+	{
+		uint64 r = 0;
+		for (int i = 0; x != 0; i++, x >>= 1)
+		{
+			if (x & 1)
+				r ^= columns[i];
+		}
+		return r;
+	}
+};
+
+// Builds the matrix for 2^log2steps steps by repeatedly squaring one step.
+static XorshiftMatrix getXorshiftJump(int log2steps)
+{
+	XorshiftMatrix m;
+	for (int i = 0; i < 64; i++)
+		m.columns[i] = xorshift64(1ULL << i);
+
+	for (int n = 0; n < log2steps; n++)
+	{
+		XorshiftMatrix squared;
+		for (int i = 0; i < 64; i++)
+			squared.columns[i] = m.apply(m.columns[i]);
+		m = squared;
+	}
+
+	return m;
+}
+
+// Converts random bits to a double in [0, 1), like RandomGenerator::random.
+static inline double toUnitDouble(uint64 r)
+{
+	// From http://xoroshiro.di.unimi.it
+	union { uint64 i; double d; } u;
+	u.i = ((0x3FFULL) << 52) | (r >> 12);
+	return u.d - 1.0;
+}
+
 love::Type RandomGenerator::type("RandomGenerator", &Object::type);
 
 // 64 bit Xorshift implementation taken from the end of Sec. 3 (page 4) in
@@ -66,9 +121,7 @@ RandomGenerator::RandomGenerator()
 
 uint64 RandomGenerator::rand()
 {
-	rng_state.b64 ^= (rng_state.b64 >> 12);
-	rng_state.b64 ^= (rng_state.b64 << 25);
-	rng_state.b64 ^= (rng_state.b64 >> 27);
+	rng_state.b64 = xorshift64(rng_state.b64);
 	return rng_state.b64 * 2685821657736338717ULL;
 }
 
@@ -90,6 +143,91 @@ double RandomGenerator::randomNormal(double stddev)
 	return r * sin(phi) * stddev;
 }
 
+void RandomGenerator::fill(void *dst, Distribution distribution, size_t count, double a, double b)
+{
+	if (distribution == DISTRIBUTION_NORMAL)
+	{
+		float *out = (float *) dst;
+		size_t i = 0;
+
+		// Same order as repeated randomNormal calls, including the value it
+		// keeps for the next call.
+		if (count > 0 && last_randomnormal != std::numeric_limits<double>::infinity())
+		{
+			out[i++] = (float) (last_randomnormal * a + b);
+			last_randomnormal = std::numeric_limits<double>::infinity();
+		}
+
+		while (i < count)
+		{
+			double r   = sqrt(-2.0 * log(1. - random()));
+			double phi = 2.0 * LOVE_M_PI * (1. - random());
+
+			out[i++] = (float) (r * sin(phi) * a + b);
+
+			if (i < count)
+				out[i++] = (float) (r * cos(phi) * a + b);
+			else
+				last_randomnormal = r * cos(phi);
+		}
+
+		return;
+	}
+
+	// Each number depends on the previous state, so the loops can't be
+	// vectorized. They avoid per-number calls and branches instead.
+	if (distribution == DISTRIBUTION_INTEGER)
+	{
+		// Same as floor(random() * (max - min + 1)) + min in RandomGenerator:random.
+		int32 *out = (int32 *) dst;
+		double range = b - a + 1.0;
+		for (size_t i = 0; i < count; i++)
+			out[i] = (int32) (floor(toUnitDouble(rand()) * range) + a);
+	}
+	else
+	{
+		float *out = (float *) dst;
+		double range = b - a;
+
+		// Rounding to float can give b itself, so results are clamped to the
+		// nearest float on the a side of b.
+		float limit = nextafterf((float) b, (float) a);
+
+		if (a < b)
+		{
+			for (size_t i = 0; i < count; i++)
+				out[i] = std::min((float) (toUnitDouble(rand()) * range + a), limit);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+				out[i] = std::max((float) (toUnitDouble(rand()) * range + a), limit);
+		}
+	}
+}
+
+void RandomGenerator::jump()
+{
+	static const XorshiftMatrix jumpMatrix = getXorshiftJump(JUMP_DISTANCE_LOG2);
+
+	rng_state.b64 = jumpMatrix.apply(rng_state.b64);
+
+	last_randomnormal = std::numeric_limits<double>::infinity();
+}
+
+RandomGenerator *RandomGenerator::split()
+{
+	RandomGenerator *stream = new RandomGenerator();
+
+	stream->seed = seed;
+	stream->rng_state = rng_state;
+	stream->last_randomnormal = last_randomnormal;
+
+	jump();
+
+	return stream;
+}
+
 void RandomGenerator::setSeed(RandomGenerator::Seed newseed)
 {
 	seed = newseed;
@@ -145,5 +283,29 @@ std::string RandomGenerator::getState() const
 	return ss.str();
 }
 
+bool RandomGenerator::getConstant(const char *in, Distribution &out)
+{
+	return distributions.find(in, out);
+}
+
+bool RandomGenerator::getConstant(Distribution in, const char *&out)
+{
+	return distributions.find(in, out);
+}
+
+std::vector<std::string> RandomGenerator::getConstants(Distribution)
+{
+	return distributions.getNames();
+}
+
+StringMap<RandomGenerator::Distribution, RandomGenerator::DISTRIBUTION_MAX_ENUM>::Entry RandomGenerator::distributionEntries[] =
+{
+	{ "uniform", DISTRIBUTION_UNIFORM },
+	{ "normal",  DISTRIBUTION_NORMAL  },
+	{ "integer", DISTRIBUTION_INTEGER },
+};
+
+StringMap<RandomGenerator::Distribution, RandomGenerator::DISTRIBUTION_MAX_ENUM> RandomGenerator::distributions(RandomGenerator::distributionEntries, sizeof(RandomGenerator::distributionEntries));
+
 } // math
 } // love
@@ -27,10 +27,12 @@
 #include "common/math.h"
 #include "common/int.h"
 #include "common/Object.h"
+#include "common/StringMap.h"
 
 // C++
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace love
 {
@@ -43,6 +45,14 @@ public:
 
 	static love::Type type;
 
+	enum Distribution
+	{
+		DISTRIBUTION_UNIFORM,
+		DISTRIBUTION_NORMAL,
+		DISTRIBUTION_INTEGER,
+		DISTRIBUTION_MAX_ENUM
+	};
+
 	union Seed
 	{
 		uint64 b64;
@@ -112,6 +122,32 @@ public:
 	 **/
 	double randomNormal(double stddev);
 
+	/**
+	 * Fills an array with pseudo random numbers. The values are the same as
+	 * the ones count calls to the matching single-value function would give.
+	 *
+	 * @param dst The array to fill. Receives floats for the uniform and
+	 *        normal distributions, and int32s for the integer distribution.
+	 * @param distribution DISTRIBUTION_UNIFORM gives numbers in [a, b),
+	 *        DISTRIBUTION_NORMAL gives numbers with standard deviation a and
+	 *        mean b, and DISTRIBUTION_INTEGER gives integers in [a, b].
+	 * @param count The number of values to write.
+	 **/
+	void fill(void *dst, Distribution distribution, size_t count, double a, double b);
+
+	/**
+	 * Advances the state as if rand() had been called 2^JUMP_DISTANCE_LOG2
+	 * times, without computing the numbers in between.
+	 **/
+	void jump();
+
+	/**
+	 * Creates a new generator which continues this generator's sequence, and
+	 * jumps this generator ahead. Repeated splits give streams that don't
+	 * overlap for 2^JUMP_DISTANCE_LOG2 numbers each.
+	 **/
+	RandomGenerator *split();
+
 	/**
 	 * Set pseudo-random seed.
 	 * It's up to the implementation how to use this.
@@ -134,8 +170,17 @@ public:
 	 **/
 	std::string getState() const;
 
+	static bool getConstant(const char *in, Distribution &out);
+	static bool getConstant(Distribution in, const char *&out);
+	static std::vector<std::string> getConstants(Distribution);
+
+	static const int JUMP_DISTANCE_LOG2 = 40;
+
 private:
 
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM>::Entry distributionEntries[];
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM> distributions;
+
 	Seed seed;
 	Seed rng_state;
 	double last_randomnormal;
@@ -0,0 +1,315 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "SpatialHash.h"
+#include "common/Exception.h"
+
+// C++
+#include <cmath>
+#include <algorithm>
+
+namespace love
+{
+namespace math
+{
+
+love::Type SpatialHash::type("SpatialHash", &SpatialIndex::type);
+
+SpatialHash::SpatialHash(float cellSize)
+	: cellSize(cellSize)
+	, bucketItems(0)
+	, queryMark(0)
+{
+	if (!(cellSize > 0.0f))
+		throw love::Exception("The cell size of a SpatialHash must be greater than 0.");
+
+	buckets.resize(1024);
+}
+
+SpatialHash::~SpatialHash()
+{
+}
+
+float SpatialHash::getCellSize() const
+{
+	return cellSize;
+}
+
+SpatialHash::CellRange SpatialHash::getCells(float x, float y, float w, float h) const
+{
+	// Converting an infinite, NaN or out of range value to int is undefined,
+	// so the cell is worked out as a double and clamped first.
+	auto toCell = [this](double v) -> int
+	{
+		double c = floor(v / cellSize);
+		if (!(c > -MAX_CELL))
+			return -MAX_CELL;
+		if (c > MAX_CELL)
+			return MAX_CELL;
+		return (int) c;
+	};
+
+	CellRange c;
+	c.x0 = toCell(x);
+	c.y0 = toCell(y);
+	c.x1 = toCell((double) x + w);
+	c.y1 = toCell((double) y + h);
+	return c;
+}
+
+size_t SpatialHash::getBucket(int cx, int cy) const
+{
+	uint32 h = (uint32) cx * 73856093u ^ (uint32) cy * 19349663u;
+	return h & (buckets.size() - 1);
+}
+
+void SpatialHash::link(int entry)
+{
+	Entry &e = entries[entry];
+	const CellRange &c = e.cells;
+
+	// A huge rectangle would otherwise take forever to link (or run out of
+	// memory), so it's kept aside and checked by every query.
+	double cellCount = ((double) c.x1 - c.x0 + 1) * ((double) c.y1 - c.y0 + 1);
+	e.oversized = !(cellCount <= MAX_LINKED_CELLS);
+
+	if (e.oversized)
+	{
+		oversized.push_back(entry);
+		return;
+	}
+
+	for (int cy = c.y0; cy <= c.y1; cy++)
+	{
+		for (int cx = c.x0; cx <= c.x1; cx++)
+		{
+			buckets[getBucket(cx, cy)].push_back(entry);
+			bucketItems++;
+		}
+	}
+}
+
+void SpatialHash::unlink(int entry)
+{
+	const Entry &e = entries[entry];
+	const CellRange &c = e.cells;
+
+	if (e.oversized)
+	{
+		auto it = std::find(oversized.begin(), oversized.end(), entry);
+		if (it != oversized.end())
+		{
+			*it = oversized.back();
+			oversized.pop_back();
+		}
+		return;
+	}
+
+	for (int cy = c.y0; cy <= c.y1; cy++)
+	{
+		for (int cx = c.x0; cx <= c.x1; cx++)
+		{
+			std::vector<int> &bucket = buckets[getBucket(cx, cy)];
+			auto it = std::find(bucket.begin(), bucket.end(), entry);
+			if (it != bucket.end())
+			{
+				*it = bucket.back();
+				bucket.pop_back();
+				bucketItems--;
+			}
+		}
+	}
+}
+
+void SpatialHash::rehash(size_t bucketCount)
+{
+	for (std::vector<int> &bucket : buckets)
+		bucket.clear();
+
+	buckets.resize(bucketCount);
+	bucketItems = 0;
+	oversized.clear();
+
+	for (const auto &e : entryIndices)
+		link(e.second);
+}
+
+void SpatialHash::add(int id, float x, float y, float w, float h)
+{
+	if (w < 0.0f || h < 0.0f)
+		throw love::Exception("Rectangle dimensions cannot be negative.");
+
+	if (entryIndices.find(id) != entryIndices.end())
+		throw love::Exception("A rectangle with id %d already exists.", id);
+
+	int index = 0;
+	if (!freeEntries.empty())
+	{
+		index = freeEntries.back();
+		freeEntries.pop_back();
+	}
+	else
+	{
+		index = (int) entries.size();
+		entries.emplace_back();
+	}
+
+	Entry &e = entries[index];
+	e.id = id;
+	e.x = x;
+	e.y = y;
+	e.w = w;
+	e.h = h;
+	e.cells = getCells(x, y, w, h);
+	e.oversized = false;
+	e.queryMark = queryMark;
+
+	entryIndices[id] = index;
+	link(index);
+
+	// Keep buckets short.
+	if (bucketItems > buckets.size() * 2)
+		rehash(buckets.size() * 2);
+}
+
+void SpatialHash::move(int id, float x, float y, float w, float h, float /*dx*/, float /*dy*/)
+{
+	if (w < 0.0f || h < 0.0f)
+		throw love::Exception("Rectangle dimensions cannot be negative.");
+
+	auto it = entryIndices.find(id);
+	if (it == entryIndices.end())
+		throw love::Exception("No rectangle with id %d exists.", id);
+
+	Entry &e = entries[it->second];
+	e.x = x;
+	e.y = y;
+	e.w = w;
+	e.h = h;
+
+	// Most moves stay within the same cells.
+	CellRange cells = getCells(x, y, w, h);
+	if (cells == e.cells)
+		return;
+
+	unlink(it->second);
+	e.cells = cells;
+	link(it->second);
+}
+
+bool SpatialHash::remove(int id)
+{
+	auto it = entryIndices.find(id);
+	if (it == entryIndices.end())
+		return false;
+
+	unlink(it->second);
+	freeEntries.push_back(it->second);
+	entryIndices.erase(it);
+	return true;
+}
+
+bool SpatialHash::getRect(int id, float &x, float &y, float &w, float &h) const
+{
+	auto it = entryIndices.find(id);
+	if (it == entryIndices.end())
+		return false;
+
+	const Entry &e = entries[it->second];
+	x = e.x;
+	y = e.y;
+	w = e.w;
+	h = e.h;
+	return true;
+}
+
+int SpatialHash::getCount() const
+{
+	return (int) entryIndices.size();
+}
+
+void SpatialHash::clear()
+{
+	for (std::vector<int> &bucket : buckets)
+		bucket.clear();
+
+	entries.clear();
+	freeEntries.clear();
+	entryIndices.clear();
+	bucketItems = 0;
+	oversized.clear();
+}
+
+void SpatialHash::query(float x, float y, float w, float h, std::vector<int> &ids) const
+{
+	w = std::max(w, 0.0f);
+	h = std::max(h, 0.0f);
+
+	if (++queryMark == 0)
+	{
+		// Wrapped around, so old marks could match again.
+		for (const Entry &e : entries)
+			e.queryMark = 0;
+		queryMark = 1;
+	}
+
+	CellRange c = getCells(x, y, w, h);
+	double cellCount = ((double) c.x1 - c.x0 + 1) * ((double) c.y1 - c.y0 + 1);
+
+	// Checking every rectangle is cheaper than visiting more cells than
+	// there are buckets.
+	if (cellCount > (double) buckets.size())
+	{
+		for (const auto &it : entryIndices)
+		{
+			const Entry &e = entries[it.second];
+			if (overlaps(e.x, e.y, e.w, e.h, x, y, w, h))
+				ids.push_back(e.id);
+		}
+		return;
+	}
+
+	for (int cy = c.y0; cy <= c.y1; cy++)
+	{
+		for (int cx = c.x0; cx <= c.x1; cx++)
+		{
+			for (int index : buckets[getBucket(cx, cy)])
+			{
+				const Entry &e = entries[index];
+				if (e.queryMark == queryMark)
+					continue;
+
+				e.queryMark = queryMark;
+				if (overlaps(e.x, e.y, e.w, e.h, x, y, w, h))
+					ids.push_back(e.id);
+			}
+		}
+	}
+
+	for (int index : oversized)
+	{
+		const Entry &e = entries[index];
+		if (overlaps(e.x, e.y, e.w, e.h, x, y, w, h))
+			ids.push_back(e.id);
+	}
+}
+
+} // math
+} // love
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "SpatialIndex.h"
+
+// C++
+#include <unordered_map>
+
+namespace love
+{
+namespace math
+{
+
+/**
+ * A SpatialIndex which sorts rectangles into the cells of a uniform grid.
+ * Cheap to update, and fast when most rectangles are smaller than a cell.
+ **/
+class SpatialHash : public SpatialIndex
+{
+public:
+
+	static love::Type type;
+
+	SpatialHash(float cellSize);
+	virtual ~SpatialHash();
+
+	float getCellSize() const;
+
+	// Implements SpatialIndex.
+	void add(int id, float x, float y, float w, float h) override;
+	void move(int id, float x, float y, float w, float h, float dx, float dy) override;
+	bool remove(int id) override;
+	bool getRect(int id, float &x, float &y, float &w, float &h) const override;
+	int getCount() const override;
+	void clear() override;
+	void query(float x, float y, float w, float h, std::vector<int> &ids) const override;
+
+private:
+
+	struct CellRange
+	{
+		int x0, y0, x1, y1;
+
+		bool operator == (const CellRange &o) const
+		{
+			return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1;
+		}
+	};
+
+	struct Entry
+	{
+		int id;
+		float x, y, w, h;
+		CellRange cells;
+
+		// Whether it covers too many cells to be linked into each of them.
+		bool oversized;
+
+		// Set to the current query, so rectangles in several cells are only
+		// reported once.
+		mutable uint32 queryMark;
+	};
+
+	CellRange getCells(float x, float y, float w, float h) const;
+	size_t getBucket(int cx, int cy) const;
+
+	void link(int entry);
+	void unlink(int entry);
+	void rehash(size_t bucketCount);
+
+	float cellSize;
+
+	std::vector<Entry> entries;
+	std::vector<int> freeEntries;
+	std::unordered_map<int, int> entryIndices;
+
+	// Entry indices per cell, with several cells sharing a bucket.
+	std::vector<std::vector<int>> buckets;
+	size_t bucketItems;
+
+	// Entries covering more than MAX_LINKED_CELLS cells, which every query
+	// checks instead.
+	std::vector<int> oversized;
+
+	mutable uint32 queryMark;
+
+	static const int MAX_LINKED_CELLS = 64;
+
+	// Cell coordinates are clamped to this range.
+	static const int MAX_CELL = 1 << 30;
+
+}; // SpatialHash
+
+} // math
+} // love
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "SpatialIndex.h"
+
+namespace love
+{
+namespace math
+{
+
+love::Type SpatialIndex::type("SpatialIndex", &Object::type);
+
+int SpatialIndex::queryBatch(const float *boxes, int boxCount, int32 *hits, int maxHits, bool &complete) const
+{
+	int count = 0;
+	complete = true;
+
+	for (int i = 0; i < boxCount; i++)
+	{
+		const float *box = boxes + i * 4;
+
+		queryResults.clear();
+		query(box[0], box[1], box[2], box[3], queryResults);
+
+		for (int id : queryResults)
+		{
+			if (count >= maxHits)
+			{
+				complete = false;
+				return count;
+			}
+
+			int32 *hit = hits + count * QUERY_HIT_COMPONENTS;
+			hit[0] = (int32) (i + 1);
+			hit[1] = (int32) id;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+} // math
+} // love
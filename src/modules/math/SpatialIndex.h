@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/int.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace math
+{
+
+/**
+ * Base class for structures which find the rectangles overlapping an area,
+ * without doing any physics. Rectangles are identified by integer ids
+ * chosen by the user.
+ **/
+class SpatialIndex : public Object
+{
+public:
+
+	static love::Type type;
+
+	/**
+	 * Number of int32 values written per hit by queryBatch: the index of the
+	 * box (starting at 1) and the id of the rectangle.
+	 **/
+	static const int QUERY_HIT_COMPONENTS = 2;
+
+	virtual ~SpatialIndex() {}
+
+	/**
+	 * Adds a rectangle. Throws if the id is already in use.
+	 **/
+	virtual void add(int id, float x, float y, float w, float h) = 0;
+
+	/**
+	 * Changes the rectangle with the given id. Throws if it doesn't exist.
+	 * @param dx,dy Expected movement until the next update, used by
+	 * structures which can predict motion.
+	 **/
+	virtual void move(int id, float x, float y, float w, float h, float dx, float dy) = 0;
+
+	/**
+	 * Removes a rectangle.
+	 * @return Whether a rectangle with the id existed.
+	 **/
+	virtual bool remove(int id) = 0;
+
+	/**
+	 * Gets the rectangle with the given id.
+	 * @return False if it doesn't exist.
+	 **/
+	virtual bool getRect(int id, float &x, float &y, float &w, float &h) const = 0;
+
+	virtual int getCount() const = 0;
+
+	/**
+	 * Removes every rectangle.
+	 **/
+	virtual void clear() = 0;
+
+	/**
+	 * Appends the ids of the rectangles overlapping an area to a list.
+	 * Touching edges count as overlapping.
+	 **/
+	virtual void query(float x, float y, float w, float h, std::vector<int> &ids) const = 0;
+
+	/**
+	 * Queries many areas at once.
+	 * @param boxes x, y, width and height of each area.
+	 * @param boxCount The number of areas.
+	 * @param hits Receives QUERY_HIT_COMPONENTS values per overlap found.
+	 * @param maxHits The number of hits which fit in the hits array.
+	 * @param[out] complete False if some hits did not fit.
+	 * @return The number of hits written.
+	 **/
+	int queryBatch(const float *boxes, int boxCount, int32 *hits, int maxHits, bool &complete) const;
+
+protected:
+
+	static bool overlaps(float ax, float ay, float aw, float ah, float bx, float by, float bw, float bh)
+	{
+		return ax <= bx + bw && bx <= ax + aw && ay <= by + bh && by <= ay + ah;
+	}
+
+	// Reused by queryBatch.
+	mutable std::vector<int> queryResults;
+
+}; // SpatialIndex
+
+} // math
+} // love
@@ -0,0 +1,762 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+/**
+ * The triangulation algorithm is a port of earcut
+ * (https://github.com/mapbox/earcut), which is under the ISC license:
+ *
+ * Copyright (c) 2016, Mapbox
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose
+ * with or without fee is hereby granted, provided that the above copyright notice
+ * and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+ * THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+ * IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ **/
+
+// LOVE
+#include "Triangulator.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace love
+{
+namespace math
+{
+
+namespace
+{
+
+// Twice the signed area of the triangle pqr. Negative if it turns left.
+template <typename T>
+inline double area(const T *p, const T *q, const T *r)
+{
+	return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+template <typename T>
+inline bool equals(const T *a, const T *b)
+{
+	return a->x == b->x && a->y == b->y;
+}
+
+inline int sign(double v)
+{
+	return (v > 0) - (v < 0);
+}
+
+inline bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+	return (cx - px) * (ay - py) >= (ax - px) * (cy - py)
+		&& (ax - px) * (by - py) >= (bx - px) * (ay - py)
+		&& (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+// Checks if q lies on the segment pr, given that the three are collinear.
+template <typename T>
+inline bool onSegment(const T *p, const T *q, const T *r)
+{
+	return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x)
+		&& q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+}
+
+template <typename T>
+bool intersects(const T *p1, const T *q1, const T *p2, const T *q2)
+{
+	int o1 = sign(area(p1, q1, p2));
+	int o2 = sign(area(p1, q1, q2));
+	int o3 = sign(area(p2, q2, p1));
+	int o4 = sign(area(p2, q2, q1));
+
+	if (o1 != o2 && o3 != o4)
+		return true;
+
+	if (o1 == 0 && onSegment(p1, p2, q1)) return true;
+	if (o2 == 0 && onSegment(p1, q2, q1)) return true;
+	if (o3 == 0 && onSegment(p2, p1, q2)) return true;
+	if (o4 == 0 && onSegment(p2, q1, q2)) return true;
+
+	return false;
+}
+
+// Checks if the diagonal ab starts inside the polygon, locally at a.
+template <typename T>
+bool locallyInside(const T *a, const T *b)
+{
+	if (area(a->prev, a, a->next) < 0)
+		return area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0;
+	else
+		return area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+}
+
+template <typename T>
+bool sectorContainsSector(const T *m, const T *p)
+{
+	return area(m->prev, m, p->prev) < 0 && area(p->next, m, m->next) < 0;
+}
+
+template <typename T>
+T *getLeftmost(T *start)
+{
+	T *p = start;
+	T *leftmost = start;
+	do
+	{
+		if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+			leftmost = p;
+		p = p->next;
+	} while (p != start);
+
+	return leftmost;
+}
+
+double signedArea(const float *coords, size_t start, size_t end)
+{
+	double sum = 0.0;
+	for (size_t i = start, j = end - 1; i < end; j = i++)
+		sum += ((double) coords[j*2] - coords[i*2]) * ((double) coords[i*2+1] + coords[j*2+1]);
+	return sum;
+}
+
+} // anonymous namespace
+
+Triangulator::Triangulator()
+	: nodeBlock(0)
+	, nodeUsed(0)
+	, minX(0.0)
+	, minY(0.0)
+	, invSize(0.0)
+	, triangles(nullptr)
+{
+}
+
+Triangulator::~Triangulator()
+{
+	for (Node *block : nodeBlocks)
+		delete[] block;
+}
+
+size_t Triangulator::triangulate(const float *coords, size_t vertexCount, const std::vector<size_t> &holeStarts, std::vector<uint32> &indices)
+{
+	size_t oldsize = indices.size();
+
+	nodeBlock = 0;
+	nodeUsed = 0;
+	invSize = 0.0;
+	triangles = &indices;
+
+	size_t outerCount = holeStarts.empty() ? vertexCount : std::min(holeStarts[0], vertexCount);
+
+	Node *outerNode = linkedList(coords, 0, outerCount, true);
+	if (outerNode == nullptr || outerNode->next == outerNode->prev)
+		return 0;
+
+	if (!holeStarts.empty())
+		outerNode = eliminateHoles(coords, vertexCount, holeStarts, outerNode);
+
+	// Small polygons are faster to clip without the z-order index.
+	if (vertexCount > 80)
+	{
+		double maxX = minX = coords[0];
+		double maxY = minY = coords[1];
+
+		for (size_t i = 1; i < outerCount; i++)
+		{
+			double x = coords[i * 2 + 0];
+			double y = coords[i * 2 + 1];
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+		}
+
+		// The coordinates are mapped to 15 bits per axis.
+		invSize = std::max(maxX - minX, maxY - minY);
+		invSize = invSize != 0.0 ? 32767.0 / invSize : 0.0;
+	}
+
+	earcutLinked(outerNode, 0);
+
+	triangles = nullptr;
+	return (indices.size() - oldsize) / 3;
+}
+
+Triangulator::Node *Triangulator::createNode(uint32 i, double x, double y)
+{
+	if (nodeUsed == NODE_BLOCK_SIZE)
+	{
+		nodeBlock++;
+		nodeUsed = 0;
+	}
+
+	if (nodeBlock == nodeBlocks.size())
+		nodeBlocks.push_back(new Node[NODE_BLOCK_SIZE]);
+
+	Node *p = &nodeBlocks[nodeBlock][nodeUsed++];
+
+	p->i = i;
+	p->x = x;
+	p->y = y;
+	p->prev = nullptr;
+	p->next = nullptr;
+	p->z = 0;
+	p->prevZ = nullptr;
+	p->nextZ = nullptr;
+	p->steiner = false;
+
+	return p;
+}
+
+Triangulator::Node *Triangulator::insertNode(uint32 i, double x, double y, Node *last)
+{
+	Node *p = createNode(i, x, y);
+
+	if (last == nullptr)
+	{
+		p->prev = p;
+		p->next = p;
+	}
+	else
+	{
+		p->next = last->next;
+		p->prev = last;
+		last->next->prev = p;
+		last->next = p;
+	}
+
+	return p;
+}
+
+void Triangulator::removeNode(Node *p)
+{
+	p->next->prev = p->prev;
+	p->prev->next = p->next;
+
+	if (p->prevZ)
+		p->prevZ->nextZ = p->nextZ;
+	if (p->nextZ)
+		p->nextZ->prevZ = p->prevZ;
+}
+
+Triangulator::Node *Triangulator::linkedList(const float *coords, size_t start, size_t end, bool clockwise)
+{
+	if (end <= start)
+		return nullptr;
+
+	Node *last = nullptr;
+
+	if (clockwise == (signedArea(coords, start, end) > 0))
+	{
+		for (size_t i = start; i < end; i++)
+			last = insertNode((uint32) i, coords[i * 2], coords[i * 2 + 1], last);
+	}
+	else
+	{
+		for (size_t i = end; i-- > start;)
+			last = insertNode((uint32) i, coords[i * 2], coords[i * 2 + 1], last);
+	}
+
+	if (last != nullptr && equals(last, last->next))
+	{
+		removeNode(last);
+		last = last->next;
+	}
+
+	return last;
+}
+
+Triangulator::Node *Triangulator::filterPoints(Node *start, Node *end)
+{
+	if (start == nullptr)
+		return start;
+	if (end == nullptr)
+		end = start;
+
+	Node *p = start;
+	bool again;
+	do
+	{
+		again = false;
+
+		if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0))
+		{
+			removeNode(p);
+			p = end = p->prev;
+			if (p == p->next)
+				break;
+			again = true;
+		}
+		else
+			p = p->next;
+	} while (again || p != end);
+
+	return end;
+}
+
+void Triangulator::earcutLinked(Node *ear, int pass)
+{
+	if (ear == nullptr)
+		return;
+
+	if (pass == 0 && invSize != 0.0)
+		indexCurve(ear);
+
+	Node *stop = ear;
+
+	while (ear->prev != ear->next)
+	{
+		Node *prev = ear->prev;
+		Node *next = ear->next;
+
+		if (invSize != 0.0 ? isEarHashed(ear) : isEar(ear))
+		{
+			triangles->push_back(prev->i);
+			triangles->push_back(ear->i);
+			triangles->push_back(next->i);
+
+			removeNode(ear);
+
+			// Skipping the next vertex leads to less sliver triangles.
+			ear = next->next;
+			stop = next->next;
+			continue;
+		}
+
+		ear = next;
+
+		// We went around the whole polygon without finding an ear.
+		if (ear == stop)
+		{
+			if (pass == 0)
+				earcutLinked(filterPoints(ear), 1);
+			else if (pass == 1)
+				earcutLinked(cureLocalIntersections(filterPoints(ear)), 2);
+			else if (pass == 2)
+				splitEarcut(ear);
+			break;
+		}
+	}
+}
+
+bool Triangulator::isEar(Node *ear) const
+{
+	const Node *a = ear->prev;
+	const Node *b = ear;
+	const Node *c = ear->next;
+
+	// Reflex, can't be an ear.
+	if (area(a, b, c) >= 0)
+		return false;
+
+	for (const Node *p = c->next; p != a; p = p->next)
+	{
+		if (pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && area(p->prev, p, p->next) >= 0)
+			return false;
+	}
+
+	return true;
+}
+
+bool Triangulator::isEarHashed(Node *ear) const
+{
+	const Node *a = ear->prev;
+	const Node *b = ear;
+	const Node *c = ear->next;
+
+	if (area(a, b, c) >= 0)
+		return false;
+
+	double minTX = std::min(a->x, std::min(b->x, c->x));
+	double minTY = std::min(a->y, std::min(b->y, c->y));
+	double maxTX = std::max(a->x, std::max(b->x, c->x));
+	double maxTY = std::max(a->y, std::max(b->y, c->y));
+
+	// Only vertices within the z-order range of the triangle's bounds can
+	// be inside it.
+	int32 minZ = zOrder(minTX, minTY);
+	int32 maxZ = zOrder(maxTX, maxTY);
+
+	auto blocks = [&](const Node *p) -> bool
+	{
+		return p != ear->prev && p != ear->next
+			&& pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)
+			&& area(p->prev, p, p->next) >= 0;
+	};
+
+	// Look in both directions at once.
+	const Node *p = ear->prevZ;
+	const Node *n = ear->nextZ;
+
+	while (p != nullptr && p->z >= minZ && n != nullptr && n->z <= maxZ)
+	{
+		if (blocks(p))
+			return false;
+		p = p->prevZ;
+
+		if (blocks(n))
+			return false;
+		n = n->nextZ;
+	}
+
+	while (p != nullptr && p->z >= minZ)
+	{
+		if (blocks(p))
+			return false;
+		p = p->prevZ;
+	}
+
+	while (n != nullptr && n->z <= maxZ)
+	{
+		if (blocks(n))
+			return false;
+		n = n->nextZ;
+	}
+
+	return true;
+}
+
+Triangulator::Node *Triangulator::cureLocalIntersections(Node *start)
+{
+	Node *p = start;
+	do
+	{
+		Node *a = p->prev;
+		Node *b = p->next->next;
+
+		if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a))
+		{
+			triangles->push_back(a->i);
+			triangles->push_back(p->i);
+			triangles->push_back(b->i);
+
+			removeNode(p);
+			removeNode(p->next);
+
+			p = start = b;
+		}
+		p = p->next;
+	} while (p != start);
+
+	return filterPoints(p);
+}
+
+void Triangulator::splitEarcut(Node *start)
+{
+	// Look for a valid diagonal that divides the polygon into two.
+	Node *a = start;
+	do
+	{
+		Node *b = a->next->next;
+		while (b != a->prev)
+		{
+			if (a->i != b->i && isValidDiagonal(a, b))
+			{
+				Node *c = splitPolygon(a, b);
+
+				a = filterPoints(a, a->next);
+				c = filterPoints(c, c->next);
+
+				earcutLinked(a, 0);
+				earcutLinked(c, 0);
+				return;
+			}
+			b = b->next;
+		}
+		a = a->next;
+	} while (a != start);
+}
+
+Triangulator::Node *Triangulator::eliminateHoles(const float *coords, size_t vertexCount, const std::vector<size_t> &holeStarts, Node *outerNode)
+{
+	holeQueue.clear();
+
+	for (size_t i = 0; i < holeStarts.size(); i++)
+	{
+		size_t start = holeStarts[i];
+		size_t end = i + 1 < holeStarts.size() ? holeStarts[i + 1] : vertexCount;
+
+		Node *list = linkedList(coords, start, std::min(end, vertexCount), false);
+		if (list == nullptr)
+			continue;
+
+		if (list == list->next)
+			list->steiner = true;
+
+		holeQueue.push_back(getLeftmost(list));
+	}
+
+	std::sort(holeQueue.begin(), holeQueue.end(), [](const Node *a, const Node *b)
+	{
+		return a->x < b->x;
+	});
+
+	// Bridge the holes into the outer ring from left to right.
+	for (Node *hole : holeQueue)
+		outerNode = eliminateHole(hole, outerNode);
+
+	return outerNode;
+}
+
+Triangulator::Node *Triangulator::eliminateHole(Node *hole, Node *outerNode)
+{
+	Node *bridge = findHoleBridge(hole, outerNode);
+	if (bridge == nullptr)
+		return outerNode;
+
+	Node *bridgeReverse = splitPolygon(bridge, hole);
+
+	filterPoints(bridgeReverse, bridgeReverse->next);
+	return filterPoints(bridge, bridge->next);
+}
+
+Triangulator::Node *Triangulator::findHoleBridge(Node *hole, Node *outerNode) const
+{
+	Node *p = outerNode;
+	double hx = hole->x;
+	double hy = hole->y;
+	double qx = -std::numeric_limits<double>::infinity();
+	Node *m = nullptr;
+
+	// Find the segment left of the hole's leftmost vertex which is
+	// closest to it along a horizontal ray.
+	do
+	{
+		if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+		{
+			double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+			if (x <= hx && x > qx)
+			{
+				qx = x;
+				m = p->x < p->next->x ? p : p->next;
+				if (x == hx)
+					return m;
+			}
+		}
+		p = p->next;
+	} while (p != outerNode);
+
+	if (m == nullptr)
+		return nullptr;
+
+	// Vertices inside the triangle between the hole vertex, the hit point
+	// and the segment end could block the bridge. Use the one with the
+	// smallest angle to the ray instead.
+	const Node *stop = m;
+	double mx = m->x;
+	double my = m->y;
+	double tanMin = std::numeric_limits<double>::infinity();
+
+	p = m;
+	do
+	{
+		if (hx >= p->x && p->x >= mx && hx != p->x
+			&& pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+		{
+			double tan = std::abs(hy - p->y) / (hx - p->x);
+
+			if (locallyInside(p, hole)
+				&& (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && sectorContainsSector(m, p))))))
+			{
+				m = p;
+				tanMin = tan;
+			}
+		}
+		p = p->next;
+	} while (p != stop);
+
+	return m;
+}
+
+void Triangulator::indexCurve(Node *start)
+{
+	Node *p = start;
+	do
+	{
+		if (p->z == 0)
+			p->z = zOrder(p->x, p->y);
+		p->prevZ = p->prev;
+		p->nextZ = p->next;
+		p = p->next;
+	} while (p != start);
+
+	p->prevZ->nextZ = nullptr;
+	p->prevZ = nullptr;
+
+	sortLinked(p);
+}
+
+Triangulator::Node *Triangulator::sortLinked(Node *list)
+{
+	// Bottom-up merge sort of the z-order list (Simon Tatham's algorithm).
+	int numMerges;
+	size_t inSize = 1;
+
+	do
+	{
+		Node *p = list;
+		Node *tail = nullptr;
+		list = nullptr;
+		numMerges = 0;
+
+		while (p != nullptr)
+		{
+			numMerges++;
+
+			Node *q = p;
+			size_t pSize = 0;
+			for (size_t i = 0; i < inSize; i++)
+			{
+				pSize++;
+				q = q->nextZ;
+				if (q == nullptr)
+					break;
+			}
+
+			size_t qSize = inSize;
+
+			while (pSize > 0 || (qSize > 0 && q != nullptr))
+			{
+				Node *e;
+				if (pSize != 0 && (qSize == 0 || q == nullptr || p->z <= q->z))
+				{
+					e = p;
+					p = p->nextZ;
+					pSize--;
+				}
+				else
+				{
+					e = q;
+					q = q->nextZ;
+					qSize--;
+				}
+
+				if (tail != nullptr)
+					tail->nextZ = e;
+				else
+					list = e;
+
+				e->prevZ = tail;
+				tail = e;
+			}
+
+			p = q;
+		}
+
+		tail->nextZ = nullptr;
+		inSize *= 2;
+	} while (numMerges > 1);
+
+	return list;
+}
+
+int32 Triangulator::zOrder(double x, double y) const
+{
+	// Interleave the bits of the 15-bit coordinates. Holes poking out of
+	// the outline are clamped to its bounds.
+	uint32 ix = (uint32) std::min(std::max((x - minX) * invSize, 0.0), 32767.0);
+	uint32 iy = (uint32) std::min(std::max((y - minY) * invSize, 0.0), 32767.0);
+
+	ix = (ix | (ix << 8)) & 0x00FF00FF;
+	ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+	ix = (ix | (ix << 2)) & 0x33333333;
+	ix = (ix | (ix << 1)) & 0x55555555;
+
+	iy = (iy | (iy << 8)) & 0x00FF00FF;
+	iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+	iy = (iy | (iy << 2)) & 0x33333333;
+	iy = (iy | (iy << 1)) & 0x55555555;
+
+	return (int32) (ix | (iy << 1));
+}
+
+bool Triangulator::isValidDiagonal(Node *a, Node *b) const
+{
+	// The diagonal must not cross any edge, and must be inside the polygon.
+	return a->next->i != b->i && a->prev->i != b->i && !intersectsPolygon(a, b)
+		&& ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b)
+			 && (area(a->prev, a, b->prev) != 0 || area(a, b->prev, b) != 0))
+			|| (equals(a, b) && area(a->prev, a, a->next) > 0 && area(b->prev, b, b->next) > 0));
+}
+
+bool Triangulator::intersectsPolygon(const Node *a, const Node *b) const
+{
+	const Node *p = a;
+	do
+	{
+		if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && intersects(p, p->next, a, b))
+			return true;
+		p = p->next;
+	} while (p != a);
+
+	return false;
+}
+
+bool Triangulator::middleInside(const Node *a, const Node *b) const
+{
+	const Node *p = a;
+	bool inside = false;
+	double px = (a->x + b->x) / 2.0;
+	double py = (a->y + b->y) / 2.0;
+
+	do
+	{
+		if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y
+			&& (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+			inside = !inside;
+		p = p->next;
+	} while (p != a);
+
+	return inside;
+}
+
+Triangulator::Node *Triangulator::splitPolygon(Node *a, Node *b)
+{
+	// Link a to b with a diagonal. If a and b were on the same ring this
+	// splits it in two, if they were on different rings it joins them.
+	Node *a2 = createNode(a->i, a->x, a->y);
+	Node *b2 = createNode(b->i, b->x, b->y);
+	Node *an = a->next;
+	Node *bp = b->prev;
+
+	a->next = b;
+	b->prev = a;
+
+	a2->next = an;
+	an->prev = a2;
+
+	b2->next = a2;
+	a2->prev = b2;
+
+	bp->next = b2;
+	b2->prev = bp;
+
+	return b2;
+}
+
+} // math
+} // love
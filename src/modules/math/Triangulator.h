@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+
+// STL
+#include <vector>
+#include <stddef.h>
+
+namespace love
+{
+namespace math
+{
+
+/**
+ * Ear clipping triangulator for simple polygons with holes.
+ *
+ * Ears are tested against a z-order curve index of the vertices once the
+ * polygon is large enough, so large outlines triangulate in close to
+ * linear time. The vertex storage is kept between calls, so reusing one
+ * Triangulator for many polygons doesn't allocate once it has warmed up.
+ **/
+class Triangulator
+{
+public:
+
+	Triangulator();
+	~Triangulator();
+
+	/**
+	 * Triangulates a polygon.
+	 *
+	 * @param coords The x,y coordinates of the outline, followed by the
+	 *        coordinates of each hole.
+	 * @param vertexCount The number of vertices (coordinate pairs) in coords.
+	 * @param holeStarts The index of the first vertex of each hole, in
+	 *        ascending order.
+	 * @param indices Receives three vertex indices per triangle. Existing
+	 *        contents are kept.
+	 * @return The number of triangles added to indices.
+	 **/
+	size_t triangulate(const float *coords, size_t vertexCount, const std::vector<size_t> &holeStarts, std::vector<uint32> &indices);
+
+private:
+
+	struct Node
+	{
+		uint32 i;
+		double x, y;
+
+		// Polygon ring.
+		Node *prev;
+		Node *next;
+
+		// Z-order curve value and the sorted list of the index.
+		int32 z;
+		Node *prevZ;
+		Node *nextZ;
+
+		bool steiner;
+	};
+
+	Node *createNode(uint32 i, double x, double y);
+	Node *insertNode(uint32 i, double x, double y, Node *last);
+	void removeNode(Node *p);
+
+	Node *linkedList(const float *coords, size_t start, size_t end, bool clockwise);
+	Node *filterPoints(Node *start, Node *end = nullptr);
+	void earcutLinked(Node *ear, int pass);
+
+	bool isEar(Node *ear) const;
+	bool isEarHashed(Node *ear) const;
+
+	Node *cureLocalIntersections(Node *start);
+	void splitEarcut(Node *start);
+
+	Node *eliminateHoles(const float *coords, size_t vertexCount, const std::vector<size_t> &holeStarts, Node *outerNode);
+	Node *eliminateHole(Node *hole, Node *outerNode);
+	Node *findHoleBridge(Node *hole, Node *outerNode) const;
+
+	void indexCurve(Node *start);
+	Node *sortLinked(Node *list);
+	int32 zOrder(double x, double y) const;
+
+	bool isValidDiagonal(Node *a, Node *b) const;
+	bool intersectsPolygon(const Node *a, const Node *b) const;
+	bool middleInside(const Node *a, const Node *b) const;
+	Node *splitPolygon(Node *a, Node *b);
+
+	static const size_t NODE_BLOCK_SIZE = 1024;
+
+	// Nodes are handed out from fixed-size blocks so pointers stay valid
+	// while a polygon is being split, and the blocks are reused by later
+	// calls.
+	std::vector<Node *> nodeBlocks;
+	size_t nodeBlock;
+	size_t nodeUsed;
+
+	// Bounds and scale of the z-order index, or 0 if it isn't used.
+	double minX, minY;
+	double invSize;
+
+	std::vector<Node *> holeQueue;
+	std::vector<uint32> *triangles;
+
+}; // Triangulator
+
+} // math
+} // love
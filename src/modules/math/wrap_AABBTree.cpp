@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_AABBTree.h"
+#include "wrap_SpatialIndex.h"
+#include "common/Data.h"
+
+namespace love
+{
+namespace math
+{
+
+AABBTree *luax_checkaabbtree(lua_State *L, int idx)
+{
+	return luax_checktype<AABBTree>(L, idx, AABBTree::type);
+}
+
+int w_AABBTree_getMargin(lua_State *L)
+{
+	AABBTree *t = luax_checkaabbtree(L, 1);
+	lua_pushnumber(L, t->getMargin());
+	return 1;
+}
+
+int w_AABBTree_rayCast(lua_State *L)
+{
+	AABBTree *t = luax_checkaabbtree(L, 1);
+	float x1 = (float) luaL_checknumber(L, 2);
+	float y1 = (float) luaL_checknumber(L, 3);
+	float x2 = (float) luaL_checknumber(L, 4);
+	float y2 = (float) luaL_checknumber(L, 5);
+
+	if (lua_isnoneornil(L, 6))
+		lua_createtable(L, 0, 0);
+	else
+	{
+		luaL_checktype(L, 6, LUA_TTABLE);
+		lua_pushvalue(L, 6);
+	}
+
+	std::vector<AABBTree::RayHit> hits;
+	t->rayCast(x1, y1, x2, y2, 1, hits);
+
+	int count = (int) hits.size();
+	for (int i = 0; i < count; i++)
+	{
+		lua_pushinteger(L, hits[i].id);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	// Clear leftovers from a previous, larger set of results.
+	int oldlength = (int) luax_objlen(L, -1);
+	for (int i = count + 1; i <= oldlength; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, -2, i);
+	}
+
+	lua_pushinteger(L, count);
+	return 2;
+}
+
+int w_AABBTree_rayCastBatch(lua_State *L)
+{
+	AABBTree *t = luax_checkaabbtree(L, 1);
+	love::Data *raydata = luax_checktype<love::Data>(L, 2);
+	love::Data *hitdata = luax_checktype<love::Data>(L, 3);
+
+	if (raydata == hitdata)
+		return luaL_error(L, "The ray and hit Data must be different objects.");
+
+	int raycount = (int) (raydata->getSize() / (sizeof(float) * 4));
+	int maxhits = (int) (hitdata->getSize() / sizeof(AABBTree::RayHit));
+
+	bool complete = true;
+	int count = t->rayCastBatch((const float *) raydata->getData(), raycount, (AABBTree::RayHit *) hitdata->getData(), maxhits, complete);
+
+	lua_pushinteger(L, count);
+	luax_pushboolean(L, complete);
+	return 2;
+}
+
+static const luaL_Reg w_AABBTree_functions[] =
+{
+	{ "getMargin", w_AABBTree_getMargin },
+	{ "rayCast", w_AABBTree_rayCast },
+	{ "rayCastBatch", w_AABBTree_rayCastBatch },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_aabbtree(lua_State *L)
+{
+	return luax_register_type(L, &AABBTree::type, w_SpatialIndex_functions, w_AABBTree_functions, nullptr);
+}
+
+} // math
+} // love
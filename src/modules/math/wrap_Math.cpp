@@ -22,17 +22,26 @@
 #include "wrap_RandomGenerator.h"
 #include "wrap_BezierCurve.h"
 #include "wrap_Transform.h"
+#include "wrap_SpatialIndex.h"
+#include "wrap_AABBTree.h"
+#include "wrap_SpatialHash.h"
 #include "MathModule.h"
 #include "BezierCurve.h"
 #include "Transform.h"
+#include "Triangulator.h"
+#include "NoiseFill.h"
 
 #include "data/wrap_DataModule.h"
 #include "data/wrap_CompressedData.h"
 #include "data/DataModule.h"
+#include "data/ByteData.h"
+#include "image/ImageData.h"
 
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+#include <new>
 
 // Put the Lua code directly into a raw string literal.
 static const char math_lua[] =
@@ -149,6 +158,30 @@ int w_newTransform(lua_State *L)
 	return 1;
 }
 
+int w_newAABBTree(lua_State *L)
+{
+	float margin = (float) luaL_optnumber(L, 1, 2.0);
+
+	AABBTree *t = nullptr;
+	luax_catchexcept(L, [&](){ t = instance()->newAABBTree(margin); });
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
+int w_newSpatialHash(lua_State *L)
+{
+	float cellsize = (float) luaL_optnumber(L, 1, 64.0);
+
+	SpatialHash *t = nullptr;
+	luax_catchexcept(L, [&](){ t = instance()->newSpatialHash(cellsize); });
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
 int w_triangulate(lua_State *L)
 {
 	std::vector<love::Vector2> vertices;
@@ -219,6 +252,196 @@ int w_triangulate(lua_State *L)
 	return 1;
 }
 
+// Appends the x,y pairs of a flat coordinate table to coords.
+static size_t readPolygonRing(lua_State *L, int idx, std::vector<float> &coords)
+{
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	int count = (int) luax_objlen(L, idx) / 2;
+	if (count < 3)
+		luaL_error(L, "Need at least 3 vertices to triangulate");
+
+	for (int i = 0; i < count * 2; i++)
+	{
+		lua_rawgeti(L, idx, i + 1);
+		coords.push_back((float) luaL_checknumber(L, -1));
+		lua_pop(L, 1);
+	}
+
+	return (size_t) count;
+}
+
+// Appends the triangle vertex positions of one polygon to vertices.
+static size_t triangulatePolygon(lua_State *L, Triangulator &triangulator, const std::vector<float> &coords, const std::vector<size_t> &holes, std::vector<uint32> &indices, std::vector<float> &vertices)
+{
+	indices.clear();
+
+	size_t count = 0;
+	luax_catchexcept(L, [&]() { count = triangulator.triangulate(coords.data(), coords.size() / 2, holes, indices); });
+
+	for (uint32 i : indices)
+	{
+		vertices.push_back(coords[i * 2 + 0]);
+		vertices.push_back(coords[i * 2 + 1]);
+	}
+
+	return count;
+}
+
+// Pushes the vertices in a new Data, or copies them into an existing one.
+static void pushTriangleData(lua_State *L, int dataidx, const std::vector<float> &vertices)
+{
+	size_t size = vertices.size() * sizeof(float);
+
+	if (lua_isnoneornil(L, dataidx))
+	{
+		love::data::ByteData *d = nullptr;
+		luax_catchexcept(L, [&](){ d = new love::data::ByteData(std::max(size, (size_t) 1)); });
+
+		if (size > 0)
+			memcpy(d->getData(), vertices.data(), size);
+
+		luax_pushtype(L, d);
+		d->release();
+	}
+	else
+	{
+		love::Data *d = luax_checktype<love::Data>(L, dataidx);
+		if (d->getSize() < size)
+			luaL_error(L, "Data is too small to hold the triangles (%d bytes needed, %d available).", (int) size, (int) d->getSize());
+
+		if (size > 0)
+			memcpy(d->getData(), vertices.data(), size);
+
+		lua_pushvalue(L, dataidx);
+	}
+}
+
+struct TriangulationBuffers
+{
+	Triangulator triangulator;
+	std::vector<float> coords;
+	std::vector<size_t> holes;
+	std::vector<uint32> indices;
+	std::vector<float> vertices;
+};
+
+static const char *TRIANGULATION_BUFFERS_KEY = "_love_triangulationbuffers";
+
+static int w_TriangulationBuffers_gc(lua_State *L)
+{
+	TriangulationBuffers *b = (TriangulationBuffers *) lua_touserdata(L, 1);
+	b->~TriangulationBuffers();
+	return 0;
+}
+
+// Gets the buffers used by the triangulate functions. They're kept in the
+// registry, so each Lua state (and therefore each thread) has its own, and
+// repeated calls don't allocate once the buffers have grown large enough.
+static TriangulationBuffers *getTriangulationBuffers(lua_State *L)
+{
+	lua_getfield(L, LUA_REGISTRYINDEX, TRIANGULATION_BUFFERS_KEY);
+	TriangulationBuffers *b = (TriangulationBuffers *) lua_touserdata(L, -1);
+	lua_pop(L, 1);
+
+	if (b == nullptr)
+	{
+		void *mem = lua_newuserdata(L, sizeof(TriangulationBuffers));
+		b = new (mem) TriangulationBuffers();
+
+		lua_createtable(L, 0, 1);
+		lua_pushcfunction(L, w_TriangulationBuffers_gc);
+		lua_setfield(L, -2, "__gc");
+		lua_setmetatable(L, -2);
+
+		lua_setfield(L, LUA_REGISTRYINDEX, TRIANGULATION_BUFFERS_KEY);
+	}
+
+	b->coords.clear();
+	b->holes.clear();
+	b->indices.clear();
+	b->vertices.clear();
+
+	return b;
+}
+
+int w_triangulateFlat(lua_State *L)
+{
+	TriangulationBuffers *b = getTriangulationBuffers(L);
+	std::vector<float> &coords = b->coords;
+	std::vector<size_t> &holes = b->holes;
+
+	size_t vertexcount = readPolygonRing(L, 1, coords);
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		luaL_checktype(L, 2, LUA_TTABLE);
+		int holecount = (int) luax_objlen(L, 2);
+
+		for (int i = 1; i <= holecount; i++)
+		{
+			lua_rawgeti(L, 2, i);
+			holes.push_back(vertexcount);
+			vertexcount += readPolygonRing(L, -1, coords);
+			lua_pop(L, 1);
+		}
+	}
+
+	size_t count = triangulatePolygon(L, b->triangulator, coords, holes, b->indices, b->vertices);
+
+	pushTriangleData(L, 3, b->vertices);
+	lua_pushinteger(L, (lua_Integer) count);
+	return 2;
+}
+
+int w_triangulateBatch(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	int polycount = (int) luax_objlen(L, 1);
+
+	// The buffers are shared by all polygons in the batch.
+	TriangulationBuffers *b = getTriangulationBuffers(L);
+	std::vector<float> &coords = b->coords;
+	std::vector<size_t> &holes = b->holes;
+	std::vector<float> &vertices = b->vertices;
+
+	lua_createtable(L, polycount, 0);
+	int countsidx = lua_gettop(L);
+
+	for (int i = 1; i <= polycount; i++)
+	{
+		lua_rawgeti(L, 1, i);
+		luaL_checktype(L, -1, LUA_TTABLE);
+		int ringcount = (int) luax_objlen(L, -1);
+		if (ringcount < 1)
+			return luaL_error(L, "Polygon %d has no outline.", i);
+
+		coords.clear();
+		holes.clear();
+
+		size_t vertexcount = 0;
+		for (int ring = 1; ring <= ringcount; ring++)
+		{
+			lua_rawgeti(L, -1, ring);
+			if (ring > 1)
+				holes.push_back(vertexcount);
+			vertexcount += readPolygonRing(L, -1, coords);
+			lua_pop(L, 1);
+		}
+
+		lua_pop(L, 1);
+
+		size_t count = triangulatePolygon(L, b->triangulator, coords, holes, b->indices, vertices);
+
+		lua_pushinteger(L, (lua_Integer) count);
+		lua_rawseti(L, countsidx, i);
+	}
+
+	pushTriangleData(L, 2, vertices);
+	lua_pushvalue(L, countsidx);
+	return 2;
+}
+
 int w_isConvex(lua_State *L)
 {
 	std::vector<love::Vector2> vertices;
@@ -350,6 +573,89 @@ int w_noise(lua_State *L)
 	return 1;
 }
 
+int w_noiseFill(lua_State *L)
+{
+	luaL_checktype(L, 2, LUA_TTABLE);
+
+	NoiseFillParams params;
+
+	lua_getfield(L, 2, "fractal");
+	if (!lua_isnoneornil(L, -1))
+	{
+		const char *str = luaL_checkstring(L, -1);
+		if (!getConstant(str, params.fractal))
+			return luax_enumerror(L, "noise fractal type", getConstants(params.fractal), str);
+	}
+	lua_pop(L, 1);
+
+	params.dimensions = luax_intflag(L, 2, "dimensions", params.dimensions);
+	params.octaves = luax_intflag(L, 2, "octaves", params.octaves);
+	params.lacunarity = (float) luax_numberflag(L, 2, "lacunarity", params.lacunarity);
+	params.gain = (float) luax_numberflag(L, 2, "gain", params.gain);
+	params.x = (float) luax_numberflag(L, 2, "x", params.x);
+	params.y = (float) luax_numberflag(L, 2, "y", params.y);
+	params.z = (float) luax_numberflag(L, 2, "z", params.z);
+
+	float scale = (float) luax_numberflag(L, 2, "scale", 1.0);
+	params.scaleX = (float) luax_numberflag(L, 2, "scalex", scale);
+	params.scaleY = (float) luax_numberflag(L, 2, "scaley", scale);
+
+	if (luax_istype(L, 1, love::image::ImageData::type))
+	{
+		using love::image::ImageData;
+		ImageData *t = luax_checktype<ImageData>(L, 1);
+
+		int width = t->getWidth();
+		int height = t->getHeight();
+		size_t pixelsize = t->getPixelSize();
+		uint8 *pixels = (uint8 *) t->getData();
+
+		ImageData::PixelSetFunction setpixel = t->getPixelSetFunction();
+		if (setpixel == nullptr)
+			return luaL_error(L, "Unhandled pixel format in love.math.noiseFill.");
+
+		love::thread::Lock lock(t->getMutex());
+
+		luax_catchexcept(L, [&]() {
+			noiseFill(params, width, height, [&](int y, const float *row)
+			{
+				uint8 *dst = pixels + (size_t) y * width * pixelsize;
+				for (int x = 0; x < width; x++)
+				{
+					Colorf c(row[x], row[x], row[x], 1.0f);
+					setpixel(c, (ImageData::Pixel *) (dst + x * pixelsize));
+				}
+			});
+		});
+	}
+	else
+	{
+		// Any other Data is filled with a grid of 32-bit floats.
+		love::Data *t = luax_checktype<love::Data>(L, 1);
+
+		int width = luax_intflag(L, 2, "width", 0);
+		if (width <= 0)
+			return luaL_error(L, "A width must be given when filling a Data with noise.");
+
+		size_t rowsize = (size_t) width * sizeof(float);
+		int height = luax_intflag(L, 2, "height", (int) (t->getSize() / rowsize));
+
+		if (height <= 0 || (size_t) height * rowsize > t->getSize())
+			return luaL_error(L, "Data is too small to hold %d x %d floats.", width, height);
+
+		uint8 *dst = (uint8 *) t->getData();
+
+		luax_catchexcept(L, [&]() {
+			noiseFill(params, width, height, [&](int y, const float *row)
+			{
+				memcpy(dst + (size_t) y * rowsize, row, rowsize);
+			});
+		});
+	}
+
+	return 0;
+}
+
 int w_compress(lua_State *L)
 {
 	using namespace love::data;
@@ -457,11 +763,16 @@ static const luaL_Reg functions[] =
 	{ "newRandomGenerator", w_newRandomGenerator },
 	{ "newBezierCurve", w_newBezierCurve },
 	{ "newTransform", w_newTransform },
+	{ "newAABBTree", w_newAABBTree },
+	{ "newSpatialHash", w_newSpatialHash },
 	{ "triangulate", w_triangulate },
+	{ "triangulateFlat", w_triangulateFlat },
+	{ "triangulateBatch", w_triangulateBatch },
 	{ "isConvex", w_isConvex },
 	{ "gammaToLinear", w_gammaToLinear },
 	{ "linearToGamma", w_linearToGamma },
 	{ "noise", w_noise },
+	{ "noiseFill", w_noiseFill },
 
 	// Deprecated.
 	{ "compress", w_compress },
@@ -475,6 +786,9 @@ static const lua_CFunction types[] =
 	luaopen_randomgenerator,
 	luaopen_beziercurve,
 	luaopen_transform,
+	luaopen_spatialindex,
+	luaopen_aabbtree,
+	luaopen_spatialhash,
 	0
 };
 
@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_RandomGenerator.h"
+#include "common/Data.h"
 
 #include <cmath>
 #include <algorithm>
@@ -85,6 +86,93 @@ int w_RandomGenerator_randomNormal(lua_State *L)
 	return 1;
 }
 
+int w_RandomGenerator_fill(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	love::Data *data = luax_checktype<love::Data>(L, 2);
+
+	const char *str = luaL_checkstring(L, 3);
+	RandomGenerator::Distribution distribution;
+	if (!RandomGenerator::getConstant(str, distribution))
+		return luax_enumerror(L, "random distribution", RandomGenerator::getConstants(distribution), str);
+
+	// Every distribution writes 4-byte values.
+	size_t maxcount = data->getSize() / 4;
+	size_t count = maxcount;
+	if (!lua_isnoneornil(L, 4))
+	{
+		lua_Number n = luaL_checknumber(L, 4);
+		luaL_argcheck(L, n == n, 4, "count must not be NaN");
+		if (n < 0 || n > (lua_Number) maxcount)
+			return luaL_error(L, "Data is too small to hold %d random numbers.", (int) n);
+		count = (size_t) n;
+	}
+
+	double a = 0.0;
+	double b = 0.0;
+
+	if (distribution == RandomGenerator::DISTRIBUTION_UNIFORM)
+	{
+		a = luaL_optnumber(L, 5, 0.0);
+		b = luaL_optnumber(L, 6, 1.0);
+	}
+	else if (distribution == RandomGenerator::DISTRIBUTION_NORMAL)
+	{
+		a = luaL_optnumber(L, 5, 1.0);
+		b = luaL_optnumber(L, 6, 0.0);
+	}
+	else
+	{
+		// Like RandomGenerator:random, a single number is the upper bound.
+		if (lua_isnoneornil(L, 6))
+		{
+			a = 1.0;
+			b = floor(luaL_checknumber(L, 5));
+			luaL_argcheck(L, b == b, 5, "upper bound must not be NaN");
+		}
+		else
+		{
+			a = floor(luaL_checknumber(L, 5));
+			b = floor(luaL_checknumber(L, 6));
+			luaL_argcheck(L, a == a, 5, "lower bound must not be NaN");
+			luaL_argcheck(L, b == b, 6, "upper bound must not be NaN");
+		}
+
+		if (a > b || a < -LOVE_INT32_MAX - 1.0 || b > LOVE_INT32_MAX)
+			return luaL_error(L, "Invalid integer range for random numbers: [%d, %d]", (int) a, (int) b);
+	}
+
+	rng->fill(data->getData(), distribution, count, a, b);
+	return 0;
+}
+
+int w_RandomGenerator_jump(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	rng->jump();
+	return 0;
+}
+
+int w_RandomGenerator_split(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	int count = (int) luaL_optinteger(L, 2, 1);
+	if (count < 1)
+		return luaL_error(L, "Invalid number of random streams: %d", count);
+
+	luaL_checkstack(L, count, nullptr);
+
+	for (int i = 0; i < count; i++)
+	{
+		RandomGenerator *stream = nullptr;
+		luax_catchexcept(L, [&](){ stream = rng->split(); });
+		luax_pushtype(L, stream);
+		stream->release();
+	}
+
+	return count;
+}
+
 int w_RandomGenerator_setSeed(lua_State *L)
 {
 	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
@@ -141,6 +229,9 @@ static const luaL_Reg w_RandomGenerator_functions[] =
 {
 	{ "_random", w_RandomGenerator__random }, // random() is defined in wrap_RandomGenerator.lua.
 	{ "randomNormal", w_RandomGenerator_randomNormal },
+	{ "fill", w_RandomGenerator_fill },
+	{ "jump", w_RandomGenerator_jump },
+	{ "split", w_RandomGenerator_split },
 	{ "setSeed", w_RandomGenerator_setSeed },
 	{ "getSeed", w_RandomGenerator_getSeed },
 	{ "setState", w_RandomGenerator_setState },
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_SpatialHash.h"
+#include "wrap_SpatialIndex.h"
+
+namespace love
+{
+namespace math
+{
+
+SpatialHash *luax_checkspatialhash(lua_State *L, int idx)
+{
+	return luax_checktype<SpatialHash>(L, idx, SpatialHash::type);
+}
+
+int w_SpatialHash_getCellSize(lua_State *L)
+{
+	SpatialHash *t = luax_checkspatialhash(L, 1);
+	lua_pushnumber(L, t->getCellSize());
+	return 1;
+}
+
+static const luaL_Reg w_SpatialHash_functions[] =
+{
+	{ "getCellSize", w_SpatialHash_getCellSize },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_spatialhash(lua_State *L)
+{
+	return luax_register_type(L, &SpatialHash::type, w_SpatialIndex_functions, w_SpatialHash_functions, nullptr);
+}
+
+} // math
+} // love
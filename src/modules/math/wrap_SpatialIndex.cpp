@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2006-2021 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_SpatialIndex.h"
+#include "common/Data.h"
+
+// C++
+#include <cmath>
+
+namespace love
+{
+namespace math
+{
+
+SpatialIndex *luax_checkspatialindex(lua_State *L, int idx)
+{
+	return luax_checktype<SpatialIndex>(L, idx, SpatialIndex::type);
+}
+
+static int luax_checkid(lua_State *L, int idx)
+{
+	lua_Integer id = luaL_checkinteger(L, idx);
+	if (id < -LOVE_INT32_MAX - 1 || id > LOVE_INT32_MAX)
+		return luaL_argerror(L, idx, "id must be a 32-bit integer");
+	return (int) id;
+}
+
+static float luax_checkcoordinate(lua_State *L, int idx)
+{
+	float v = (float) luaL_checknumber(L, idx);
+	if (!std::isfinite(v))
+		luaL_argerror(L, idx, "number must be finite");
+	return v;
+}
+
+int w_SpatialIndex_add(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	int id = luax_checkid(L, 2);
+	float x = luax_checkcoordinate(L, 3);
+	float y = luax_checkcoordinate(L, 4);
+	float w = luax_checkcoordinate(L, 5);
+	float h = luax_checkcoordinate(L, 6);
+	luax_catchexcept(L, [&](){ t->add(id, x, y, w, h); });
+	return 0;
+}
+
+int w_SpatialIndex_move(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	int id = luax_checkid(L, 2);
+	float x = luax_checkcoordinate(L, 3);
+	float y = luax_checkcoordinate(L, 4);
+	float w = luax_checkcoordinate(L, 5);
+	float h = luax_checkcoordinate(L, 6);
+	float dx = (float) luaL_optnumber(L, 7, 0.0);
+	float dy = (float) luaL_optnumber(L, 8, 0.0);
+	luax_catchexcept(L, [&](){ t->move(id, x, y, w, h, dx, dy); });
+	return 0;
+}
+
+int w_SpatialIndex_remove(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	int id = luax_checkid(L, 2);
+	luax_pushboolean(L, t->remove(id));
+	return 1;
+}
+
+int w_SpatialIndex_has(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	int id = luax_checkid(L, 2);
+	float x, y, w, h;
+	luax_pushboolean(L, t->getRect(id, x, y, w, h));
+	return 1;
+}
+
+int w_SpatialIndex_getRect(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	int id = luax_checkid(L, 2);
+
+	float x, y, w, h;
+	if (!t->getRect(id, x, y, w, h))
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+
+	lua_pushnumber(L, x);
+	lua_pushnumber(L, y);
+	lua_pushnumber(L, w);
+	lua_pushnumber(L, h);
+	return 4;
+}
+
+int w_SpatialIndex_getCount(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	lua_pushinteger(L, t->getCount());
+	return 1;
+}
+
+int w_SpatialIndex_clear(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	t->clear();
+	return 0;
+}
+
+int w_SpatialIndex_query(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	float x = luax_checkcoordinate(L, 2);
+	float y = luax_checkcoordinate(L, 3);
+	float w = luax_checkcoordinate(L, 4);
+	float h = luax_checkcoordinate(L, 5);
+
+	// Results can go into an existing table, to avoid creating garbage.
+	if (lua_isnoneornil(L, 6))
+		lua_createtable(L, 0, 0);
+	else
+	{
+		luaL_checktype(L, 6, LUA_TTABLE);
+		lua_pushvalue(L, 6);
+	}
+
+	std::vector<int> ids;
+	t->query(x, y, w, h, ids);
+
+	int count = (int) ids.size();
+	for (int i = 0; i < count; i++)
+	{
+		lua_pushinteger(L, ids[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	// Clear leftovers from a previous, larger set of results.
+	int oldlength = (int) luax_objlen(L, -1);
+	for (int i = count + 1; i <= oldlength; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, -2, i);
+	}
+
+	lua_pushinteger(L, count);
+	return 2;
+}
+
+int w_SpatialIndex_queryBatch(lua_State *L)
+{
+	SpatialIndex *t = luax_checkspatialindex(L, 1);
+	love::Data *boxdata = luax_checktype<love::Data>(L, 2);
+	love::Data *hitdata = luax_checktype<love::Data>(L, 3);
+
+	if (boxdata == hitdata)
+		return luaL_error(L, "The box and hit Data must be different objects.");
+
+	int boxcount = (int) (boxdata->getSize() / (sizeof(float) * 4));
+	int maxhits = (int) (hitdata->getSize() / (sizeof(int32) * SpatialIndex::QUERY_HIT_COMPONENTS));
+
+	bool complete = true;
+	int count = t->queryBatch((const float *) boxdata->getData(), boxcount, (int32 *) hitdata->getData(), maxhits, complete);
+
+	lua_pushinteger(L, count);
+	luax_pushboolean(L, complete);
+	return 2;
+}
+
+const luaL_Reg w_SpatialIndex_functions[] =
+{
+	{ "add", w_SpatialIndex_add },
+	{ "move", w_SpatialIndex_move },
+	{ "remove", w_SpatialIndex_remove },
+	{ "has", w_SpatialIndex_has },
+	{ "getRect", w_SpatialIndex_getRect },
+	{ "getCount", w_SpatialIndex_getCount },
+	{ "clear", w_SpatialIndex_clear },
+	{ "query", w_SpatialIndex_query },
+	{ "queryBatch", w_SpatialIndex_queryBatch },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_spatialindex(lua_State *L)
+{
+	return luax_register_type(L, &SpatialIndex::type, w_SpatialIndex_functions, nullptr);
+}
+
+} // math
+} // love
@@ -45,6 +45,7 @@ Body::Body(World *world, b2Vec2 p, Body::Type type)
 	udata->ref = nullptr;
 	b2BodyDef def;
 	def.position = Physics::scaleDown(p);
+	udata->previousPosition = def.position;
 	def.userData = (void *) udata;
 	body = world->world->CreateBody(&def);
 	// Box2D body holds a reference to the love Body.
@@ -81,6 +82,14 @@ void Body::getPosition(float &x_o, float &y_o)
 	y_o = v.y;
 }
 
+void Body::getInterpolatedTransform(float &x_o, float &y_o, float &angle_o)
+{
+	b2Vec2 v;
+	world->getInterpolatedTransform(body, v, angle_o);
+	x_o = v.x;
+	y_o = v.y;
+}
+
 void Body::getLinearVelocity(float &x_o, float &y_o)
 {
 	b2Vec2 v = Physics::scaleUp(body->GetLinearVelocity());
@@ -509,14 +518,7 @@ int Body::getContacts(lua_State *L) const
 		if (!ce)
 			break;
 
-		Contact *contact = (Contact *) world->findObject(ce->contact);
-		if (!contact)
-			contact = new Contact(world, ce->contact);
-		else
-			contact->retain();
-
-		luax_pushtype(L, contact);
-		contact->release();
+		luax_pushtype(L, world->getContact(ce->contact));
 		lua_rawseti(L, -2, i);
 		i++;
 	}
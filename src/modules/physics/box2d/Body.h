@@ -49,6 +49,10 @@ struct bodyudata
 {
 	// Reference to arbitrary data.
 	Reference *ref = nullptr;
+
+	// Transform before the last step taken by World::advance, in Box2D units.
+	b2Vec2 previousPosition = b2Vec2(0.0f, 0.0f);
+	float32 previousAngle = 0.0f;
 };
 
 /**
@@ -101,6 +105,16 @@ public:
 	 **/
 	void getPosition(float &x_o, float &y_o);
 
+	/**
+	 * Gets the position and angle of the Body interpolated between its
+	 * transforms before and after the last fixed step taken by
+	 * World::advance.
+	 * @param[out] x_o The x-component of the position.
+	 * @param[out] y_o The y-component of the position.
+	 * @param[out] angle_o The angle.
+	 **/
+	void getInterpolatedTransform(float &x_o, float &y_o, float &angle_o);
+
 	/**
 	 * Gets the velocity in the current center of mass.
 	 * @param[out] x_o The x-component of the velocity.
@@ -346,6 +346,12 @@ void Fixture::destroy(bool implicit)
 
 	shape.set(nullptr);
 
+	if (udata != nullptr && udata->handle != 0)
+	{
+		body->world->releaseFixtureHandle(udata->handle);
+		udata->handle = 0;
+	}
+
 	if (!implicit && fixture != nullptr)
 		body->body->DestroyFixture(fixture);
 	body->world->unregisterObject(fixture);
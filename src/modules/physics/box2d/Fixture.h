@@ -50,6 +50,12 @@ struct fixtureudata
 {
 	// Reference to arbitrary data.
 	Reference *ref = nullptr;
+
+	// Handle used by World's batched queries, or 0 if none was assigned.
+	int32 handle = 0;
+
+	// Last batched query which reported this Fixture.
+	uint32 batchStamp = 0;
 };
 
 /**
@@ -20,15 +20,23 @@
 
 #include "World.h"
 
+#include "Body.h"
 #include "Fixture.h"
 #include "Shape.h"
 #include "Contact.h"
 #include "Physics.h"
 #include "common/Reference.h"
+#include "common/int.h"
+#include "thread/threads.h"
 
 // Needed for World::getJoints. It should be moved to wrapper code...
 #include "wrap_Joint.h"
 
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace love
 {
 namespace physics
@@ -76,14 +84,7 @@ void World::ContactCallback::process(b2Contact *contact, const b2ContactImpulse
 				throw love::Exception("A fixture has escaped Memoizer!");
 		}
 
-		Contact *cobj = (Contact *)world->findObject(contact);
-		if (!cobj)
-			cobj = new Contact(world, contact);
-		else
-			cobj->retain();
-
-		luax_pushtype(L, cobj);
-		cobj->release();
+		luax_pushtype(L, world->getContact(contact));
 
 		int args = 3;
 		if (impulse)
@@ -216,6 +217,11 @@ void World::SayGoodbye(b2Fixture *fixture)
 	if (f) f->destroy(true);
 }
 
+void World::SayGoodbye(b2Contact *contact)
+{
+	releaseContact(contact);
+}
+
 void World::SayGoodbye(b2Joint *joint)
 {
 	Joint *j = (Joint *)findObject(joint);
@@ -223,13 +229,47 @@ void World::SayGoodbye(b2Joint *joint)
 	if (j) j->destroyJoint(true);
 }
 
+class World::TaskExecutor : public b2TaskExecutor
+{
+public:
+
+	TaskExecutor(int threadCount)
+		: pool(threadCount)
+	{
+	}
+
+	int32 GetWorkerCount() const override
+	{
+		return pool.getThreadCount();
+	}
+
+	void Run(b2Task *task, int32 count) override
+	{
+		pool.run(count, [task](int i, int worker) { task->Execute(i, worker); });
+	}
+
+private:
+
+	thread::WorkerPool pool;
+};
+
 World::World()
 	: world(nullptr)
+	, taskExecutor(nullptr)
 	, destructWorld(false)
 	, begin(this)
 	, end(this)
 	, presolve(this)
 	, postsolve(this)
+	, bufferContactEvents()
+	, lastProfile()
+	, profileTotals()
+	, profileSteps(0)
+	, profileHistorySize(0)
+	, profileHistoryNext(0)
+	, stepAccumulator(0.0f)
+	, interpolationAlpha(1.0f)
+	, batchStamp(0)
 {
 	world = new b2World(b2Vec2(0,0));
 	world->SetAllowSleeping(true);
@@ -243,11 +283,21 @@ World::World()
 
 World::World(b2Vec2 gravity, bool sleep)
 	: world(nullptr)
+	, taskExecutor(nullptr)
 	, destructWorld(false)
 	, begin(this)
 	, end(this)
 	, presolve(this)
 	, postsolve(this)
+	, bufferContactEvents()
+	, lastProfile()
+	, profileTotals()
+	, profileSteps(0)
+	, profileHistorySize(0)
+	, profileHistoryNext(0)
+	, stepAccumulator(0.0f)
+	, interpolationAlpha(1.0f)
+	, batchStamp(0)
 {
 	world = new b2World(Physics::scaleDown(gravity));
 	world->SetAllowSleeping(sleep);
@@ -273,6 +323,11 @@ void World::update(float dt, int velocityIterations, int positionIterations)
 {
 	world->Step(dt, velocityIterations, positionIterations);
 
+	recordProfile();
+
+	// Set again by advance when it's the caller.
+	interpolationAlpha = 1.0f;
+
 	// Destroy all objects marked during the time step.
 	for (Body *b : destructBodies)
 	{
@@ -300,19 +355,189 @@ void World::update(float dt, int velocityIterations, int positionIterations)
 		destroy();
 }
 
+int World::advance(float frameDt, float fixedStep, int maxSteps, int velocityIterations, int positionIterations)
+{
+	if (fixedStep <= 0.0f)
+		throw love::Exception("The fixed time step must be greater than 0.");
+
+	if (maxSteps < 1)
+		throw love::Exception("The maximum number of steps must be at least 1.");
+
+	stepAccumulator += std::max(frameDt, 0.0f);
+
+	int steps = 0;
+	while (stepAccumulator >= fixedStep && steps < maxSteps)
+	{
+		savePreviousTransforms();
+		update(fixedStep, velocityIterations, positionIterations);
+		stepAccumulator -= fixedStep;
+		steps++;
+
+		// A callback may have destroyed the World.
+		if (world == nullptr)
+			return steps;
+	}
+
+	// Drop the time we couldn't catch up on, so we don't fall further behind
+	// on every call.
+	if (stepAccumulator >= fixedStep)
+		stepAccumulator = std::fmod(stepAccumulator, fixedStep);
+
+	interpolationAlpha = std::min(stepAccumulator / fixedStep, 1.0f);
+	return steps;
+}
+
+float World::getInterpolationAlpha() const
+{
+	return interpolationAlpha;
+}
+
+void World::savePreviousTransforms()
+{
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		bodyudata *udata = (bodyudata *) b->GetUserData();
+		if (udata == nullptr)
+			continue;
+
+		udata->previousPosition = b->GetPosition();
+		udata->previousAngle = b->GetAngle();
+	}
+}
+
+void World::resetInterpolation()
+{
+	if (world->IsLocked())
+		throw love::Exception("Interpolation cannot be reset while the World is updating.");
+
+	savePreviousTransforms();
+}
+
+void World::getInterpolatedTransform(b2Body *body, b2Vec2 &position, float &angle) const
+{
+	const bodyudata *udata = (const bodyudata *) body->GetUserData();
+	float a = interpolationAlpha;
+
+	if (udata == nullptr || a >= 1.0f)
+	{
+		position = Physics::scaleUp(body->GetPosition());
+		angle = body->GetAngle();
+		return;
+	}
+
+	position = Physics::scaleUp(a * body->GetPosition() + (1.0f - a) * udata->previousPosition);
+	angle = a * body->GetAngle() + (1.0f - a) * udata->previousAngle;
+}
+
+void World::recordProfile()
+{
+	const b2Profile &p = world->GetProfile();
+	double *v = lastProfile.values;
+
+	// Box2D measures time in milliseconds.
+	v[PROFILE_STEP] = p.step / 1000.0;
+	v[PROFILE_COLLIDE] = p.collide / 1000.0;
+	v[PROFILE_SOLVE] = p.solve / 1000.0;
+	v[PROFILE_SOLVE_INIT] = p.solveInit / 1000.0;
+	v[PROFILE_SOLVE_VELOCITY] = p.solveVelocity / 1000.0;
+	v[PROFILE_SOLVE_POSITION] = p.solvePosition / 1000.0;
+	v[PROFILE_BROADPHASE] = p.broadphase / 1000.0;
+	v[PROFILE_SOLVE_TOI] = p.solveTOI / 1000.0;
+	v[PROFILE_CONTACTS_CREATED] = p.contactsCreated;
+	v[PROFILE_CONTACTS_DESTROYED] = p.contactsDestroyed;
+	v[PROFILE_ISLANDS] = p.islands;
+	v[PROFILE_TOI_EVENTS] = p.toiEvents;
+	v[PROFILE_PROXY_MOVES] = p.proxyMoves;
+
+	for (int i = 0; i < PROFILE_MAX_ENUM; i++)
+		profileTotals.values[i] += v[i];
+	profileSteps++;
+
+	if (profileHistorySize <= 0)
+		return;
+
+	if (profileHistory.size() < (size_t) profileHistorySize)
+		profileHistory.push_back(lastProfile);
+	else
+		profileHistory[profileHistoryNext] = lastProfile;
+
+	profileHistoryNext = (profileHistoryNext + 1) % profileHistorySize;
+}
+
+const World::Profile &World::getProfile() const
+{
+	return lastProfile;
+}
+
+const World::Profile &World::getProfileTotals(int &steps) const
+{
+	steps = profileSteps;
+	return profileTotals;
+}
+
+void World::setProfileHistorySize(int size)
+{
+	if (size < 0)
+		size = 0;
+
+	if (size == profileHistorySize)
+		return;
+
+	// Keep the most recent profiles which still fit.
+	std::vector<Profile> history;
+	history.reserve(std::min<size_t>(size, profileHistory.size()));
+
+	size_t count = profileHistory.size();
+	size_t first = count < (size_t) profileHistorySize ? 0 : profileHistoryNext;
+	size_t skip = count > (size_t) size ? count - size : 0;
+	for (size_t i = skip; i < count; i++)
+		history.push_back(profileHistory[(first + i) % count]);
+
+	profileHistory = std::move(history);
+	profileHistorySize = size;
+	profileHistoryNext = size > 0 ? profileHistory.size() % size : 0;
+}
+
+int World::getProfileHistorySize() const
+{
+	return profileHistorySize;
+}
+
+void World::getProfileHistory(ProfileField field, std::vector<double> &values) const
+{
+	size_t count = profileHistory.size();
+	size_t first = count < (size_t) profileHistorySize ? 0 : profileHistoryNext;
+
+	values.resize(count);
+	for (size_t i = 0; i < count; i++)
+		values[i] = profileHistory[(first + i) % count].values[field];
+}
+
+void World::resetProfile()
+{
+	profileTotals = Profile();
+	profileSteps = 0;
+	profileHistory.clear();
+	profileHistoryNext = 0;
+}
+
 void World::BeginContact(b2Contact *contact)
 {
-	begin.process(contact);
+	if (bufferContactEvents[CONTACT_EVENT_BEGIN])
+		bufferContactEvent(CONTACT_EVENT_BEGIN, contact);
+	else
+		begin.process(contact);
 }
 
 void World::EndContact(b2Contact *contact)
 {
-	end.process(contact);
+	if (bufferContactEvents[CONTACT_EVENT_END])
+		bufferContactEvent(CONTACT_EVENT_END, contact);
+	else
+		end.process(contact);
 
 	// Letting the Contact know that the b2Contact will be destroyed any second.
-	Contact *c = (Contact *)findObject(contact);
-	if (c != nullptr)
-		c->invalidate();
+	releaseContact(contact);
 }
 
 void World::PreSolve(b2Contact *contact, const b2Manifold *oldManifold)
@@ -323,7 +548,91 @@ void World::PreSolve(b2Contact *contact, const b2Manifold *oldManifold)
 
 void World::PostSolve(b2Contact *contact, const b2ContactImpulse *impulse)
 {
-	postsolve.process(contact, impulse);
+	if (bufferContactEvents[CONTACT_EVENT_POSTSOLVE])
+		bufferContactEvent(CONTACT_EVENT_POSTSOLVE, contact, impulse);
+	else
+		postsolve.process(contact, impulse);
+}
+
+void World::bufferContactEvent(ContactEventType type, b2Contact *contact, const b2ContactImpulse *impulse)
+{
+	Fixture *a = (Fixture *)findObject(contact->GetFixtureA());
+	Fixture *b = (Fixture *)findObject(contact->GetFixtureB());
+	if (!a || !b)
+		throw love::Exception("A fixture has escaped Memoizer!");
+
+	ContactEvent event = {};
+	event.type = type;
+	event.fixtureA = a;
+	event.fixtureB = b;
+
+	if (contact->GetManifold()->pointCount > 0)
+	{
+		b2WorldManifold manifold;
+		contact->GetWorldManifold(&manifold);
+
+		b2Vec2 point = Physics::scaleUp(manifold.points[0]);
+		event.normalX = manifold.normal.x;
+		event.normalY = manifold.normal.y;
+		event.x = point.x;
+		event.y = point.y;
+	}
+
+	if (impulse)
+	{
+		for (int c = 0; c < impulse->count; c++)
+		{
+			event.normalImpulse += Physics::scaleUp(impulse->normalImpulses[c]);
+			event.tangentImpulse += Physics::scaleUp(impulse->tangentImpulses[c]);
+		}
+	}
+
+	if (contactEvents.size() >= MAX_BUFFERED_CONTACT_EVENTS)
+	{
+		contactEvents.front().fixtureA->release();
+		contactEvents.front().fixtureB->release();
+		contactEvents.pop_front();
+	}
+
+	// The Fixtures might be destroyed before the events are retrieved.
+	a->retain();
+	b->retain();
+
+	contactEvents.push_back(event);
+}
+
+void World::clearContactEvents()
+{
+	for (const ContactEvent &event : contactEvents)
+	{
+		event.fixtureA->release();
+		event.fixtureB->release();
+	}
+
+	contactEvents.clear();
+}
+
+void World::setContactBuffering(bool begin, bool end, bool postsolve)
+{
+	bufferContactEvents[CONTACT_EVENT_BEGIN] = begin;
+	bufferContactEvents[CONTACT_EVENT_END] = end;
+	bufferContactEvents[CONTACT_EVENT_POSTSOLVE] = postsolve;
+
+	// Nothing would retrieve the events anymore.
+	if (!begin && !end && !postsolve)
+		clearContactEvents();
+}
+
+void World::getContactBuffering(bool &begin, bool &end, bool &postsolve) const
+{
+	begin = bufferContactEvents[CONTACT_EVENT_BEGIN];
+	end = bufferContactEvents[CONTACT_EVENT_END];
+	postsolve = bufferContactEvents[CONTACT_EVENT_POSTSOLVE];
+}
+
+const std::deque<World::ContactEvent> &World::getContactEvents() const
+{
+	return contactEvents;
 }
 
 bool World::ShouldCollide(b2Fixture *fixtureA, b2Fixture *fixtureB)
@@ -454,6 +763,30 @@ bool World::isSleepingAllowed() const
 	return world->GetAllowSleeping();
 }
 
+void World::setThreadCount(int count)
+{
+	if (world->IsLocked())
+		throw love::Exception("The thread count of a World cannot be changed during a time step.");
+
+	if (count == getThreadCount())
+		return;
+
+	world->SetTaskExecutor(nullptr);
+	delete taskExecutor;
+	taskExecutor = nullptr;
+
+	if (count > 1)
+	{
+		taskExecutor = new TaskExecutor(count);
+		world->SetTaskExecutor(taskExecutor);
+	}
+}
+
+int World::getThreadCount() const
+{
+	return taskExecutor != nullptr ? taskExecutor->GetWorkerCount() : 1;
+}
+
 bool World::isLocked() const
 {
 	return world->IsLocked();
@@ -522,13 +855,7 @@ int World::getContacts(lua_State *L)
 	do
 	{
 		if (!c) break;
-		Contact *contact = (Contact *)findObject(c);
-		if (!contact)
-			contact = new Contact(this, c);
-		else
-			contact->retain();
-		luax_pushtype(L, contact);
-		contact->release();
+		luax_pushtype(L, getContact(c));
 		lua_rawseti(L, -2, i);
 		i++;
 	}
@@ -536,6 +863,206 @@ int World::getContacts(lua_State *L)
 	return 1;
 }
 
+int World::getBodyStates(const std::vector<Body *> *bodies, float *dst, int maxBodies, bool interpolated) const
+{
+	auto write = [&](b2Body *b, float *out)
+	{
+		b2Vec2 position;
+		float angle;
+		b2Vec2 velocity = Physics::scaleUp(b->GetLinearVelocity());
+
+		if (interpolated)
+			getInterpolatedTransform(b, position, angle);
+		else
+		{
+			position = Physics::scaleUp(b->GetPosition());
+			angle = b->GetAngle();
+		}
+
+		out[0] = position.x;
+		out[1] = position.y;
+		out[2] = angle;
+		out[3] = velocity.x;
+		out[4] = velocity.y;
+		out[5] = b->GetAngularVelocity();
+	};
+
+	int count = 0;
+
+	if (bodies != nullptr)
+	{
+		if ((int) bodies->size() > maxBodies)
+			throw love::Exception("Not enough space for %d Body states (space for %d).", (int) bodies->size(), maxBodies);
+
+		for (Body *body : *bodies)
+		{
+			if (body->body == nullptr)
+				throw love::Exception("Attempt to use destroyed body.");
+			write(body->body, dst + count * BODY_STATE_COMPONENTS);
+			count++;
+		}
+
+		return count;
+	}
+
+	if (getBodyCount() > maxBodies)
+		throw love::Exception("Not enough space for %d Body states (space for %d).", getBodyCount(), maxBodies);
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+		write(b, dst + count * BODY_STATE_COMPONENTS);
+		count++;
+	}
+
+	return count;
+}
+
+int World::setBodyStates(const std::vector<Body *> *bodies, const float *src, int maxBodies)
+{
+	if (world->IsLocked())
+		throw love::Exception("Body states cannot be set while the World is updating.");
+
+	auto read = [&](b2Body *b, const float *in)
+	{
+		b->SetTransform(Physics::scaleDown(b2Vec2(in[0], in[1])), in[2]);
+		b->SetLinearVelocity(Physics::scaleDown(b2Vec2(in[3], in[4])));
+		b->SetAngularVelocity(in[5]);
+	};
+
+	int count = 0;
+
+	if (bodies != nullptr)
+	{
+		if ((int) bodies->size() > maxBodies)
+			throw love::Exception("Not enough Body states for %d Bodies (%d given).", (int) bodies->size(), maxBodies);
+
+		for (Body *body : *bodies)
+		{
+			if (body->body == nullptr)
+				throw love::Exception("Attempt to use destroyed body.");
+			read(body->body, src + count * BODY_STATE_COMPONENTS);
+			count++;
+		}
+
+		return count;
+	}
+
+	if (getBodyCount() > maxBodies)
+		throw love::Exception("Not enough Body states for %d Bodies (%d given).", getBodyCount(), maxBodies);
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+		read(b, src + count * BODY_STATE_COMPONENTS);
+		count++;
+	}
+
+	return count;
+}
+
+size_t World::getSerializedSize() const
+{
+	// The size of the Box2D state, then the state itself.
+	size_t size = sizeof(uint32) + (size_t) world->GetStateSize();
+
+	// The accumulator and alpha of advance, then the previous transform of
+	// each Body.
+	size += sizeof(float) * 2;
+	size += sizeof(float) * 3 * getBodyCount();
+
+	return size;
+}
+
+void World::serialize(void *dst) const
+{
+	if (world->IsLocked())
+		throw love::Exception("The World cannot be serialized while it is updating.");
+
+	char *out = (char *) dst;
+
+	uint32 statesize = (uint32) world->GetStateSize();
+	memcpy(out, &statesize, sizeof(uint32));
+	out += sizeof(uint32);
+
+	world->SaveState(out);
+	out += statesize;
+
+	auto writefloat = [&](float v)
+	{
+		memcpy(out, &v, sizeof(float));
+		out += sizeof(float);
+	};
+
+	writefloat(stepAccumulator);
+	writefloat(interpolationAlpha);
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		const bodyudata *udata = (const bodyudata *) b->GetUserData();
+		if (udata == nullptr)
+			continue;
+
+		writefloat(udata->previousPosition.x);
+		writefloat(udata->previousPosition.y);
+		writefloat(udata->previousAngle);
+	}
+}
+
+void World::deserialize(const void *src, size_t size)
+{
+	if (world->IsLocked())
+		throw love::Exception("The World cannot be deserialized while it is updating.");
+
+	const char *in = (const char *) src;
+
+	uint32 statesize = 0;
+	if (size < sizeof(uint32))
+		throw love::Exception("Invalid World data size: %d bytes.", (int) size);
+
+	memcpy(&statesize, in, sizeof(uint32));
+	in += sizeof(uint32);
+
+	// Anything after the state and extras is ignored, so the data may come
+	// from a larger or reused Data object.
+	size_t extrasize = sizeof(float) * (2 + 3 * getBodyCount());
+	size_t available = size - sizeof(uint32);
+	if (statesize > (uint32) LOVE_INT32_MAX || statesize > available || available - statesize < extrasize)
+		throw love::Exception("Invalid World data size: %d bytes.", (int) size);
+
+	if (!world->RestoreState(in, (int32) statesize))
+		throw love::Exception("The World data does not match the Bodies, Fixtures and Joints of this World.");
+
+	in += statesize;
+
+	// Buffered events refer to contacts from before the restore.
+	clearContactEvents();
+
+	auto readfloat = [&]()
+	{
+		float v;
+		memcpy(&v, in, sizeof(float));
+		in += sizeof(float);
+		return v;
+	};
+
+	stepAccumulator = readfloat();
+	interpolationAlpha = readfloat();
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		bodyudata *udata = (bodyudata *) b->GetUserData();
+		if (udata == nullptr)
+			continue;
+
+		udata->previousPosition.x = readfloat();
+		udata->previousPosition.y = readfloat();
+		udata->previousAngle = readfloat();
+	}
+}
+
 b2Body *World::getGroundBody() const
 {
 	return groundBody;
@@ -570,6 +1097,218 @@ int World::rayCast(lua_State *L)
 	return 0;
 }
 
+class World::BatchRayCastCallback : public b2RayCastCallback
+{
+public:
+
+	BatchRayCastCallback(RayCastMode mode, std::vector<BatchRayHit> &hits)
+		: mode(mode)
+		, hits(hits)
+	{
+	}
+
+	float32 ReportFixture(b2Fixture *fixture, const b2Vec2 &point, const b2Vec2 &normal, float32 fraction) override
+	{
+		BatchRayHit hit = {fixture, point, normal, fraction, (int) hits.size()};
+
+		switch (mode)
+		{
+		case RAYCAST_CLOSEST:
+			// Box2D clips the ray to the returned fraction, so later hits are
+			// usually (but not always) closer.
+			if (hits.empty())
+				hits.push_back(hit);
+			else if (fraction < hits[0].fraction)
+				hits[0] = hit;
+			return fraction;
+		case RAYCAST_ANY:
+			hits.push_back(hit);
+			return 0.0f;
+		case RAYCAST_ALL:
+		default:
+			// Sorted once the ray is done.
+			hits.push_back(hit);
+			return 1.0f;
+		}
+	}
+
+	RayCastMode mode;
+	std::vector<BatchRayHit> &hits;
+};
+
+class World::BatchQueryCallback : public b2QueryCallback
+{
+public:
+
+	BatchQueryCallback(std::vector<b2Fixture *> &fixtures)
+		: fixtures(fixtures)
+	{
+	}
+
+	bool ReportFixture(b2Fixture *fixture) override
+	{
+		fixtures.push_back(fixture);
+		return true;
+	}
+
+	std::vector<b2Fixture *> &fixtures;
+};
+
+int32 World::getFixtureHandle(b2Fixture *fixture)
+{
+	fixtureudata *udata = (fixtureudata *) fixture->GetUserData();
+
+	if (udata->handle == 0)
+	{
+		Fixture *f = (Fixture *) findObject(fixture);
+		if (!f)
+			throw love::Exception("A fixture has escaped Memoizer!");
+
+		if (fixtureHandles.empty())
+			fixtureHandles.push_back(nullptr);
+
+		if (!freeFixtureHandles.empty())
+		{
+			udata->handle = freeFixtureHandles.back();
+			freeFixtureHandles.pop_back();
+			fixtureHandles[udata->handle] = f;
+		}
+		else
+		{
+			udata->handle = (int32) fixtureHandles.size();
+			fixtureHandles.push_back(f);
+		}
+	}
+
+	if (udata->batchStamp != batchStamp)
+	{
+		udata->batchStamp = batchStamp;
+		batchFixtureHandles.push_back(udata->handle);
+	}
+
+	return udata->handle;
+}
+
+int World::rayCastBatch(const float *rays, int rayCount, RayCastMode mode, RayCastHit *hits, int maxHits, bool &complete)
+{
+	BatchRayCastCallback callback(mode, batchRayHits);
+	int count = 0;
+	complete = true;
+	batchFixtureHandles.clear();
+	batchStamp++;
+
+	for (int i = 0; i < rayCount; i++)
+	{
+		const float *ray = rays + i * 4;
+		b2Vec2 p1 = Physics::scaleDown(b2Vec2(ray[0], ray[1]));
+		b2Vec2 p2 = Physics::scaleDown(b2Vec2(ray[2], ray[3]));
+
+		// Box2D asserts on zero-length rays.
+		if ((p2 - p1).LengthSquared() <= 0.0f)
+			continue;
+
+		batchRayHits.clear();
+		world->RayCast(&callback, p1, p2);
+
+		if (mode == RAYCAST_ALL)
+		{
+			// Sorted by fraction, with ties in the order they're reported.
+			std::sort(batchRayHits.begin(), batchRayHits.end(), [](const BatchRayHit &a, const BatchRayHit &b)
+			{
+				if (a.fraction != b.fraction)
+					return a.fraction < b.fraction;
+				return a.order < b.order;
+			});
+		}
+
+		for (const BatchRayHit &hit : batchRayHits)
+		{
+			if (count >= maxHits)
+			{
+				complete = false;
+				return count;
+			}
+
+			b2Vec2 point = Physics::scaleUp(hit.point);
+
+			RayCastHit &dst = hits[count];
+			dst.ray = i + 1;
+			dst.fixture = getFixtureHandle(hit.fixture);
+			dst.x = point.x;
+			dst.y = point.y;
+			dst.normalX = hit.normal.x;
+			dst.normalY = hit.normal.y;
+			dst.fraction = hit.fraction;
+
+			count++;
+		}
+	}
+
+	return count;
+}
+
+int World::queryBoundingBoxBatch(const float *boxes, int boxCount, QueryHit *hits, int maxHits, bool &complete)
+{
+	BatchQueryCallback callback(batchQueryFixtures);
+	int count = 0;
+	complete = true;
+	batchFixtureHandles.clear();
+	batchStamp++;
+
+	for (int i = 0; i < boxCount; i++)
+	{
+		const float *box = boxes + i * 4;
+
+		b2AABB aabb;
+		aabb.lowerBound = Physics::scaleDown(b2Vec2(box[0], box[1]));
+		aabb.upperBound = Physics::scaleDown(b2Vec2(box[2], box[3]));
+
+		batchQueryFixtures.clear();
+		world->QueryAABB(&callback, aabb);
+
+		for (b2Fixture *fixture : batchQueryFixtures)
+		{
+			if (count >= maxHits)
+			{
+				complete = false;
+				return count;
+			}
+
+			b2Vec2 position = Physics::scaleUp(fixture->GetBody()->GetPosition());
+
+			QueryHit &dst = hits[count];
+			dst.box = i + 1;
+			dst.fixture = getFixtureHandle(fixture);
+			dst.x = position.x;
+			dst.y = position.y;
+
+			count++;
+		}
+	}
+
+	return count;
+}
+
+const std::vector<int32> &World::getBatchFixtureHandles() const
+{
+	return batchFixtureHandles;
+}
+
+Fixture *World::getFixtureFromHandle(int32 handle) const
+{
+	if (handle <= 0 || handle >= (int32) fixtureHandles.size())
+		return nullptr;
+	return fixtureHandles[handle];
+}
+
+void World::releaseFixtureHandle(int32 handle)
+{
+	if (handle <= 0 || handle >= (int32) fixtureHandles.size())
+		return;
+	fixtureHandles[handle] = nullptr;
+	freeFixtureHandles.push_back(handle);
+}
+
 void World::destroy()
 {
 	if (world == nullptr)
@@ -591,6 +1330,10 @@ void World::destroy()
 	//disable callbacks
 	begin.ref = end.ref = presolve.ref = postsolve.ref = filter.ref = nullptr;
 
+	// Destroying the bodies below would otherwise record end events. This
+	// also clears any buffered events.
+	setContactBuffering(false, false, false);
+
 	// Cleaning up the world.
 	b2Body *b = world->GetBodyList();
 	while (b)
@@ -610,27 +1353,137 @@ void World::destroy()
 
 	delete world;
 	world = nullptr;
+
+	delete taskExecutor;
+	taskExecutor = nullptr;
+
+	for (Contact *c : contactPool)
+		c->release();
+	contactPool.clear();
+}
+
+Contact *World::getContact(b2Contact *contact)
+{
+	Contact *c = (Contact *) findObject(contact);
+	if (c != nullptr)
+		return c;
+
+	if (!contactPool.empty())
+	{
+		c = contactPool.back();
+		contactPool.pop_back();
+		c->contact = contact;
+		registerObject(contact, c);
+	}
+	else
+		c = new Contact(this, contact);
+
+	// Released in releaseContact.
+	return c;
+}
+
+void World::releaseContact(b2Contact *contact)
+{
+	Contact *c = (Contact *) findObject(contact);
+	if (c == nullptr)
+		return;
+
+	c->invalidate();
+
+	// Lua may still hold the Contact, in which case it stays invalid.
+	if (c->getReferenceCount() == 1 && contactPool.size() < MAX_POOLED_CONTACTS)
+		contactPool.push_back(c);
+	else
+		c->release();
 }
 
 void World::registerObject(void *b2object, love::Object *object)
 {
-	box2dObjectMap[b2object] = object;
+	box2dObjectMap.set(b2object, object);
 }
 
 void World::unregisterObject(void *b2object)
 {
-	box2dObjectMap.erase(b2object);
+	box2dObjectMap.remove(b2object);
 }
 
 love::Object *World::findObject(void *b2object) const
 {
-	auto it = box2dObjectMap.find(b2object);
-	if (it != box2dObjectMap.end())
-		return it->second;
-	else
-		return nullptr;
+	return box2dObjectMap.get(b2object, nullptr);
 }
 
+bool World::getConstant(const char *in, ContactEventType &out)
+{
+	return contactEventTypes.find(in, out);
+}
+
+bool World::getConstant(ContactEventType in, const char *&out)
+{
+	return contactEventTypes.find(in, out);
+}
+
+bool World::getConstant(const char *in, RayCastMode &out)
+{
+	return rayCastModes.find(in, out);
+}
+
+bool World::getConstant(RayCastMode in, const char *&out)
+{
+	return rayCastModes.find(in, out);
+}
+
+std::vector<std::string> World::getConstants(RayCastMode)
+{
+	return rayCastModes.getNames();
+}
+
+bool World::getConstant(const char *in, ProfileField &out)
+{
+	return profileFields.find(in, out);
+}
+
+bool World::getConstant(ProfileField in, const char *&out)
+{
+	return profileFields.find(in, out);
+}
+
+StringMap<World::ContactEventType, World::CONTACT_EVENT_MAX_ENUM>::Entry World::contactEventTypeEntries[] =
+{
+	{"begin", World::CONTACT_EVENT_BEGIN},
+	{"end", World::CONTACT_EVENT_END},
+	{"postsolve", World::CONTACT_EVENT_POSTSOLVE},
+};
+
+StringMap<World::ContactEventType, World::CONTACT_EVENT_MAX_ENUM> World::contactEventTypes(World::contactEventTypeEntries, sizeof(World::contactEventTypeEntries));
+
+StringMap<World::RayCastMode, World::RAYCAST_MAX_ENUM>::Entry World::rayCastModeEntries[] =
+{
+	{"closest", World::RAYCAST_CLOSEST},
+	{"all", World::RAYCAST_ALL},
+	{"any", World::RAYCAST_ANY},
+};
+
+StringMap<World::RayCastMode, World::RAYCAST_MAX_ENUM> World::rayCastModes(World::rayCastModeEntries, sizeof(World::rayCastModeEntries));
+
+StringMap<World::ProfileField, World::PROFILE_MAX_ENUM>::Entry World::profileFieldEntries[] =
+{
+	{"step", World::PROFILE_STEP},
+	{"collide", World::PROFILE_COLLIDE},
+	{"solve", World::PROFILE_SOLVE},
+	{"solveinit", World::PROFILE_SOLVE_INIT},
+	{"solvevelocity", World::PROFILE_SOLVE_VELOCITY},
+	{"solveposition", World::PROFILE_SOLVE_POSITION},
+	{"broadphase", World::PROFILE_BROADPHASE},
+	{"solvetoi", World::PROFILE_SOLVE_TOI},
+	{"contactscreated", World::PROFILE_CONTACTS_CREATED},
+	{"contactsdestroyed", World::PROFILE_CONTACTS_DESTROYED},
+	{"islands", World::PROFILE_ISLANDS},
+	{"toievents", World::PROFILE_TOI_EVENTS},
+	{"proxymoves", World::PROFILE_PROXY_MOVES},
+};
+
+StringMap<World::ProfileField, World::PROFILE_MAX_ENUM> World::profileFields(World::profileFieldEntries, sizeof(World::profileFieldEntries));
+
 } // box2d
 } // physics
 } // love
@@ -25,10 +25,13 @@
 #include "common/Object.h"
 #include "common/runtime.h"
 #include "common/Reference.h"
+#include "common/StringMap.h"
+#include "common/PointerMap.h"
 
 // STD
 #include <vector>
-#include <unordered_map>
+#include <deque>
+#include <string>
 
 // Box2D
 #include <Box2D/Box2D.h>
@@ -69,6 +72,105 @@ public:
 
 	static love::Type type;
 
+	/**
+	 * Number of floats per Body written by getBodyStates and read by
+	 * setBodyStates: x, y, angle, linear velocity x, linear velocity y, and
+	 * angular velocity.
+	 **/
+	static const int BODY_STATE_COMPONENTS = 6;
+
+	/**
+	 * A hit written by rayCastBatch. The ray index starts at 1, and the
+	 * fixture is a handle which stays the same for as long as the Fixture
+	 * exists (see getBatchFixtureHandles.)
+	 **/
+	struct RayCastHit
+	{
+		int32 ray;
+		int32 fixture;
+		float x, y;
+		float normalX, normalY;
+		float fraction;
+	};
+
+	/**
+	 * A hit written by queryBoundingBoxBatch: the index of the box (starting
+	 * at 1), the Fixture handle and the position of the Fixture's Body.
+	 **/
+	struct QueryHit
+	{
+		int32 box;
+		int32 fixture;
+		float x, y;
+	};
+
+	enum RayCastMode
+	{
+		RAYCAST_CLOSEST,
+		RAYCAST_ALL,
+		RAYCAST_ANY,
+		RAYCAST_MAX_ENUM
+	};
+
+	enum ContactEventType
+	{
+		CONTACT_EVENT_BEGIN,
+		CONTACT_EVENT_END,
+		CONTACT_EVENT_POSTSOLVE,
+		CONTACT_EVENT_MAX_ENUM
+	};
+
+	/**
+	 * Values measured during a time step. Times are in seconds.
+	 **/
+	enum ProfileField
+	{
+		PROFILE_STEP,
+		PROFILE_COLLIDE,
+		PROFILE_SOLVE,
+		PROFILE_SOLVE_INIT,
+		PROFILE_SOLVE_VELOCITY,
+		PROFILE_SOLVE_POSITION,
+		PROFILE_BROADPHASE,
+		PROFILE_SOLVE_TOI,
+		PROFILE_CONTACTS_CREATED,
+		PROFILE_CONTACTS_DESTROYED,
+		PROFILE_ISLANDS,
+		PROFILE_TOI_EVENTS,
+		PROFILE_PROXY_MOVES,
+		PROFILE_MAX_ENUM
+	};
+
+	struct Profile
+	{
+		double values[PROFILE_MAX_ENUM];
+	};
+
+	/**
+	 * A contact event recorded during update, when contact buffering is
+	 * enabled for its type. Holds a reference to both Fixtures.
+	 **/
+	// Buffered contact events beyond this are dropped, oldest first, so a
+	// World whose events are never retrieved doesn't grow without bound.
+	static const size_t MAX_BUFFERED_CONTACT_EVENTS = 1 << 16;
+
+	struct ContactEvent
+	{
+		ContactEventType type;
+		Fixture *fixtureA;
+		Fixture *fixtureB;
+
+		// World-space normal and first contact point. Zero if the contact
+		// has no manifold points (e.g. for sensors).
+		float normalX, normalY;
+		float x, y;
+
+		// Sums of the impulses at each contact point. Only set for
+		// postsolve events.
+		float normalImpulse;
+		float tangentImpulse;
+	};
+
 	class ContactCallback
 	{
 	public:
@@ -139,6 +241,38 @@ public:
 	void update(float dt);
 	void update(float dt, int velocityIterations, int positionIterations);
 
+	/**
+	 * Advances the World by a variable frame time using fixed time steps.
+	 * Time which doesn't add up to a whole step is carried over to the next
+	 * call, and the transform of every Body before the last step is kept so
+	 * it can be interpolated with getInterpolatedTransform.
+	 * @param frameDt The time passed since the last call.
+	 * @param fixedStep The duration of each time step.
+	 * @param maxSteps The maximum number of steps to take. Time which would
+	 * need more steps than this is dropped.
+	 * @return The number of steps taken.
+	 **/
+	int advance(float frameDt, float fixedStep, int maxSteps, int velocityIterations, int positionIterations);
+
+	/**
+	 * Gets how far the time carried over by advance is into the next step,
+	 * between 0 and 1. This is 1 after update is called directly.
+	 **/
+	float getInterpolationAlpha() const;
+
+	/**
+	 * Makes the previous transform of every Body equal to its current one, so
+	 * Bodies which were moved directly aren't interpolated from where they
+	 * were.
+	 **/
+	void resetInterpolation();
+
+	/**
+	 * Gets the position and angle of a Body between its transforms before and
+	 * after the last step taken by advance, using the interpolation alpha.
+	 **/
+	void getInterpolatedTransform(b2Body *body, b2Vec2 &position, float &angle) const;
+
 	// From b2ContactListener
 	void BeginContact(b2Contact *contact);
 	void EndContact(b2Contact *contact);
@@ -151,6 +285,7 @@ public:
 	// From b2DestructionListener
 	void SayGoodbye(b2Fixture *fixture);
 	void SayGoodbye(b2Joint *joint);
+	void SayGoodbye(b2Contact *contact);
 
 	/**
 	 * Returns true if the Box2D world is alive.
@@ -177,6 +312,28 @@ public:
 	 **/
 	void setCallbacksL(lua_State *L);
 
+	/**
+	 * Sets whether begin, end and postsolve contacts are recorded into a
+	 * buffer during update instead of being passed to the callbacks set with
+	 * setCallbacks. This avoids calling into Lua in the middle of the solver.
+	 * Events are kept until they are cleared with clearContactEvents, so end
+	 * events from Bodies or Fixtures destroyed between updates are not lost.
+	 * At most MAX_BUFFERED_CONTACT_EVENTS are kept; older events are dropped
+	 * first. Turning all buffering off clears the buffer.
+	 **/
+	void setContactBuffering(bool begin, bool end, bool postsolve);
+	void getContactBuffering(bool &begin, bool &end, bool &postsolve) const;
+
+	/**
+	 * Gets the contact events recorded since they were last cleared.
+	 **/
+	const std::deque<ContactEvent> &getContactEvents() const;
+
+	/**
+	 * Removes all recorded contact events.
+	 **/
+	void clearContactEvents();
+
 	/**
 	 * Sets the ContactFilter callback.
 	 **/
@@ -220,6 +377,49 @@ public:
 	 **/
 	bool isSleepingAllowed() const;
 
+	/**
+	 * Sets the number of threads used to update the World. With more than one
+	 * thread, contacts are updated and independent groups of touching or
+	 * jointed Bodies are solved in parallel. The results don't depend on the
+	 * thread count, and callbacks are still called from the updating thread.
+	 * @param count The number of threads, including the updating thread.
+	 **/
+	void setThreadCount(int count);
+
+	/**
+	 * Gets the number of threads used to update the World.
+	 **/
+	int getThreadCount() const;
+
+	/**
+	 * Gets the profile of the last time step.
+	 **/
+	const Profile &getProfile() const;
+
+	/**
+	 * Gets the sums of every profile value since the World was created or
+	 * resetProfile was called.
+	 * @param[out] steps The number of time steps which were summed.
+	 **/
+	const Profile &getProfileTotals(int &steps) const;
+
+	/**
+	 * Sets how many time steps are kept for getProfileHistory. 0 (the
+	 * default) disables the history.
+	 **/
+	void setProfileHistorySize(int size);
+	int getProfileHistorySize() const;
+
+	/**
+	 * Gets one value of the profiles kept in the history, oldest first.
+	 **/
+	void getProfileHistory(ProfileField field, std::vector<double> &values) const;
+
+	/**
+	 * Clears the profile totals and history.
+	 **/
+	void resetProfile();
+
 	/**
 	 * Returns whether this World is currently locked.
 	 * If it's locked, it's in the middle of a timestep.
@@ -263,6 +463,55 @@ public:
 	 **/
 	int getContacts(lua_State *L);
 
+	/**
+	 * Writes the state of Bodies into a float array, BODY_STATE_COMPONENTS
+	 * floats per Body.
+	 * @param bodies The Bodies to read, or null to read every Body in the
+	 * World (in the same order as getBodies).
+	 * @param dst The array to write to.
+	 * @param maxBodies The number of Bodies which fit in the array.
+	 * @param interpolated Whether to write the interpolated position and angle
+	 * (see getInterpolatedTransform) instead of the current ones.
+	 * @return The number of Bodies written.
+	 **/
+	int getBodyStates(const std::vector<Body *> *bodies, float *dst, int maxBodies, bool interpolated = false) const;
+
+	/**
+	 * Sets the position, angle and velocities of Bodies from a float array in
+	 * the format written by getBodyStates. Meant for moving many kinematic
+	 * Bodies at once.
+	 * @param bodies The Bodies to modify, or null for every Body in the World
+	 * (in the same order as getBodies).
+	 * @param src The array to read from.
+	 * @param maxBodies The number of Bodies which are in the array.
+	 * @return The number of Bodies modified.
+	 **/
+	int setBodyStates(const std::vector<Body *> *bodies, const float *src, int maxBodies);
+
+	/**
+	 * Gets the number of bytes written by serialize.
+	 **/
+	size_t getSerializedSize() const;
+
+	/**
+	 * Saves everything which changes while the World is updating: the motion,
+	 * mass and sleep state of Bodies, Joint impulses, Contacts and the state
+	 * used by advance. Deserializing it into this World later, or into a World
+	 * with the same Bodies, Fixtures and Joints created in the same order,
+	 * reproduces the following updates exactly.
+	 * @param dst Receives getSerializedSize() bytes.
+	 **/
+	void serialize(void *dst) const;
+
+	/**
+	 * Restores state saved by serialize. Bodies, Fixtures and Joints keep
+	 * their identity, but Contacts are replaced and existing Contact objects
+	 * become invalid. No contact callbacks are called.
+	 * @param src Data written by serialize, possibly followed by other bytes.
+	 * @param size The number of readable bytes at src.
+	 **/
+	void deserialize(const void *src, size_t size);
+
 	/**
 	 * Gets the ground body.
 	 * @return The ground body.
@@ -279,20 +528,84 @@ public:
 	 **/
 	int rayCast(lua_State *L);
 
+	/**
+	 * Casts many rays without calling back into Lua.
+	 * @param rays x1, y1, x2, y2 for each ray.
+	 * @param rayCount The number of rays.
+	 * @param mode Whether to report the closest hit, every hit (sorted by
+	 * fraction) or any single hit of each ray.
+	 * @param hits Receives the hits.
+	 * @param maxHits The number of hits which fit in the hits array.
+	 * @param[out] complete False if some hits did not fit.
+	 * @return The number of hits written.
+	 **/
+	int rayCastBatch(const float *rays, int rayCount, RayCastMode mode, RayCastHit *hits, int maxHits, bool &complete);
+
+	/**
+	 * Finds the Fixtures which potentially overlap many bounding boxes,
+	 * without calling back into Lua.
+	 * @param boxes topLeftX, topLeftY, bottomRightX, bottomRightY for each box.
+	 * @param boxCount The number of boxes.
+	 * @param hits Receives one hit per Fixture found.
+	 * @param maxHits The number of hits which fit in the hits array.
+	 * @param[out] complete False if some hits did not fit.
+	 * @return The number of hits written.
+	 **/
+	int queryBoundingBoxBatch(const float *boxes, int boxCount, QueryHit *hits, int maxHits, bool &complete);
+
+	/**
+	 * Gets the distinct Fixture handles written by the last rayCastBatch or
+	 * queryBoundingBoxBatch call. Valid until the next call.
+	 **/
+	const std::vector<int32> &getBatchFixtureHandles() const;
+
+	/**
+	 * Gets the Fixture a handle refers to, or null if the handle is unused.
+	 **/
+	Fixture *getFixtureFromHandle(int32 handle) const;
+
+	/**
+	 * Frees a Fixture's handle so it can be reused. Called when the Fixture
+	 * is destroyed.
+	 **/
+	void releaseFixtureHandle(int32 handle);
+
 	/**
 	 * Destroy this world.
 	 **/
 	void destroy();
 
+	static bool getConstant(const char *in, ContactEventType &out);
+	static bool getConstant(ContactEventType in, const char *&out);
+
+	static bool getConstant(const char *in, ProfileField &out);
+	static bool getConstant(ProfileField in, const char *&out);
+
+	static bool getConstant(const char *in, RayCastMode &out);
+	static bool getConstant(RayCastMode in, const char *&out);
+	static std::vector<std::string> getConstants(RayCastMode);
+
+	/**
+	 * Gets the Contact object for a b2Contact, creating it (or reusing an
+	 * unreferenced one) if needed. The World keeps a reference to it until
+	 * the b2Contact stops touching or is destroyed.
+	 **/
+	Contact *getContact(b2Contact *contact);
+
 	void registerObject(void *b2object, love::Object *object);
 	void unregisterObject(void *b2object);
 	love::Object *findObject(void *b2object) const;
 
 private:
 
+	class TaskExecutor;
+
 	// Pointer to the Box2D world.
 	b2World *world;
 
+	// Runs parts of each time step in parallel, or null when single-threaded.
+	TaskExecutor *taskExecutor;
+
 	// Ground body
 	b2Body *groundBody;
 
@@ -306,7 +619,70 @@ private:
 	ContactCallback begin, end, presolve, postsolve;
 	ContactFilter filter;
 
-	std::unordered_map<void *, love::Object *> box2dObjectMap;
+	// Buffered contacts.
+	bool bufferContactEvents[CONTACT_EVENT_MAX_ENUM];
+	std::deque<ContactEvent> contactEvents;
+
+	void bufferContactEvent(ContactEventType type, b2Contact *contact, const b2ContactImpulse *impulse = nullptr);
+
+	// Profiling.
+	Profile lastProfile;
+	Profile profileTotals;
+	int profileSteps;
+	std::vector<Profile> profileHistory;
+	int profileHistorySize;
+	size_t profileHistoryNext;
+
+	void recordProfile();
+
+	// Fixed time steps.
+	float stepAccumulator;
+	float interpolationAlpha;
+
+	void savePreviousTransforms();
+
+	// Batched queries. Their buffers are kept between calls to avoid
+	// allocating on every call.
+	class BatchRayCastCallback;
+	class BatchQueryCallback;
+
+	struct BatchRayHit
+	{
+		b2Fixture *fixture;
+		b2Vec2 point;
+		b2Vec2 normal;
+		float32 fraction;
+		int order;
+	};
+
+	int32 getFixtureHandle(b2Fixture *fixture);
+
+	std::vector<BatchRayHit> batchRayHits;
+	std::vector<b2Fixture *> batchQueryFixtures;
+	std::vector<int32> batchFixtureHandles;
+	uint32 batchStamp;
+
+	// Fixture handles used by the batched queries. Index 0 is never used.
+	std::vector<Fixture *> fixtureHandles;
+	std::vector<int32> freeFixtureHandles;
+
+	static StringMap<ContactEventType, CONTACT_EVENT_MAX_ENUM>::Entry contactEventTypeEntries[];
+	static StringMap<ContactEventType, CONTACT_EVENT_MAX_ENUM> contactEventTypes;
+
+	static StringMap<ProfileField, PROFILE_MAX_ENUM>::Entry profileFieldEntries[];
+	static StringMap<ProfileField, PROFILE_MAX_ENUM> profileFields;
+
+	static StringMap<RayCastMode, RAYCAST_MAX_ENUM>::Entry rayCastModeEntries[];
+	static StringMap<RayCastMode, RAYCAST_MAX_ENUM> rayCastModes;
+
+	// Invalid Contact objects which nothing but the World references, ready
+	// to be reused by getContact.
+	static const size_t MAX_POOLED_CONTACTS = 256;
+	std::vector<Contact *> contactPool;
+
+	void releaseContact(b2Contact *contact);
+
+	PointerMap<love::Object *> box2dObjectMap;
 
 }; // World
 
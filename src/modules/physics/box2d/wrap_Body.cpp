@@ -82,6 +82,19 @@ int w_Body_getTransform(lua_State *L)
 	return 3;
 }
 
+int w_Body_getInterpolatedTransform(lua_State *L)
+{
+	Body *t = luax_checkbody(L, 1);
+
+	float x_o, y_o, angle_o;
+	t->getInterpolatedTransform(x_o, y_o, angle_o);
+	lua_pushnumber(L, x_o);
+	lua_pushnumber(L, y_o);
+	lua_pushnumber(L, angle_o);
+
+	return 3;
+}
+
 int w_Body_getLinearVelocity(lua_State *L)
 {
 	Body *t = luax_checkbody(L, 1);
@@ -652,6 +665,7 @@ static const luaL_Reg w_Body_functions[] =
 	{ "getPosition", w_Body_getPosition },
 	{ "getTransform", w_Body_getTransform },
 	{ "setTransform", w_Body_setTransform },
+	{ "getInterpolatedTransform", w_Body_getInterpolatedTransform },
 	{ "getLinearVelocity", w_Body_getLinearVelocity },
 	{ "getWorldCenter", w_Body_getWorldCenter },
 	{ "getLocalCenter", w_Body_getLocalCenter },
@@ -19,6 +19,9 @@
  **/
 
 #include "wrap_World.h"
+#include "wrap_Body.h"
+#include "common/Data.h"
+#include "data/ByteData.h"
 
 namespace love
 {
@@ -55,6 +58,40 @@ int w_World_update(lua_State *L)
 	return 0;
 }
 
+int w_World_advance(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	float framedt = (float) luaL_checknumber(L, 2);
+	float fixedstep = (float) luaL_checknumber(L, 3);
+	int maxsteps = (int) luaL_optinteger(L, 4, 5);
+	int velocityiterations = (int) luaL_optinteger(L, 5, 8);
+	int positioniterations = (int) luaL_optinteger(L, 6, 3);
+
+	// Make sure the world callbacks are using the calling Lua thread.
+	t->setCallbacksL(L);
+
+	int steps = 0;
+	luax_catchexcept(L, [&](){ steps = t->advance(framedt, fixedstep, maxsteps, velocityiterations, positioniterations); });
+
+	lua_pushinteger(L, steps);
+	lua_pushnumber(L, t->getInterpolationAlpha());
+	return 2;
+}
+
+int w_World_getInterpolationAlpha(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushnumber(L, t->getInterpolationAlpha());
+	return 1;
+}
+
+int w_World_resetInterpolation(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	luax_catchexcept(L, [&](){ t->resetInterpolation(); });
+	return 0;
+}
+
 int w_World_setCallbacks(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -83,6 +120,284 @@ int w_World_getContactFilter(lua_State *L)
 	return t->getContactFilter(L);
 }
 
+int w_World_setContactBuffering(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	bool begin = luax_toboolean(L, 2);
+	bool end = luax_toboolean(L, 3);
+	bool postsolve = luax_toboolean(L, 4);
+	t->setContactBuffering(begin, end, postsolve);
+	return 0;
+}
+
+int w_World_getContactBuffering(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	bool begin = false, end = false, postsolve = false;
+	t->getContactBuffering(begin, end, postsolve);
+	luax_pushboolean(L, begin);
+	luax_pushboolean(L, end);
+	luax_pushboolean(L, postsolve);
+	return 3;
+}
+
+int w_World_getContactEvents(lua_State *L)
+{
+	// Each event is stored as consecutive values in a flat array (which can
+	// be reused between calls), to avoid creating a table per event.
+	static const int STRIDE = 9;
+
+	World *t = luax_checkworld(L, 1);
+	const std::deque<World::ContactEvent> &events = t->getContactEvents();
+
+	int count = (int) events.size();
+
+	if (lua_istable(L, 2))
+		lua_pushvalue(L, 2);
+	else
+		lua_createtable(L, count * STRIDE, 0);
+
+	for (int i = 0; i < count; i++)
+	{
+		const World::ContactEvent &e = events[i];
+		int idx = i * STRIDE;
+
+		const char *type = nullptr;
+		World::getConstant(e.type, type);
+
+		lua_pushstring(L, type);
+		lua_rawseti(L, -2, idx + 1);
+		luax_pushtype(L, e.fixtureA);
+		lua_rawseti(L, -2, idx + 2);
+		luax_pushtype(L, e.fixtureB);
+		lua_rawseti(L, -2, idx + 3);
+		lua_pushnumber(L, e.normalX);
+		lua_rawseti(L, -2, idx + 4);
+		lua_pushnumber(L, e.normalY);
+		lua_rawseti(L, -2, idx + 5);
+		lua_pushnumber(L, e.x);
+		lua_rawseti(L, -2, idx + 6);
+		lua_pushnumber(L, e.y);
+		lua_rawseti(L, -2, idx + 7);
+		lua_pushnumber(L, e.normalImpulse);
+		lua_rawseti(L, -2, idx + 8);
+		lua_pushnumber(L, e.tangentImpulse);
+		lua_rawseti(L, -2, idx + 9);
+	}
+
+	// Clear leftovers from a previous, larger set of events.
+	int oldlength = (int) luax_objlen(L, -1);
+	for (int i = count * STRIDE + 1; i <= oldlength; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, -2, i);
+	}
+
+	// Events are returned once. The Lua table now references the Fixtures.
+	t->clearContactEvents();
+
+	lua_pushinteger(L, count);
+	return 2;
+}
+
+static void luax_setprofilefields(lua_State *L, const World::Profile &profile)
+{
+	for (int i = 0; i < World::PROFILE_MAX_ENUM; i++)
+	{
+		const char *name = nullptr;
+		if (!World::getConstant((World::ProfileField) i, name))
+			continue;
+
+		lua_pushnumber(L, profile.values[i]);
+		lua_setfield(L, -2, name);
+	}
+}
+
+// Fills the handle -> Fixture table for the handles in the last batch. Entries
+// which already hold the right Fixture are left alone, so repeated calls don't
+// push anything for Fixtures which were seen before.
+static void luax_setfixturehandles(lua_State *L, int idx, World *world)
+{
+	for (int32 handle : world->getBatchFixtureHandles())
+	{
+		Fixture *fixture = world->getFixtureFromHandle(handle);
+
+		lua_rawgeti(L, idx, handle);
+		bool current = luax_istype(L, -1, Fixture::type) && ((Proxy *) lua_touserdata(L, -1))->object == fixture;
+		lua_pop(L, 1);
+
+		if (!current)
+		{
+			luax_pushtype(L, fixture);
+			lua_rawseti(L, idx, handle);
+		}
+	}
+}
+
+int w_World_rayCastBatch(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	love::Data *raydata = luax_checktype<love::Data>(L, 2);
+	love::Data *hitdata = luax_checktype<love::Data>(L, 3);
+
+	World::RayCastMode mode = World::RAYCAST_CLOSEST;
+	if (!lua_isnoneornil(L, 4))
+	{
+		const char *str = luaL_checkstring(L, 4);
+		if (!World::getConstant(str, mode))
+			return luax_enumerror(L, "ray cast mode", World::getConstants(mode), str);
+	}
+
+	bool wantfixtures = !lua_isnoneornil(L, 5);
+	if (wantfixtures)
+		luaL_checktype(L, 5, LUA_TTABLE);
+
+	if (raydata == hitdata)
+		return luaL_error(L, "The ray and hit Data must be different objects.");
+
+	int raycount = (int) (raydata->getSize() / (sizeof(float) * 4));
+	int maxhits = (int) (hitdata->getSize() / sizeof(World::RayCastHit));
+
+	bool complete = true;
+	int count = 0;
+
+	luax_catchexcept(L, [&]() {
+		const float *rays = (const float *) raydata->getData();
+		World::RayCastHit *hits = (World::RayCastHit *) hitdata->getData();
+		count = t->rayCastBatch(rays, raycount, mode, hits, maxhits, complete);
+	});
+
+	if (wantfixtures)
+		luax_setfixturehandles(L, 5, t);
+
+	lua_pushinteger(L, count);
+	luax_pushboolean(L, complete);
+	return 2;
+}
+
+int w_World_queryBoundingBoxBatch(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	love::Data *boxdata = luax_checktype<love::Data>(L, 2);
+	love::Data *hitdata = luax_checktype<love::Data>(L, 3);
+
+	bool wantfixtures = !lua_isnoneornil(L, 4);
+	if (wantfixtures)
+		luaL_checktype(L, 4, LUA_TTABLE);
+
+	if (boxdata == hitdata)
+		return luaL_error(L, "The box and hit Data must be different objects.");
+
+	int boxcount = (int) (boxdata->getSize() / (sizeof(float) * 4));
+	int maxhits = (int) (hitdata->getSize() / sizeof(World::QueryHit));
+
+	bool complete = true;
+	int count = 0;
+
+	luax_catchexcept(L, [&]() {
+		const float *boxes = (const float *) boxdata->getData();
+		World::QueryHit *hits = (World::QueryHit *) hitdata->getData();
+		count = t->queryBoundingBoxBatch(boxes, boxcount, hits, maxhits, complete);
+	});
+
+	if (wantfixtures)
+		luax_setfixturehandles(L, 4, t);
+
+	lua_pushinteger(L, count);
+	luax_pushboolean(L, complete);
+	return 2;
+}
+
+int w_World_getProfile(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+
+	if (lua_istable(L, 2))
+		lua_pushvalue(L, 2);
+	else
+		lua_createtable(L, 0, World::PROFILE_MAX_ENUM);
+
+	luax_setprofilefields(L, t->getProfile());
+	return 1;
+}
+
+int w_World_getProfileTotals(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+
+	if (lua_istable(L, 2))
+		lua_pushvalue(L, 2);
+	else
+		lua_createtable(L, 0, World::PROFILE_MAX_ENUM + 1);
+
+	int steps = 0;
+	luax_setprofilefields(L, t->getProfileTotals(steps));
+
+	lua_pushinteger(L, steps);
+	lua_setfield(L, -2, "steps");
+	return 1;
+}
+
+int w_World_setProfileHistorySize(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int size = (int) luaL_checkinteger(L, 2);
+	if (size < 0)
+		return luaL_error(L, "Invalid profile history size: %d", size);
+	t->setProfileHistorySize(size);
+	return 0;
+}
+
+int w_World_getProfileHistorySize(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushinteger(L, t->getProfileHistorySize());
+	return 1;
+}
+
+int w_World_getProfileHistory(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	const char *str = luaL_checkstring(L, 2);
+
+	World::ProfileField field;
+	if (!World::getConstant(str, field))
+		return luax_enumerror(L, "profile field", str);
+
+	std::vector<double> values;
+	t->getProfileHistory(field, values);
+
+	int count = (int) values.size();
+
+	if (lua_istable(L, 3))
+		lua_pushvalue(L, 3);
+	else
+		lua_createtable(L, count, 0);
+
+	for (int i = 0; i < count; i++)
+	{
+		lua_pushnumber(L, values[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	// Clear leftovers from a previous, longer history.
+	int oldlength = (int) luax_objlen(L, -1);
+	for (int i = count + 1; i <= oldlength; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, -2, i);
+	}
+
+	return 1;
+}
+
+int w_World_resetProfile(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	t->resetProfile();
+	return 0;
+}
+
 int w_World_setGravity(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -123,6 +438,23 @@ int w_World_isSleepingAllowed(lua_State *L)
 	return 1;
 }
 
+int w_World_setThreadCount(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int count = (int) luaL_checkinteger(L, 2);
+	if (count < 1)
+		return luaL_error(L, "Invalid thread count: %d (must be at least 1)", count);
+	luax_catchexcept(L, [&](){ t->setThreadCount(count); });
+	return 0;
+}
+
+int w_World_getThreadCount(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushinteger(L, t->getThreadCount());
+	return 1;
+}
+
 int w_World_isLocked(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -194,6 +526,143 @@ int w_World_rayCast(lua_State *L)
 	return ret;
 }
 
+// Returns false if no list is given, which means every Body in the World.
+static bool luax_checkbodylist(lua_State *L, int idx, World *world, std::vector<Body *> &bodies)
+{
+	if (lua_isnoneornil(L, idx))
+		return false;
+
+	luaL_checktype(L, idx, LUA_TTABLE);
+	int count = (int) luax_objlen(L, idx);
+	bodies.reserve(count);
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, idx, i);
+		Body *body = luax_checkbody(L, -1);
+		if (body->getWorld() != world)
+			luaL_error(L, "Body at index %d belongs to a different World.", i);
+		bodies.push_back(body);
+		lua_pop(L, 1);
+	}
+
+	return true;
+}
+
+static float *luax_checkbodystatedata(lua_State *L, int dataidx, int offsetidx, int &maxbodies)
+{
+	love::Data *data = luax_checktype<love::Data>(L, dataidx);
+	lua_Integer offset = luaL_optinteger(L, offsetidx, 0);
+
+	if (offset < 0 || (size_t) offset > data->getSize() || offset % sizeof(float) != 0)
+		luaL_error(L, "Invalid byte offset: %d", (int) offset);
+
+	size_t statesize = sizeof(float) * World::BODY_STATE_COMPONENTS;
+	maxbodies = (int) ((data->getSize() - (size_t) offset) / statesize);
+
+	return (float *) ((char *) data->getData() + offset);
+}
+
+int w_World_getBodyStates(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int maxbodies = 0;
+	float *dst = luax_checkbodystatedata(L, 2, 4, maxbodies);
+
+	std::vector<Body *> bodies;
+	bool haslist = luax_checkbodylist(L, 3, t, bodies);
+
+	int count = 0;
+	luax_catchexcept(L, [&](){ count = t->getBodyStates(haslist ? &bodies : nullptr, dst, maxbodies); });
+
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+int w_World_getInterpolatedBodyStates(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int maxbodies = 0;
+	float *dst = luax_checkbodystatedata(L, 2, 4, maxbodies);
+
+	std::vector<Body *> bodies;
+	bool haslist = luax_checkbodylist(L, 3, t, bodies);
+
+	int count = 0;
+	luax_catchexcept(L, [&](){ count = t->getBodyStates(haslist ? &bodies : nullptr, dst, maxbodies, true); });
+
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+int w_World_setBodyStates(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int maxbodies = 0;
+	const float *src = luax_checkbodystatedata(L, 2, 4, maxbodies);
+
+	std::vector<Body *> bodies;
+	bool haslist = luax_checkbodylist(L, 3, t, bodies);
+
+	int count = 0;
+	luax_catchexcept(L, [&](){ count = t->setBodyStates(haslist ? &bodies : nullptr, src, maxbodies); });
+
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+int w_World_serialize(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	size_t size = t->getSerializedSize();
+
+	if (lua_isnoneornil(L, 2))
+	{
+		love::data::ByteData *d = nullptr;
+		luax_catchexcept(L, [&](){ d = new love::data::ByteData(size); });
+
+		luax_catchexcept(L,
+			[&](){ t->serialize(d->getData()); },
+			[&](bool failed){ if (failed) d->release(); }
+		);
+
+		luax_pushtype(L, d);
+		d->release();
+	}
+	else
+	{
+		love::Data *d = luax_checktype<love::Data>(L, 2);
+		if (d->getSize() < size)
+			return luaL_error(L, "Data is too small to hold the World (%d bytes needed, %d available).", (int) size, (int) d->getSize());
+
+		luax_catchexcept(L, [&](){ t->serialize(d->getData()); });
+		lua_pushvalue(L, 2);
+	}
+
+	lua_pushinteger(L, (lua_Integer) size);
+	return 2;
+}
+
+int w_World_deserialize(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	love::Data *d = luax_checktype<love::Data>(L, 2);
+	lua_Integer size = luaL_optinteger(L, 3, (lua_Integer) d->getSize());
+
+	if (size < 0 || (size_t) size > d->getSize())
+		return luaL_error(L, "Invalid size: %d", (int) size);
+
+	luax_catchexcept(L, [&](){ t->deserialize(d->getData(), (size_t) size); });
+	return 0;
+}
+
+int w_World_getSerializedSize(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushinteger(L, (lua_Integer) t->getSerializedSize());
+	return 1;
+}
+
 int w_World_destroy(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -229,15 +698,29 @@ int w_World_getContactList(lua_State *L)
 static const luaL_Reg w_World_functions[] =
 {
 	{ "update", w_World_update },
+	{ "advance", w_World_advance },
+	{ "getInterpolationAlpha", w_World_getInterpolationAlpha },
+	{ "resetInterpolation", w_World_resetInterpolation },
 	{ "setCallbacks", w_World_setCallbacks },
 	{ "getCallbacks", w_World_getCallbacks },
 	{ "setContactFilter", w_World_setContactFilter },
 	{ "getContactFilter", w_World_getContactFilter },
+	{ "setContactBuffering", w_World_setContactBuffering },
+	{ "getContactBuffering", w_World_getContactBuffering },
+	{ "getContactEvents", w_World_getContactEvents },
 	{ "setGravity", w_World_setGravity },
 	{ "getGravity", w_World_getGravity },
 	{ "translateOrigin", w_World_translateOrigin },
 	{ "setSleepingAllowed", w_World_setSleepingAllowed },
 	{ "isSleepingAllowed", w_World_isSleepingAllowed },
+	{ "getProfile", w_World_getProfile },
+	{ "getProfileTotals", w_World_getProfileTotals },
+	{ "setProfileHistorySize", w_World_setProfileHistorySize },
+	{ "getProfileHistorySize", w_World_getProfileHistorySize },
+	{ "getProfileHistory", w_World_getProfileHistory },
+	{ "resetProfile", w_World_resetProfile },
+	{ "setThreadCount", w_World_setThreadCount },
+	{ "getThreadCount", w_World_getThreadCount },
 	{ "isLocked", w_World_isLocked },
 	{ "getBodyCount", w_World_getBodyCount },
 	{ "getJointCount", w_World_getJointCount },
@@ -247,6 +730,14 @@ static const luaL_Reg w_World_functions[] =
 	{ "getContacts", w_World_getContacts },
 	{ "queryBoundingBox", w_World_queryBoundingBox },
 	{ "rayCast", w_World_rayCast },
+	{ "rayCastBatch", w_World_rayCastBatch },
+	{ "queryBoundingBoxBatch", w_World_queryBoundingBoxBatch },
+	{ "getBodyStates", w_World_getBodyStates },
+	{ "getInterpolatedBodyStates", w_World_getInterpolatedBodyStates },
+	{ "setBodyStates", w_World_setBodyStates },
+	{ "serialize", w_World_serialize },
+	{ "deserialize", w_World_deserialize },
+	{ "getSerializedSize", w_World_getSerializedSize },
 	{ "destroy", w_World_destroy },
 	{ "isDestroyed", w_World_isDestroyed },
 
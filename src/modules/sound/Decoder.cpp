@@ -65,5 +65,20 @@ bool Decoder::isFinished()
 	return eof;
 }
 
+bool Decoder::setBitDepth(int bitDepth)
+{
+	return bitDepth == getBitDepth();
+}
+
+int64 Decoder::getSampleCount()
+{
+	return -1;
+}
+
+bool Decoder::seekSample(int64 /*sample*/)
+{
+	return false;
+}
+
 } // sound
 } // love
@@ -23,6 +23,7 @@
 
 // LOVE
 #include "common/Object.h"
+#include "common/int.h"
 #include "filesystem/File.h"
 
 #include <string>
@@ -126,11 +127,22 @@ public:
 	virtual int getChannelCount() const = 0;
 
 	/**
-	 * Gets the number of bits per sample. Supported values are 8 or 16.
-	 * @return Either 8, 16, or 0 if unsupported.
+	 * Gets the number of bits per sample. Supported values are 8, 16, or 32
+	 * for floating point samples.
+	 * @return Either 8, 16, 32, or 0 if unsupported.
 	 **/
 	virtual int getBitDepth() const = 0;
 
+	/**
+	 * Sets the number of bits per sample of decoded data. A bit depth of 32
+	 * means floating point samples, which avoids quantizing the decoded
+	 * audio.
+	 * @param bitDepth The bit depth to decode to (8, 16 or 32).
+	 * @return True if success, false if the decoder can't output samples
+	 *         with that bit depth.
+	 **/
+	virtual bool setBitDepth(int bitDepth);
+
 	/**
 	 * Gets the sample rate for the Decoder, that is, samples per second.
 	 * @return The sample rate, eg. 44100.
@@ -143,6 +155,21 @@ public:
 	 **/
 	virtual double getDuration() = 0;
 
+	/**
+	 * Gets the exact number of samples (per channel) in the stream. Decoders
+	 * which can't determine it without decoding the whole stream return -1.
+	 **/
+	virtual int64 getSampleCount();
+
+	/**
+	 * Seeks to the exact sample (per channel) offset in the stream. Unlike
+	 * seek, this is only implemented by decoders that support sample-accurate
+	 * seeking.
+	 * @param sample The sample offset from the start of the stream.
+	 * @return True if success, false on fail/unsupported.
+	 **/
+	virtual bool seekSample(int64 sample);
+
 protected:
 
 	// The encoded data. This should be replaced with buffered file
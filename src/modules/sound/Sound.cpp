@@ -31,9 +31,9 @@ Sound::~Sound()
 {
 }
 
-SoundData *Sound::newSoundData(Decoder *decoder)
+SoundData *Sound::newSoundData(Decoder *decoder, int threadCount)
 {
-	return new SoundData(decoder);
+	return new SoundData(decoder, threadCount);
 }
 
 SoundData *Sound::newSoundData(int samples, int sampleRate, int bitDepth, int channels)
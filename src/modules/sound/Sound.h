@@ -54,15 +54,18 @@ public:
 	 * encoded sound data into raw sound data. Not recommended
 	 * on large (long-duration) files.
 	 * @param decoder The file to decode the data from.
+	 * @param threadCount The maximum number of threads to decode with. Values
+	 *        above 1 decode the whole stream from the start, in independent
+	 *        segments, if the decoder supports sample-accurate seeking.
 	 * @return A SoundData object, or zero if the file type couldn't be handled.
 	 **/
-	SoundData *newSoundData(Decoder *decoder);
+	SoundData *newSoundData(Decoder *decoder, int threadCount = 1);
 
 	/**
 	 * Creates a new SoundData with the specified number of samples and format.
 	 * @param samples The number of samples.
 	 * @param sampleRate Number of samples per second.
-	 * @param bitDepth Bits per sample (8 or 16).
+	 * @param bitDepth Bits per sample (8, 16, or 32 for floating point samples).
 	 * @param channels Either 1 for mono, or 2 for stereo.
 	 * @return A new SoundData object, or zero in case of errors.
 	 **/
@@ -74,7 +77,7 @@ public:
 	 * @param data Buffer to load data from.
 	 * @param samples The number of samples.
 	 * @param sampleRate Number of samples per second.
-	 * @param bitDepth Bits per sample (8 or 16).
+	 * @param bitDepth Bits per sample (8, 16, or 32 for floating point samples).
 	 * @param channels Either 1 for mono, or 2 for stereo.
 	 * @return A new SoundData object, or zero in case of errors.
 	 **/
@@ -28,6 +28,26 @@
 #include <limits>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+
+// LOVE
+#include "common/config.h"
+#include "thread/threads.h"
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#define _USE_MATH_DEFINES // for M_PI
+#include <cmath>
 
 namespace love
 {
@@ -36,56 +56,377 @@ namespace sound
 
 love::Type SoundData::type("SoundData", &Data::type);
 
-SoundData::SoundData(Decoder *decoder)
-	: data(0)
-	, size(0)
-	, sampleRate(Decoder::DEFAULT_SAMPLE_RATE)
-	, bitDepth(0)
-	, channels(0)
+// Minimum number of samples per segment when decoding on multiple threads.
+static const int64 MIN_PARALLEL_SEGMENT_SAMPLES = 1 << 18;
+
+namespace
 {
-	if (decoder->getBitDepth() != 8 && decoder->getBitDepth() != 16)
-		throw love::Exception("Invalid bit depth: %d", decoder->getBitDepth());
 
-	size_t bufferSize = 524288; // 0x80000
-	int decoded = decoder->decode();
+// Number of samples processed at a time by the bulk operations, so their
+// temporary buffers can live on the stack.
+const size_t CHUNK_SAMPLES = 1024;
 
-	while (decoded > 0)
+bool isValidBitDepth(int bitDepth)
+{
+	return bitDepth == 8 || bitDepth == 16 || bitDepth == 32;
+}
+
+inline float clampSample(float x)
+{
+	return std::min(std::max(x, -1.0f), 1.0f);
+}
+
+// Converts samples to floats in [-1, 1], using the same mapping as getSample.
+void samplesToFloat(const void *src, int bitDepth, float *dst, size_t count)
+{
+	size_t i = 0;
+
+	if (bitDepth == 32)
 	{
-		// Expand or allocate buffer. Note that realloc may move
-		// memory to other locations.
-		if (!data || bufferSize < size + decoded)
+		memcpy(dst, src, count * sizeof(float));
+	}
+	else if (bitDepth == 16)
+	{
+		const int16 *s = (const int16 *) src;
+		const float scale = 1.0f / (float) LOVE_INT16_MAX;
+
+#if defined(LOVE_SIMD_SSE2)
+		__m128 vscale = _mm_set1_ps(scale);
+		for (; i + 8 <= count; i += 8)
 		{
-			while (bufferSize < size + decoded)
-				bufferSize <<= 1;
-			data = (uint8 *) realloc(data, bufferSize);
+			__m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+
+			// Sign-extend to 32 bits by moving each value into the high half.
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+			_mm_storeu_ps(dst + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(lo), vscale));
+			_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), vscale));
 		}
+#elif defined(LOVE_SIMD_NEON)
+		float32x4_t vscale = vdupq_n_f32(scale);
+		for (; i + 8 <= count; i += 8)
+		{
+			int16x8_t v = vld1q_s16(s + i);
 
-		if (!data)
-			throw love::Exception("Not enough memory.");
+			int32x4_t lo = vmovl_s16(vget_low_s16(v));
+			int32x4_t hi = vmovl_s16(vget_high_s16(v));
 
-		// Copy memory into new part of memory.
-		memcpy(data + size, decoder->getBuffer(), decoded);
+			vst1q_f32(dst + i + 0, vmulq_f32(vcvtq_f32_s32(lo), vscale));
+			vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(hi), vscale));
+		}
+#endif
 
-		// Overflow check.
-		if (size > std::numeric_limits<size_t>::max() - decoded)
+		for (; i < count; i++)
+			dst[i] = (float) s[i] * scale;
+	}
+	else
+	{
+		// 8-bit sample values are unsigned.
+		const uint8 *s = (const uint8 *) src;
+		for (; i < count; i++)
+			dst[i] = ((float) s[i] - 128.0f) / 127.0f;
+	}
+}
+
+// Converts floats to samples. 32-bit floats are copied as-is. Otherwise values
+// are clamped to [-1, 1] first (unlike setSample, which doesn't clamp), then
+// scaled by 32767 for 16-bit samples, or by 127 and offset by 128 for 8-bit
+// samples. The result is truncated rather than rounded, so 16-bit samples round
+// towards zero and 8-bit samples round down.
+void floatToSamples(const float *src, void *dst, int bitDepth, size_t count)
+{
+	size_t i = 0;
+
+	if (bitDepth == 32)
+	{
+		memcpy(dst, src, count * sizeof(float));
+	}
+	else if (bitDepth == 16)
+	{
+		int16 *d = (int16 *) dst;
+		const float scale = (float) LOVE_INT16_MAX;
+
+#if defined(LOVE_SIMD_SSE2)
+		__m128 vscale = _mm_set1_ps(scale);
+		__m128 vmin = _mm_set1_ps(-1.0f);
+		__m128 vmax = _mm_set1_ps(1.0f);
+		for (; i + 8 <= count; i += 8)
 		{
-			free(data);
-			throw love::Exception("Not enough memory.");
+			__m128 a = _mm_loadu_ps(src + i + 0);
+			__m128 b = _mm_loadu_ps(src + i + 4);
+
+			a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, vmin), vmax), vscale);
+			b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, vmin), vmax), vscale);
+
+			__m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+			_mm_storeu_si128((__m128i *) (d + i), packed);
 		}
+#elif defined(LOVE_SIMD_NEON)
+		float32x4_t vscale = vdupq_n_f32(scale);
+		float32x4_t vmin = vdupq_n_f32(-1.0f);
+		float32x4_t vmax = vdupq_n_f32(1.0f);
+		for (; i + 8 <= count; i += 8)
+		{
+			float32x4_t a = vld1q_f32(src + i + 0);
+			float32x4_t b = vld1q_f32(src + i + 4);
 
-		// Keep this up to date.
-		size += decoded;
+			a = vmulq_f32(vminq_f32(vmaxq_f32(a, vmin), vmax), vscale);
+			b = vmulq_f32(vminq_f32(vmaxq_f32(b, vmin), vmax), vscale);
 
-		decoded = decoder->decode();
+			int16x4_t lo = vqmovn_s32(vcvtq_s32_f32(a));
+			int16x4_t hi = vqmovn_s32(vcvtq_s32_f32(b));
+			vst1q_s16(d + i, vcombine_s16(lo, hi));
+		}
+#endif
+
+		for (; i < count; i++)
+			d[i] = (int16) (clampSample(src[i]) * scale);
 	}
+	else
+	{
+		uint8 *d = (uint8 *) dst;
+		for (; i < count; i++)
+			d[i] = (uint8) ((clampSample(src[i]) * 127.0f) + 128.0f);
+	}
+}
 
-	// Shrink buffer if necessary.
-	if (data && bufferSize > size)
-		data = (uint8 *) realloc(data, size);
+// dst[i] += src[i] * gain
+void mixFloat(float *dst, const float *src, float gain, size_t count)
+{
+	size_t i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+	__m128 vgain = _mm_set1_ps(gain);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 v = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), vgain));
+		_mm_storeu_ps(dst + i, v);
+	}
+#elif defined(LOVE_SIMD_NEON)
+	float32x4_t vgain = vdupq_n_f32(gain);
+	for (; i + 4 <= count; i += 4)
+		vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), vgain));
+#endif
+
+	for (; i < count; i++)
+		dst[i] += src[i] * gain;
+}
+
+// dst[i] *= gain
+void scaleFloat(float *dst, float gain, size_t count)
+{
+	size_t i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+	__m128 vgain = _mm_set1_ps(gain);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), vgain));
+#elif defined(LOVE_SIMD_NEON)
+	float32x4_t vgain = vdupq_n_f32(gain);
+	for (; i + 4 <= count; i += 4)
+		vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), vgain));
+#endif
+
+	for (; i < count; i++)
+		dst[i] *= gain;
+}
+
+float dotFloat(const float *a, const float *b, size_t count)
+{
+	size_t i = 0;
+	float sum = 0.0f;
+
+#if defined(LOVE_SIMD_SSE)
+	__m128 vsum = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+		vsum = _mm_add_ps(vsum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+	float partial[4];
+	_mm_storeu_ps(partial, vsum);
+	sum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+#elif defined(LOVE_SIMD_NEON)
+	float32x4_t vsum = vdupq_n_f32(0.0f);
+	for (; i + 4 <= count; i += 4)
+		vsum = vmlaq_f32(vsum, vld1q_f32(a + i), vld1q_f32(b + i));
+
+	float32x2_t pair = vadd_f32(vget_low_f32(vsum), vget_high_f32(vsum));
+	sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+
+	for (; i < count; i++)
+		sum += a[i] * b[i];
+
+	return sum;
+}
+
+// Resampler filter parameters.
+const int RESAMPLER_PHASES = 256;
+const int RESAMPLER_HALF_TAPS = 16;
+const int RESAMPLER_MAX_HALF_TAPS = 256;
+const double RESAMPLER_KAISER_BETA = 8.0;
+
+// Output samples per channel resampled by each parallelFor task.
+const int64 RESAMPLER_SEGMENT_SAMPLES = 1 << 16;
+
+/**
+ * Band-limited sample rate converter. Each output sample is a windowed-sinc
+ * interpolation of the input, using a polyphase table of filter coefficients
+ * with linear interpolation between adjacent phases.
+ **/
+class SincResampler
+{
+public:
+
+	SincResampler(int inRate, int outRate)
+		: inRate(inRate)
+		, outRate(outRate)
+		, halfTaps(0)
+		, taps(0)
+	{
+		int64 a = inRate, b = outRate;
+		while (b != 0)
+		{
+			int64 t = a % b;
+			a = b;
+			b = t;
+		}
+
+		this->inRate /= (int) a;
+		this->outRate /= (int) a;
+
+		// When downsampling the cutoff frequency has to drop to the output's
+		// Nyquist frequency, which needs a proportionally longer filter.
+		double cutoff = std::min(1.0, (double) outRate / (double) inRate);
+
+		halfTaps = std::min((int) std::ceil(RESAMPLER_HALF_TAPS / cutoff), RESAMPLER_MAX_HALF_TAPS);
+		taps = halfTaps * 2;
+
+		table.resize((RESAMPLER_PHASES + 1) * taps);
+
+		for (int p = 0; p <= RESAMPLER_PHASES; p++)
+		{
+			double frac = (double) p / (double) RESAMPLER_PHASES;
+			for (int i = 0; i < taps; i++)
+			{
+				double x = frac + (double) (halfTaps - 1 - i);
+				table[p * taps + i] = (float) (cutoff * sinc(cutoff * x) * kaiser(x / halfTaps));
+			}
+		}
+	}
+
+	int64 getOutputLength(int64 inLength) const
+	{
+		return (inLength * outRate + inRate / 2) / inRate;
+	}
+
+	// Computes out[outStart] through out[outEnd - 1]. Each output sample only
+	// depends on the input, so ranges can be processed independently.
+	void process(const float *in, int64 inLength, float *out, int64 outStart, int64 outEnd) const
+	{
+		for (int64 j = outStart; j < outEnd; j++)
+		{
+			// Exact position of this output sample in the input.
+			int64 num = j * inRate;
+			int64 ipos = num / outRate;
+			double phase = (double) (num % outRate) / (double) outRate * RESAMPLER_PHASES;
+
+			int p = std::min((int) phase, RESAMPLER_PHASES - 1);
+			float t = (float) (phase - p);
+
+			const float *row0 = &table[p * taps];
+			const float *row1 = row0 + taps;
+
+			int64 first = ipos - halfTaps + 1;
+
+			float a = 0.0f;
+			float b = 0.0f;
+
+			if (first >= 0 && first + taps <= inLength)
+			{
+				a = dotFloat(row0, in + first, taps);
+				b = dotFloat(row1, in + first, taps);
+			}
+			else
+			{
+				// Samples beyond either end of the input are silent.
+				for (int i = 0; i < taps; i++)
+				{
+					int64 k = first + i;
+					if (k >= 0 && k < inLength)
+					{
+						a += row0[i] * in[k];
+						b += row1[i] * in[k];
+					}
+				}
+			}
+
+			out[j] = a + (b - a) * t;
+		}
+	}
+
+private:
+
+	static double sinc(double x)
+	{
+		if (std::abs(x) < 1e-9)
+			return 1.0;
+		return std::sin(M_PI * x) / (M_PI * x);
+	}
+
+	// Zeroth-order modified Bessel function of the first kind.
+	static double besselI0(double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		for (int k = 1; k < 32; k++)
+		{
+			term *= (x / (2.0 * k)) * (x / (2.0 * k));
+			sum += term;
+			if (term < sum * 1e-12)
+				break;
+		}
+		return sum;
+	}
+
+	// Kaiser window over [-1, 1].
+	static double kaiser(double x)
+	{
+		if (x <= -1.0 || x >= 1.0)
+			return 0.0;
+		return besselI0(RESAMPLER_KAISER_BETA * std::sqrt(1.0 - x * x)) / besselI0(RESAMPLER_KAISER_BETA);
+	}
+
+	int64 inRate;
+	int64 outRate;
+
+	int halfTaps;
+	int taps;
+
+	std::vector<float> table;
+
+}; // SincResampler
+
+} // anonymous namespace
+
+SoundData::SoundData(Decoder *decoder, int threadCount)
+	: data(0)
+	, size(0)
+	, sampleRate(Decoder::DEFAULT_SAMPLE_RATE)
+	, bitDepth(0)
+	, channels(0)
+{
+	if (!isValidBitDepth(decoder->getBitDepth()))
+		throw love::Exception("Invalid bit depth: %d", decoder->getBitDepth());
 
 	channels = decoder->getChannelCount();
 	bitDepth = decoder->getBitDepth();
 	sampleRate = decoder->getSampleRate();
+
+	if (threadCount > 1 && decodeParallel(decoder, threadCount))
+		return;
+
+	decodeSerial(decoder);
 }
 
 SoundData::SoundData(int samples, int sampleRate, int bitDepth, int channels)
@@ -108,6 +449,15 @@ SoundData::SoundData(void *d, int samples, int sampleRate, int bitDepth, int cha
 	load(samples, sampleRate, bitDepth, channels, d);
 }
 
+SoundData::SoundData(int sampleRate, int bitDepth, int channels)
+	: data(0)
+	, size(0)
+	, sampleRate(sampleRate)
+	, bitDepth(bitDepth)
+	, channels(channels)
+{
+}
+
 SoundData::SoundData(const SoundData &c)
 	: data(0)
 	, size(0)
@@ -129,6 +479,176 @@ SoundData *SoundData::clone() const
 	return new SoundData(*this);
 }
 
+void SoundData::decodeSerial(Decoder *decoder)
+{
+	size_t bufferSize = 524288; // 0x80000
+	int decoded = decoder->decode();
+
+	while (decoded > 0)
+	{
+		// Expand or allocate buffer. Note that realloc may move
+		// memory to other locations.
+		if (!data || bufferSize < size + decoded)
+		{
+			while (bufferSize < size + decoded)
+				bufferSize <<= 1;
+			data = (uint8 *) realloc(data, bufferSize);
+		}
+
+		if (!data)
+			throw love::Exception("Not enough memory.");
+
+		// Copy memory into new part of memory.
+		memcpy(data + size, decoder->getBuffer(), decoded);
+
+		// Overflow check.
+		if (size > std::numeric_limits<size_t>::max() - decoded)
+		{
+			free(data);
+			throw love::Exception("Not enough memory.");
+		}
+
+		// Keep this up to date.
+		size += decoded;
+
+		decoded = decoder->decode();
+	}
+
+	// Shrink buffer if necessary.
+	if (data && bufferSize > size)
+		data = (uint8 *) realloc(data, size);
+}
+
+bool SoundData::decodeParallel(Decoder *decoder, int threadCount)
+{
+	// Segments are decoded by independent clones of the decoder, so the
+	// stream's exact length and sample-accurate seeking are both required.
+	if (!decoder->isSeekable())
+		return false;
+
+	int64 totalSamples = decoder->getSampleCount();
+	if (totalSamples <= 0)
+		return false;
+
+	// Splitting short streams isn't worth the thread startup cost.
+	int64 segmentCount = std::min<int64>(threadCount, totalSamples / MIN_PARALLEL_SEGMENT_SAMPLES);
+	if (segmentCount <= 1)
+		return false;
+
+	size_t frameSize = (bitDepth / 8) * channels;
+
+	double realsize = (double) totalSamples * frameSize;
+	if (realsize > std::numeric_limits<size_t>::max())
+		throw love::Exception("Data is too big!");
+
+	size_t totalSize = (size_t) totalSamples * frameSize;
+
+	std::vector<StrongRef<Decoder>> decoders;
+	decoders.reserve(segmentCount);
+
+	// Decoder creation goes through the decoding libraries' setup code, which
+	// isn't guaranteed to be thread-safe.
+	for (int64 i = 0; i < segmentCount; i++)
+		decoders.emplace_back(decoder->clone(), Acquire::NORETAIN);
+
+	data = (uint8 *) malloc(totalSize);
+	if (!data)
+		throw love::Exception("Not enough memory.");
+
+	std::vector<size_t> segmentStart(segmentCount);
+	std::vector<size_t> segmentDecoded(segmentCount, 0);
+
+	// The last segment keeps decoding past the reported length in case the
+	// decoder's sample count was short, rather than truncating the stream.
+	std::vector<uint8> tail;
+
+	try
+	{
+		thread::parallelFor((int) segmentCount, (int) segmentCount, [&](int i)
+		{
+			int64 start = totalSamples * i / segmentCount;
+			int64 end = totalSamples * (i + 1) / segmentCount;
+
+			Decoder *d = decoders[i].get();
+			if (!d->seekSample(start))
+				throw love::Exception("Could not seek to sample %lld.", (long long) start);
+
+			size_t offset = (size_t) start * frameSize;
+			size_t length = (size_t) (end - start) * frameSize;
+			size_t written = 0;
+
+			while (true)
+			{
+				int decoded = d->decode();
+				if (decoded <= 0)
+					break;
+
+				const uint8 *buffer = (const uint8 *) d->getBuffer();
+				size_t count = std::min((size_t) decoded, length - written);
+
+				memcpy(data + offset + written, buffer, count);
+				written += count;
+
+				if (written == length)
+				{
+					if (i == segmentCount - 1)
+						tail.insert(tail.end(), buffer + count, buffer + decoded);
+					else
+						break;
+				}
+			}
+
+			segmentStart[i] = offset;
+			segmentDecoded[i] = written;
+		});
+	}
+	catch (love::Exception &)
+	{
+		// Let the caller fall back to decoding serially.
+		free(data);
+		data = nullptr;
+		return false;
+	}
+	catch (...)
+	{
+		free(data);
+		data = nullptr;
+		throw;
+	}
+
+	// Close any gaps left by segments that ended early.
+	size = 0;
+	for (int64 i = 0; i < segmentCount; i++)
+	{
+		if (segmentStart[i] != size)
+			memmove(data + size, data + segmentStart[i], segmentDecoded[i]);
+		size += segmentDecoded[i];
+	}
+
+	if (size + tail.size() == 0)
+	{
+		free(data);
+		data = nullptr;
+	}
+	else if (size + tail.size() != totalSize)
+	{
+		uint8 *newdata = (uint8 *) realloc(data, size + tail.size());
+		if (!newdata)
+		{
+			free(data);
+			data = nullptr;
+			throw love::Exception("Not enough memory.");
+		}
+
+		data = newdata;
+		if (!tail.empty())
+			memcpy(data + size, tail.data(), tail.size());
+		size += tail.size();
+	}
+
+	return true;
+}
+
 void SoundData::load(int samples, int sampleRate, int bitDepth, int channels, void *newData)
 {
 	if (samples <= 0)
@@ -137,7 +657,7 @@ void SoundData::load(int samples, int sampleRate, int bitDepth, int channels, vo
 	if (sampleRate <= 0)
 		throw love::Exception("Invalid sample rate: %d", sampleRate);
 
-	if (bitDepth != 8 && bitDepth != 16)
+	if (!isValidBitDepth(bitDepth))
 		throw love::Exception("Invalid bit depth: %d", bitDepth);
 
 	if (channels <= 0)
@@ -210,7 +730,12 @@ void SoundData::setSample(int i, float sample)
 	if (i < 0 || (size_t) i >= size/(bitDepth/8))
 		throw love::Exception("Attempt to set out-of-range sample!");
 
-	if (bitDepth == 16)
+	if (bitDepth == 32)
+	{
+		float *s = (float *) data;
+		s[i] = sample;
+	}
+	else if (bitDepth == 16)
 	{
 		// 16-bit sample values are signed.
 		int16 *s = (int16 *) data;
@@ -237,7 +762,12 @@ float SoundData::getSample(int i) const
 	if (i < 0 || (size_t) i >= size/(bitDepth/8))
 		throw love::Exception("Attempt to get out-of-range sample!");
 
-	if (bitDepth == 16)
+	if (bitDepth == 32)
+	{
+		const float *s = (const float *) data;
+		return s[i];
+	}
+	else if (bitDepth == 16)
 	{
 		// 16-bit sample values are signed.
 		int16 *s = (int16 *) data;
@@ -258,5 +788,186 @@ float SoundData::getSample(int i, int channel) const
 	return getSample(i * channels + (channel - 1));
 }
 
+SoundData *SoundData::convert(int newBitDepth, int newChannels, int newSampleRate) const
+{
+	if (!isValidBitDepth(newBitDepth))
+		throw love::Exception("Invalid bit depth: %d", newBitDepth);
+
+	if (newChannels <= 0)
+		throw love::Exception("Invalid channel count: %d", newChannels);
+
+	if (newSampleRate <= 0)
+		throw love::Exception("Invalid sample rate: %d", newSampleRate);
+
+	size_t frames = (size_t) getSampleCount();
+	size_t bytesPerSample = bitDepth / 8;
+
+	// Work on one float buffer per output channel, so the resampler's inner
+	// loop reads contiguous memory.
+	std::vector<std::vector<float>> planes(newChannels, std::vector<float>(frames));
+
+	size_t chunkFrames = std::max<size_t>(1, CHUNK_SAMPLES / channels);
+	std::vector<float> chunk(chunkFrames * channels);
+
+	for (size_t frame = 0; frame < frames; frame += chunkFrames)
+	{
+		size_t count = std::min(chunkFrames, frames - frame);
+		samplesToFloat(data + frame * channels * bytesPerSample, bitDepth, chunk.data(), count * channels);
+
+		for (size_t f = 0; f < count; f++)
+		{
+			const float *in = &chunk[f * channels];
+
+			for (int c = 0; c < newChannels; c++)
+			{
+				float v = 0.0f;
+
+				if (newChannels == channels)
+					v = in[c];
+				else if (newChannels == 1)
+				{
+					for (int k = 0; k < channels; k++)
+						v += in[k];
+					v /= (float) channels;
+				}
+				else if (channels == 1)
+					v = in[0];
+				else if (c < channels)
+					v = in[c];
+
+				planes[c][frame + f] = v;
+			}
+		}
+	}
+
+	size_t newFrames = frames;
+
+	if (newSampleRate != sampleRate)
+	{
+		SincResampler resampler(sampleRate, newSampleRate);
+		newFrames = (size_t) resampler.getOutputLength((int64) frames);
+
+		std::vector<std::vector<float>> resampled(newChannels, std::vector<float>(newFrames));
+
+		// Channels are split into segments as well, so mono data also uses
+		// every core.
+		int64 segments = ((int64) newFrames + RESAMPLER_SEGMENT_SAMPLES - 1) / RESAMPLER_SEGMENT_SAMPLES;
+
+		thread::parallelFor((int) (segments * newChannels), thread::getProcessorCount(), [&](int i)
+		{
+			int c = (int) (i / segments);
+			int64 start = (i % segments) * RESAMPLER_SEGMENT_SAMPLES;
+			int64 end = std::min(start + RESAMPLER_SEGMENT_SAMPLES, (int64) newFrames);
+			resampler.process(planes[c].data(), (int64) frames, resampled[c].data(), start, end);
+		});
+
+		planes.swap(resampled);
+	}
+
+	// Empty input (or resampling a few samples down to none) gives an empty
+	// SoundData, which load() doesn't allow.
+	if (newFrames == 0)
+		return new SoundData(newSampleRate, newBitDepth, newChannels);
+
+	SoundData *converted = new SoundData((int) newFrames, newSampleRate, newBitDepth, newChannels);
+
+	size_t newBytesPerSample = newBitDepth / 8;
+	chunkFrames = std::max<size_t>(1, CHUNK_SAMPLES / newChannels);
+	chunk.resize(chunkFrames * newChannels);
+
+	for (size_t frame = 0; frame < newFrames; frame += chunkFrames)
+	{
+		size_t count = std::min(chunkFrames, newFrames - frame);
+
+		for (size_t f = 0; f < count; f++)
+		{
+			for (int c = 0; c < newChannels; c++)
+				chunk[f * newChannels + c] = planes[c][frame + f];
+		}
+
+		uint8 *out = converted->data + frame * newChannels * newBytesPerSample;
+		floatToSamples(chunk.data(), out, newBitDepth, count * newChannels);
+	}
+
+	return converted;
+}
+
+void SoundData::mix(const SoundData *source, float gain, int start, int sourceStart, int count)
+{
+	if (source->getChannelCount() != channels)
+		throw love::Exception("Cannot mix a SoundData with %d channels into a SoundData with %d channels.", source->getChannelCount(), channels);
+
+	int samples = getSampleCount();
+	int sourceSamples = source->getSampleCount();
+
+	if (count < 0)
+		count = std::min(samples - start, sourceSamples - sourceStart);
+
+	if (start < 0 || sourceStart < 0 || count < 0 || start > samples - count || sourceStart > sourceSamples - count)
+		throw love::Exception("Attempt to mix out-of-range samples!");
+
+	size_t total = (size_t) count * channels;
+	uint8 *dst = data + (size_t) start * channels * (bitDepth / 8);
+	const uint8 *src = source->data + (size_t) sourceStart * channels * (source->bitDepth / 8);
+
+	// Mixing a SoundData into itself could otherwise read samples that were
+	// already modified.
+	std::vector<float> sourceCopy;
+	if (source == this)
+	{
+		sourceCopy.resize(total);
+		samplesToFloat(src, bitDepth, sourceCopy.data(), total);
+	}
+
+	float a[CHUNK_SAMPLES];
+	float b[CHUNK_SAMPLES];
+
+	for (size_t i = 0; i < total; i += CHUNK_SAMPLES)
+	{
+		size_t n = std::min(CHUNK_SAMPLES, total - i);
+
+		const float *in = b;
+		if (!sourceCopy.empty())
+			in = sourceCopy.data() + i;
+		else
+			samplesToFloat(src + i * (source->bitDepth / 8), source->bitDepth, b, n);
+
+		samplesToFloat(dst + i * (bitDepth / 8), bitDepth, a, n);
+		mixFloat(a, in, gain, n);
+		floatToSamples(a, dst + i * (bitDepth / 8), bitDepth, n);
+	}
+}
+
+void SoundData::applyGain(float gain, int start, int count)
+{
+	int samples = getSampleCount();
+
+	if (count < 0)
+		count = samples - start;
+
+	if (start < 0 || count < 0 || start > samples - count)
+		throw love::Exception("Attempt to apply gain to out-of-range samples!");
+
+	size_t total = (size_t) count * channels;
+	uint8 *dst = data + (size_t) start * channels * (bitDepth / 8);
+
+	if (bitDepth == 32)
+	{
+		scaleFloat((float *) dst, gain, total);
+		return;
+	}
+
+	float a[CHUNK_SAMPLES];
+
+	for (size_t i = 0; i < total; i += CHUNK_SAMPLES)
+	{
+		size_t n = std::min(CHUNK_SAMPLES, total - i);
+
+		samplesToFloat(dst + i * (bitDepth / 8), bitDepth, a, n);
+		scaleFloat(a, gain, n);
+		floatToSamples(a, dst + i * (bitDepth / 8), bitDepth, n);
+	}
+}
+
 } // sound
 } // love
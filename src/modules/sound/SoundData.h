@@ -37,7 +37,7 @@ public:
 
 	static love::Type type;
 
-	SoundData(Decoder *decoder);
+	SoundData(Decoder *decoder, int threadCount = 1);
 	SoundData(int samples, int sampleRate, int bitDepth, int channels);
 	SoundData(void *d, int samples, int sampleRate, int bitDepth, int channels);
 	SoundData(const SoundData &c);
@@ -61,10 +61,47 @@ public:
 	float getSample(int i) const;
 	float getSample(int i, int channel) const;
 
+	/**
+	 * Creates a new SoundData with the contents of this one converted to a
+	 * different format. Channels are mixed down to mono by averaging, mono is
+	 * copied to every output channel, and otherwise channels are copied by
+	 * index (with silence in any extra channels). Sample rate conversion uses
+	 * a windowed-sinc resampler. The result can have no samples, e.g. when
+	 * this SoundData has none.
+	 * @param bitDepth Bits per sample of the new SoundData (8, 16, or 32).
+	 * @param channels Number of channels of the new SoundData.
+	 * @param sampleRate Sample rate of the new SoundData.
+	 **/
+	SoundData *convert(int bitDepth, int channels, int sampleRate) const;
+
+	/**
+	 * Adds the samples of another SoundData, multiplied by a gain, to the
+	 * samples in this one. Both must have the same number of channels.
+	 * @param source The SoundData to mix into this one.
+	 * @param gain The amount to scale the source's samples by.
+	 * @param start The first sample (per channel) in this SoundData to mix into.
+	 * @param sourceStart The first sample (per channel) to read from the source.
+	 * @param count Number of samples (per channel) to mix, or -1 to mix as many
+	 *        as both SoundDatas have after their start positions.
+	 **/
+	void mix(const SoundData *source, float gain, int start, int sourceStart, int count);
+
+	/**
+	 * Multiplies a range of samples (per channel) by a gain.
+	 * @param count Number of samples, or -1 for everything after start.
+	 **/
+	void applyGain(float gain, int start, int count);
+
 private:
 
+	// Creates a SoundData with no samples.
+	SoundData(int sampleRate, int bitDepth, int channels);
+
 	void load(int samples, int sampleRate, int bitDepth, int channels, void *newData = 0);
 
+	void decodeSerial(Decoder *decoder);
+	bool decodeParallel(Decoder *decoder, int threadCount);
+
 	uint8 *data;
 	size_t size;
 
@@ -33,6 +33,7 @@ namespace lullaby
 
 FLACDecoder::FLACDecoder(Data *data, int nbufferSize)
 : Decoder(data, nbufferSize)
+, bitDepth(16)
 {
 	flac = drflac_open_memory(data->getData(), data->getSize(), nullptr);
 	if (flac == nullptr)
@@ -66,14 +67,26 @@ bool FLACDecoder::accepts(const std::string &ext)
 
 love::sound::Decoder *FLACDecoder::clone()
 {
-	return new FLACDecoder(data.get(), bufferSize);
+	FLACDecoder *decoder = new FLACDecoder(data.get(), bufferSize);
+	decoder->setBitDepth(bitDepth);
+	return decoder;
 }
 
 int FLACDecoder::decode()
 {
-	// `bufferSize` is in bytes, so divide by 2.
-	drflac_uint64 read = drflac_read_pcm_frames_s16(flac, bufferSize / 2 / flac->channels, (drflac_int16 *) buffer);
-	read *= 2 * flac->channels;
+	drflac_uint64 read = 0;
+
+	// `bufferSize` is in bytes, so divide by the size of a sample.
+	if (bitDepth == 32)
+	{
+		read = drflac_read_pcm_frames_f32(flac, bufferSize / 4 / flac->channels, (float *) buffer);
+		read *= 4 * flac->channels;
+	}
+	else
+	{
+		read = drflac_read_pcm_frames_s16(flac, bufferSize / 2 / flac->channels, (drflac_int16 *) buffer);
+		read *= 2 * flac->channels;
+	}
 
 	if ((int) read < bufferSize)
 		eof = true;
@@ -109,7 +122,16 @@ int FLACDecoder::getChannelCount() const
 
 int FLACDecoder::getBitDepth() const
 {
-	return 16;
+	return bitDepth;
+}
+
+bool FLACDecoder::setBitDepth(int bitDepth)
+{
+	if (bitDepth != 16 && bitDepth != 32)
+		return false;
+
+	this->bitDepth = bitDepth;
+	return true;
 }
 
 int FLACDecoder::getSampleRate() const
@@ -122,6 +144,27 @@ double FLACDecoder::getDuration()
 	return ((double) flac->totalPCMFrameCount) / ((double) flac->sampleRate);
 }
 
+int64 FLACDecoder::getSampleCount()
+{
+	// A total of 0 means the stream info block didn't specify it.
+	if (flac->totalPCMFrameCount == 0)
+		return -1;
+
+	return (int64) flac->totalPCMFrameCount;
+}
+
+bool FLACDecoder::seekSample(int64 sample)
+{
+	if (sample < 0)
+		return false;
+
+	drflac_bool32 result = drflac_seek_to_pcm_frame(flac, (drflac_uint64) sample);
+	if (result)
+		eof = false;
+
+	return result;
+}
+
 } // lullaby
 } // sound
 } // love
@@ -49,11 +49,15 @@ public:
 	bool isSeekable();
 	int getChannelCount() const;
 	int getBitDepth() const;
+	bool setBitDepth(int bitDepth);
 	int getSampleRate() const;
 	double getDuration();
+	int64 getSampleCount();
+	bool seekSample(int64 sample);
 
 private:
 	drflac *flac;
+	int bitDepth;
 }; // Decoder
 
 } // lullaby
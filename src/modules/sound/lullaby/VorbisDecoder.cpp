@@ -130,6 +130,7 @@ static long vorbisTell(void *datasource	/* ptr to the data that the vorbis files
 
 VorbisDecoder::VorbisDecoder(Data *data, int bufferSize)
 	: Decoder(data, bufferSize)
+	, bitDepth(16)
 	, duration(-2.0)
 {
 	// Initialize callbacks
@@ -182,11 +183,16 @@ bool VorbisDecoder::accepts(const std::string &ext)
 
 love::sound::Decoder *VorbisDecoder::clone()
 {
-	return new VorbisDecoder(data.get(), bufferSize);
+	VorbisDecoder *decoder = new VorbisDecoder(data.get(), bufferSize);
+	decoder->setBitDepth(bitDepth);
+	return decoder;
 }
 
 int VorbisDecoder::decode()
 {
+	if (bitDepth == 32)
+		return decodeFloat();
+
 	int size = 0;
 
 	while (size < bufferSize)
@@ -209,6 +215,45 @@ int VorbisDecoder::decode()
 	return size;
 }
 
+int VorbisDecoder::decodeFloat()
+{
+	int channels = vorbisInfo->channels;
+	int frameSize = channels * (int) sizeof(float);
+	int size = 0;
+
+	float *out = (float *) buffer;
+
+	while (size + frameSize <= bufferSize)
+	{
+		float **pcm = nullptr;
+		int frames = (bufferSize - size) / frameSize;
+
+		long result = ov_read_float(&handle, &pcm, frames, nullptr);
+
+		if (result == OV_HOLE)
+			continue;
+		else if (result <= OV_EREAD)
+			return -1;
+		else if (result == 0)
+		{
+			eof = true;
+			break;
+		}
+
+		// libvorbis gives us one array per channel, we want interleaved data.
+		float *dst = out + size / sizeof(float);
+		for (long i = 0; i < result; i++)
+		{
+			for (int c = 0; c < channels; c++)
+				dst[i * channels + c] = pcm[c][i];
+		}
+
+		size += (int) result * frameSize;
+	}
+
+	return size;
+}
+
 bool VorbisDecoder::seek(double s)
 {
 	int result = 0;
@@ -257,7 +302,16 @@ int VorbisDecoder::getChannelCount() const
 
 int VorbisDecoder::getBitDepth() const
 {
-	return 16;
+	return bitDepth;
+}
+
+bool VorbisDecoder::setBitDepth(int bitDepth)
+{
+	if (bitDepth != 16 && bitDepth != 32)
+		return false;
+
+	this->bitDepth = bitDepth;
+	return true;
 }
 
 int VorbisDecoder::getSampleRate() const
@@ -279,6 +333,37 @@ double VorbisDecoder::getDuration()
 	return duration;
 }
 
+int64 VorbisDecoder::getSampleCount()
+{
+	if (!isSeekable())
+		return -1;
+
+	ogg_int64_t total = ov_pcm_total(&handle, -1);
+	return total < 0 ? -1 : (int64) total;
+}
+
+bool VorbisDecoder::seekSample(int64 sample)
+{
+	if (sample < 0)
+		return false;
+
+	int result = 0;
+
+	// See the comment in seek.
+	if (sample == 0)
+		result = ov_raw_seek(&handle, 0);
+	else
+		result = ov_pcm_seek(&handle, (ogg_int64_t) sample);
+
+	if (result == 0)
+	{
+		eof = false;
+		return true;
+	}
+
+	return false;
+}
+
 } // lullaby
 } // sound
 } // love
@@ -62,8 +62,11 @@ public:
 	bool isSeekable();
 	int getChannelCount() const;
 	int getBitDepth() const;
+	bool setBitDepth(int bitDepth);
 	int getSampleRate() const;
 	double getDuration();
+	int64 getSampleCount();
+	bool seekSample(int64 sample);
 
 private:
 	SOggFile oggFile;				// (see struct)
@@ -72,7 +75,10 @@ private:
 	vorbis_info *vorbisInfo;		// Info
 	vorbis_comment *vorbisComment;	// Comments
 	int endian;						// Endianness
+	int bitDepth;					// Output bits per sample
 	double duration;
+
+	int decodeFloat();
 }; // VorbisDecoder
 
 } // lullaby
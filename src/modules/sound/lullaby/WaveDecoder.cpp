@@ -62,6 +62,7 @@ wuff_callback WaveDecoderCallbacks = {read_callback, seek_callback, tell_callbac
 
 WaveDecoder::WaveDecoder(Data *data, int bufferSize)
 	: Decoder(data, bufferSize)
+	, bitDepth(16)
 {
 	dataFile.data = (char *) data->getData();
 	dataFile.size = data->getSize();
@@ -86,6 +87,8 @@ WaveDecoder::WaveDecoder(Data *data, int bufferSize)
 			if (wuff_status < 0)
 				throw love::Exception("Could not set output format");
 		}
+
+		bitDepth = info.bits_per_sample == 8 ? 8 : 16;
 	}
 	catch (love::Exception &)
 	{
@@ -117,7 +120,9 @@ bool WaveDecoder::accepts(const std::string &ext)
 
 love::sound::Decoder *WaveDecoder::clone()
 {
-	return new WaveDecoder(data.get(), bufferSize);
+	WaveDecoder *decoder = new WaveDecoder(data.get(), bufferSize);
+	decoder->setBitDepth(bitDepth);
+	return decoder;
 }
 
 int WaveDecoder::decode()
@@ -181,7 +186,33 @@ int WaveDecoder::getChannelCount() const
 
 int WaveDecoder::getBitDepth() const
 {
-	return info.bits_per_sample == 8 ? 8 : 16;
+	return bitDepth;
+}
+
+bool WaveDecoder::setBitDepth(int bitDepth)
+{
+	wuff_uint16 format = 0;
+
+	switch (bitDepth)
+	{
+	case 8:
+		format = WUFF_FORMAT_PCM_U8;
+		break;
+	case 16:
+		format = WUFF_FORMAT_PCM_S16;
+		break;
+	case 32:
+		format = WUFF_FORMAT_IEEE_FLOAT_32;
+		break;
+	default:
+		return false;
+	}
+
+	if (wuff_format(handle, format) < 0)
+		return false;
+
+	this->bitDepth = bitDepth;
+	return true;
 }
 
 int WaveDecoder::getSampleRate() const
@@ -194,6 +225,27 @@ double WaveDecoder::getDuration()
 	return (double) info.length / (double) info.sample_rate;
 }
 
+int64 WaveDecoder::getSampleCount()
+{
+	return (int64) info.length;
+}
+
+bool WaveDecoder::seekSample(int64 sample)
+{
+	if (sample < 0)
+		return false;
+
+	int wuff_status = wuff_seek(handle, (wuff_uint64) sample);
+
+	if (wuff_status >= 0)
+	{
+		eof = false;
+		return true;
+	}
+
+	return false;
+}
+
 } // lullaby
 } // sound
 } // love
@@ -58,14 +58,18 @@ public:
 	bool isSeekable();
 	int getChannelCount() const;
 	int getBitDepth() const;
+	bool setBitDepth(int bitDepth);
 	int getSampleRate() const;
 	double getDuration();
+	int64 getSampleCount();
+	bool seekSample(int64 sample);
 
 private:
 
 	WaveFile dataFile;
 	wuff_handle *handle;
 	wuff_info info;
+	int bitDepth;
 
 }; // WaveDecoder
 
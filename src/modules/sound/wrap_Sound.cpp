@@ -21,6 +21,7 @@
 #include "wrap_Sound.h"
 
 #include "filesystem/wrap_Filesystem.h"
+#include "thread/threads.h"
 
 // Implementations.
 #include "lullaby/Sound.h"
@@ -36,6 +37,7 @@ int w_newDecoder(lua_State *L)
 {
 	love::filesystem::FileData *data = love::filesystem::luax_getfiledata(L, 1);
 	int bufferSize = (int) luaL_optinteger(L, 2, Decoder::DEFAULT_BUFFER_SIZE);
+	int bitDepth = (int) luaL_optinteger(L, 3, 0);
 
 	Decoder *t = nullptr;
 	luax_catchexcept(L,
@@ -46,6 +48,13 @@ int w_newDecoder(lua_State *L)
 	if (t == nullptr)
 		return luaL_error(L, "Extension \"%s\" not supported.", data->getExtension().c_str());
 
+	// A bit depth of 0 keeps the decoder's default output format.
+	if (bitDepth != 0 && !t->setBitDepth(bitDepth))
+	{
+		t->release();
+		return luaL_error(L, "Decoding to %d bits per sample is not supported for this file.", bitDepth);
+	}
+
 	luax_pushtype(L, t);
 	t->release();
 	return 1;
@@ -67,14 +76,18 @@ int w_newSoundData(lua_State *L)
 	// Must be string or decoder.
 	else
 	{
-		// Convert to Decoder, if necessary.
+		int threadCount = 1;
+
+		// Convert to Decoder, if necessary. We know a Decoder we create is
+		// still at the start of its stream, so it can be decoded in parallel.
 		if (!luax_istype(L, 1, Decoder::type))
 		{
 			w_newDecoder(L);
 			lua_replace(L, 1);
+			threadCount = love::thread::getProcessorCount();
 		}
 
-		luax_catchexcept(L, [&](){ t = instance()->newSoundData(luax_checkdecoder(L, 1)); });
+		luax_catchexcept(L, [&](){ t = instance()->newSoundData(luax_checkdecoder(L, 1), threadCount); });
 	}
 
 	luax_pushtype(L, t);
@@ -121,6 +121,45 @@ int w_SoundData_getSample(lua_State *L)
 	return 1;
 }
 
+int w_SoundData_convert(lua_State *L)
+{
+	SoundData *t = luax_checksounddata(L, 1);
+	int bitDepth = (int) luaL_optinteger(L, 2, t->getBitDepth());
+	int channels = (int) luaL_optinteger(L, 3, t->getChannelCount());
+	int sampleRate = (int) luaL_optinteger(L, 4, t->getSampleRate());
+
+	SoundData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->convert(bitDepth, channels, sampleRate); });
+
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_SoundData_mix(lua_State *L)
+{
+	SoundData *t = luax_checksounddata(L, 1);
+	SoundData *source = luax_checksounddata(L, 2);
+	float gain = (float) luaL_optnumber(L, 3, 1.0);
+	int start = (int) luaL_optinteger(L, 4, 0);
+	int sourceStart = (int) luaL_optinteger(L, 5, 0);
+	int count = (int) luaL_optinteger(L, 6, -1);
+
+	luax_catchexcept(L, [&](){ t->mix(source, gain, start, sourceStart, count); });
+	return 0;
+}
+
+int w_SoundData_applyGain(lua_State *L)
+{
+	SoundData *t = luax_checksounddata(L, 1);
+	float gain = (float) luaL_checknumber(L, 2);
+	int start = (int) luaL_optinteger(L, 3, 0);
+	int count = (int) luaL_optinteger(L, 4, -1);
+
+	luax_catchexcept(L, [&](){ t->applyGain(gain, start, count); });
+	return 0;
+}
+
 int w_SoundData_getChannels(lua_State *L)
 {
 	luax_markdeprecated(L, "SoundData:getChannels", API_METHOD, DEPRECATED_RENAMED, "SoundData:getChannelCount");
@@ -137,6 +176,9 @@ static const luaL_Reg w_SoundData_functions[] =
 	{ "getDuration", w_SoundData_getDuration },
 	{ "setSample", w_SoundData_setSample },
 	{ "getSample", w_SoundData_getSample },
+	{ "convert", w_SoundData_convert },
+	{ "mix", w_SoundData_mix },
+	{ "applyGain", w_SoundData_applyGain },
 
 	// Deprecated
 	{ "getChannels", w_SoundData_getChannels },
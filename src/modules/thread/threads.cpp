@@ -20,6 +20,11 @@
 
 #include "threads.h"
 
+// C++
+#include <atomic>
+#include <exception>
+#include <vector>
+
 #if defined(LOVE_LINUX)
 #include <signal.h>
 #endif
@@ -157,6 +162,250 @@ Conditional *ConditionalRef::operator->() const
 	return conditional;
 }
 
+namespace
+{
+
+struct ParallelForState
+{
+	const std::function<void(int)> *func;
+	int count;
+	std::atomic<int> next;
+
+	MutexRef mutex;
+	std::exception_ptr error;
+
+	void run()
+	{
+		while (true)
+		{
+			int i = next.fetch_add(1);
+			if (i >= count)
+				break;
+
+			try
+			{
+				(*func)(i);
+			}
+			catch (...)
+			{
+				Lock lock(mutex);
+				if (!error)
+					error = std::current_exception();
+
+				// Skip any remaining work.
+				next.store(count);
+			}
+		}
+	}
+};
+
+class ParallelForWorker : public Threadable
+{
+public:
+
+	ParallelForWorker(ParallelForState *state)
+		: state(state)
+	{
+		threadName = "ParallelFor";
+	}
+
+	void threadFunction()
+	{
+		state->run();
+	}
+
+private:
+
+	ParallelForState *state;
+};
+
+} // anonymous namespace
+
+void parallelFor(int count, int threadCount, const std::function<void(int)> &func)
+{
+	if (count <= 0)
+		return;
+
+	if (threadCount > count)
+		threadCount = count;
+
+	if (threadCount <= 1)
+	{
+		for (int i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+
+	ParallelForState state;
+	state.func = &func;
+	state.count = count;
+	state.next = 0;
+
+	std::vector<ParallelForWorker *> workers;
+	workers.reserve(threadCount - 1);
+
+	for (int i = 0; i < threadCount - 1; i++)
+	{
+		ParallelForWorker *worker = new ParallelForWorker(&state);
+		if (worker->start())
+			workers.push_back(worker);
+		else
+			worker->release();
+	}
+
+	// The calling thread does its share of the work too. If no worker thread
+	// could be started this still processes every index.
+	state.run();
+
+	for (ParallelForWorker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+
+	if (state.error)
+		std::rethrow_exception(state.error);
+}
+
+WorkerPool::Worker::Worker(WorkerPool *pool, int index)
+	: pool(pool)
+	, index(index)
+{
+	threadName = "WorkerPool";
+}
+
+void WorkerPool::Worker::threadFunction()
+{
+	pool->workerLoop(index);
+}
+
+WorkerPool::WorkerPool(int threadCount)
+	: func(nullptr)
+	, count(0)
+	, next(0)
+	, busyWorkers(0)
+	, generation(0)
+	, quit(false)
+{
+	for (int i = 1; i < threadCount; i++)
+	{
+		Worker *worker = new Worker(this, (int) workers.size() + 1);
+		if (worker->start())
+			workers.push_back(worker);
+		else
+			worker->release();
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		Lock lock(mutex);
+		quit = true;
+		workAvailable->broadcast();
+	}
+
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+int WorkerPool::getThreadCount() const
+{
+	return (int) workers.size() + 1;
+}
+
+void WorkerPool::run(int count, const std::function<void(int, int)> &func)
+{
+	if (count <= 0)
+		return;
+
+	if (workers.empty() || count == 1)
+	{
+		for (int i = 0; i < count; i++)
+			func(i, 0);
+		return;
+	}
+
+	{
+		Lock lock(mutex);
+		this->func = &func;
+		this->count = count;
+		next = 0;
+		busyWorkers = (int) workers.size();
+		generation++;
+		workAvailable->broadcast();
+	}
+
+	// The calling thread is worker 0.
+	process(0);
+
+	std::exception_ptr e;
+
+	{
+		Lock lock(mutex);
+		while (busyWorkers > 0)
+			workDone->wait(mutex);
+
+		this->func = nullptr;
+		std::swap(e, error);
+	}
+
+	if (e)
+		std::rethrow_exception(e);
+}
+
+void WorkerPool::workerLoop(int index)
+{
+	unsigned int seen = 0;
+
+	while (true)
+	{
+		{
+			Lock lock(mutex);
+			while (!quit && generation == seen)
+				workAvailable->wait(mutex);
+
+			if (quit)
+				return;
+
+			seen = generation;
+		}
+
+		process(index);
+
+		Lock lock(mutex);
+		if (--busyWorkers == 0)
+			workDone->signal();
+	}
+}
+
+void WorkerPool::process(int worker)
+{
+	while (true)
+	{
+		int i = next.fetch_add(1);
+		if (i >= count)
+			break;
+
+		try
+		{
+			(*func)(i, worker);
+		}
+		catch (...)
+		{
+			Lock lock(mutex);
+			if (!error)
+				error = std::current_exception();
+
+			// Skip any remaining work.
+			next.store(count);
+		}
+	}
+}
+
 #if defined(LOVE_LINUX)
 static sigset_t oldset;
 
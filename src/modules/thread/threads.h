@@ -27,6 +27,10 @@
 
 // C++
 #include <string>
+#include <functional>
+#include <atomic>
+#include <vector>
+#include <exception>
 
 namespace love
 {
@@ -129,6 +133,81 @@ Mutex *newMutex();
 Conditional *newConditional();
 Thread *newThread(Threadable *t);
 
+/**
+ * Gets the number of logical CPU cores, for sizing worker thread counts.
+ **/
+int getProcessorCount();
+
+/**
+ * Calls func(i) for every i in [0, count), spread across at most threadCount
+ * threads (the calling thread included). Blocks until every call has returned.
+ * If a call throws, the first exception is rethrown here after all threads
+ * have finished.
+ **/
+void parallelFor(int count, int threadCount, const std::function<void(int)> &func);
+
+/**
+ * A fixed set of worker threads for running many short parallelFor-style
+ * batches without starting new threads for each one. A batch may only be run
+ * from one thread at a time.
+ **/
+class WorkerPool
+{
+public:
+
+	/**
+	 * @param threadCount The number of threads taking part in each batch,
+	 * including the thread which runs it.
+	 **/
+	WorkerPool(int threadCount);
+	~WorkerPool();
+
+	/**
+	 * Gets the number of threads taking part in each batch, including the
+	 * calling thread. This can be lower than requested if threads could not
+	 * be started.
+	 **/
+	int getThreadCount() const;
+
+	/**
+	 * Calls func(i, worker) for every i in [0, count) and blocks until every
+	 * call has returned. worker is in [0, getThreadCount()) and identifies the
+	 * thread making the call. If a call throws, the first exception is
+	 * rethrown here once the batch is finished.
+	 **/
+	void run(int count, const std::function<void(int, int)> &func);
+
+private:
+
+	class Worker : public Threadable
+	{
+	public:
+		Worker(WorkerPool *pool, int index);
+		void threadFunction() override;
+	private:
+		WorkerPool *pool;
+		int index;
+	};
+
+	void workerLoop(int index);
+	void process(int worker);
+
+	std::vector<Worker *> workers;
+
+	MutexRef mutex;
+	ConditionalRef workAvailable;
+	ConditionalRef workDone;
+
+	const std::function<void(int, int)> *func;
+	int count;
+	std::atomic<int> next;
+	int busyWorkers;
+	unsigned int generation;
+	bool quit;
+	std::exception_ptr error;
+
+}; // WorkerPool
+
 #if defined(LOVE_LINUX)
 void disableSignals();
 void reenableSignals();
@@ -0,0 +1,7 @@
+function love.conf(t)
+	t.identity = "love-tests"
+	t.window = false
+	t.modules.audio = false
+	t.modules.graphics = false
+	t.modules.window = false
+end
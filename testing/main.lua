@@ -0,0 +1,28 @@
+-- Runs the test files in tests/ and exits with a non-zero status if any fail.
+-- Usage: love testing [module ...]
+
+local modules = {"data", "physics"}
+
+function love.load(args)
+	if args and #args > 0 then
+		modules = args
+	end
+
+	local passed, failed = 0, 0
+
+	for _, name in ipairs(modules) do
+		local tests = require("tests." .. name)
+		for _, test in ipairs(tests) do
+			local ok, err = pcall(test.run)
+			if ok then
+				passed = passed + 1
+			else
+				failed = failed + 1
+				print(string.format("FAIL %s: %s: %s", name, test.name, tostring(err)))
+			end
+		end
+	end
+
+	print(string.format("%d passed, %d failed", passed, failed))
+	love.event.quit(failed == 0 and 0 or 1)
+end
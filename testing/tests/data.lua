@@ -0,0 +1,70 @@
+local tests = {}
+
+local function test(name, run)
+	table.insert(tests, {name = name, run = run})
+end
+
+local function expecterror(f, ...)
+	local ok = pcall(f, ...)
+	assert(not ok, "expected an error")
+end
+
+-- Replaces the bytes of s starting at the 1-based index i.
+local function patch(s, i, bytes)
+	return s:sub(1, i - 1) .. bytes .. s:sub(i + #bytes)
+end
+
+local raw = string.rep("love.data block container ", 400)
+
+local function container()
+	return love.data.compress("string", "lz4", raw, nil, {parallel = true, blocksize = 1024})
+end
+
+test("block container round trip", function()
+	local c = container()
+	assert(love.data.decompress("string", "lz4", c) == raw)
+	assert(love.data.decompress("string", "lz4", c, 3000, 2000) == raw:sub(3001, 5000))
+end)
+
+test("block container rejects a raw size which wraps the block count", function()
+	-- rawSize = 2^64-1 and blockCount = 0.
+	local c = patch(container(), 17, string.rep("\255", 8) .. "\0\0\0\0")
+	expecterror(love.data.decompress, "string", "lz4", c, 0, 16)
+	expecterror(love.data.decompress, "string", "lz4", c)
+end)
+
+test("block container rejects a raw size larger than its blocks", function()
+	local c = patch(container(), 17, love.data.pack("string", "<I8", #raw + 100000))
+	expecterror(love.data.decompress, "string", "lz4", c, 0, 16)
+end)
+
+test("block container rejects blocks outside of the data", function()
+	local c = patch(container(), 29, "\240\255\255\255")
+	expecterror(love.data.decompress, "string", "lz4", c, 0, 16)
+
+	c = container()
+	expecterror(love.data.decompress, "string", "lz4", c:sub(1, #c - 10), 0, 16)
+end)
+
+test("decompressor output limit can be resumed", function()
+	for _, format in ipairs({"zlib", "gzip", "lz4frame"}) do
+		local c = love.data.newCompressor(format)
+		local compressed = c:update(raw) .. c:finish()
+
+		local d = love.data.newDecompressor(format)
+		local out, more = d:update(compressed, 1000)
+		assert(#out <= 1000)
+
+		local parts = {out}
+		while more do
+			out, more = d:update(nil, 1000)
+			assert(#out <= 1000)
+			table.insert(parts, out)
+		end
+
+		d:finish()
+		assert(table.concat(parts) == raw)
+	end
+end)
+
+return tests
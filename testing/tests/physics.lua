@@ -0,0 +1,98 @@
+local tests = {}
+
+local function test(name, run)
+	table.insert(tests, {name = name, run = run})
+end
+
+local function newworld()
+	local world = love.physics.newWorld(0, 9.81 * 64)
+	local ground = love.physics.newBody(world, 0, 400)
+	love.physics.newFixture(ground, love.physics.newRectangleShape(800, 20))
+	local ball = love.physics.newBody(world, 100, 0, "dynamic")
+	love.physics.newFixture(ball, love.physics.newCircleShape(10))
+	return world, ball
+end
+
+test("world state can be restored from a larger Data", function()
+	local world, ball = newworld()
+	world:update(1/60)
+
+	local size = world:getSerializedSize()
+	local data = love.data.newByteData(size + 1000)
+	world:serialize(data)
+	local x, y = ball:getPosition()
+
+	for i = 1, 30 do
+		world:update(1/60)
+	end
+
+	world:deserialize(data)
+	local x2, y2 = ball:getPosition()
+	assert(x == x2 and y == y2)
+end)
+
+test("world state rejects truncated Data", function()
+	local world = newworld()
+	local data = world:serialize()
+	local truncated = love.data.newByteData(data:getString():sub(1, data:getSize() - 1))
+	assert(not pcall(world.deserialize, world, truncated))
+end)
+
+test("end contacts from destroyed bodies are buffered", function()
+	local world, ball = newworld()
+	world:setContactBuffering(true, true, false)
+
+	local touching = false
+	for i = 1, 180 do
+		world:update(1/60)
+		local events, count = world:getContactEvents()
+		if count > 0 and events[1] == "begin" then
+			touching = true
+			break
+		end
+	end
+	assert(touching, "the ball never reached the ground")
+
+	ball:destroy()
+	world:update(1/60)
+
+	local events, count = world:getContactEvents()
+	assert(count == 1 and events[1] == "end")
+
+	events, count = world:getContactEvents()
+	assert(count == 0)
+end)
+
+test("body state lists reject Bodies from other Worlds", function()
+	local world, ball = newworld()
+	local other, otherball = newworld()
+	local data = love.data.newByteData(4 * 6 * 2)
+
+	assert(world:getBodyStates(data, {ball}) == 1)
+	assert(not pcall(world.getBodyStates, world, data, {ball, otherball}))
+	assert(not pcall(world.setBodyStates, world, data, {otherball}))
+end)
+
+test("turning contact buffering off clears buffered events", function()
+	local world = newworld()
+	world:setContactBuffering(true, true, true)
+
+	for i = 1, 180 do
+		world:update(1/60)
+	end
+
+	world:setContactBuffering(false, false, false)
+	local events, count = world:getContactEvents()
+	assert(count == 0)
+end)
+
+test("an empty body list reads and writes no Bodies", function()
+	local world = newworld()
+	local data = love.data.newByteData(4 * 6 * 2)
+
+	assert(world:getBodyStates(data) == 2)
+	assert(world:getBodyStates(data, {}) == 0)
+	assert(world:setBodyStates(data, {}) == 0)
+end)
+
+return tests